@@ -48,12 +48,18 @@ Color Index
 #define EPD_4IN0E_BLUE    0x5   /// 101
 #define EPD_4IN0E_GREEN   0x6   /// 110
 
+void EPD_4IN0E_SetBusyLightSleep(bool enable);
+unsigned long EPD_4IN0E_FirstFrameByteMs(void);
+uint32_t EPD_4IN0E_RefreshMs(void);
 void EPD_4IN0E_Init(void);
 void EPD_4IN0E_Clear(UBYTE color);
 void EPD_4IN0E_Show7Block(void);
 void EPD_4IN0E_Show(void);
 void EPD_4IN0E_Display(const UBYTE *Image);
 bool EPD_4IN0E_DisplayFromFile(File &file, size_t imageSize);
+void EPD_4IN0E_BeginFrame(void);
+void EPD_4IN0E_WriteFrame(const UBYTE *Data, UDOUBLE Length);
+void EPD_4IN0E_EndFrame(void);
 void EPD_4IN0E_DisplayPart(const UBYTE *Image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh);
 void EPD_4IN0E_Sleep(void);
 
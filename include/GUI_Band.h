@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * | File      	:   GUI_Band.h
+ * | Function    :   Display list replayed per band of rows (no framebuffer)
+ ******************************************************************************/
+#ifndef __GUI_BAND_H
+#define __GUI_BAND_H
+
+#include "GUI_Paint.h"
+
+#ifndef BAND_MAX_OPS
+#define BAND_MAX_OPS 32         // Drawing calls per display list
+#endif
+#ifndef BAND_TEXT_POOL
+#define BAND_TEXT_POOL 256      // Bytes for the strings of Band_DrawString_EN
+#endif
+
+/**
+ * Fills a band with the background (e.g. the rows of a photo read from
+ * flash). Returns false on a read error.
+**/
+typedef bool (*BAND_SOURCE)(UBYTE *Band, UDOUBLE Length, void *Context);
+
+/**
+ * Takes a finished band, top band first (e.g. EPD_4IN0E_WriteFrame)
+**/
+typedef void (*BAND_SINK)(const UBYTE *Band, UDOUBLE Length);
+
+/**
+ * Banded rendering: the Band_Draw* calls mirror the Paint_Draw* calls but
+ * only record them. Band_Render() then replays the list into a buffer of a
+ * few rows at a time, skipping calls that do not touch the band, and hands
+ * each band to a sink. Drawing over a photo needs one band of RAM instead
+ * of the whole 120 KB image.
+ *
+ * Rotation, mirroring and scale are taken from Paint: call Band_NewImage(),
+ * then Paint_SetScale() / Paint_SetMirroring(), then record. Pixels are
+ * only drawn where a call draws them, so text with FONT_BACKGROUND as its
+ * background is transparent over the photo.
+**/
+void Band_NewImage(UWORD Width, UWORD Height, UWORD Rotate, UWORD Color);
+void Band_Reset(void);
+UWORD Band_Count(void);
+
+void Band_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
+void Band_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style);
+void Band_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
+void Band_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Band_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Band_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Band_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Band_DrawBitMap_Paste(const unsigned char* image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor);
+
+bool Band_Render(UBYTE *Buffer, UWORD Rows, BAND_SOURCE Source, void *Context, BAND_SINK Sink);
+
+// BAND_SOURCE reading the image from a File (Context is the File *)
+bool Band_FillFromFile(UBYTE *Band, UDOUBLE Length, void *Context);
+
+#endif
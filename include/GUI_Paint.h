@@ -97,6 +97,8 @@ typedef struct {
     UWORD WidthByte;
     UWORD HeightByte;
     UWORD Scale;
+    UWORD BandStart;    // First memory row held by Image (banded rendering)
+    UWORD BandRows;     // Memory rows held by Image
 } PAINT;
 extern PAINT Paint;
 
@@ -198,6 +200,7 @@ void Paint_SetRotate(UWORD Rotate);
 void Paint_SetMirroring(UBYTE mirror);
 void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color);
 void Paint_SetScale(UBYTE scale);
+void Paint_SetBand(UWORD Start, UWORD Rows);
 
 void Paint_Clear(UWORD Color);
 void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
@@ -0,0 +1,145 @@
+/*****************************************************************************
+ * | File      	:   GUI_Painter.h
+ * | Function    :   Pixel addressing specialized per rotation, mirror and depth
+ ******************************************************************************/
+#ifndef __GUI_PAINTER_H
+#define __GUI_PAINTER_H
+
+#include "GUI_Paint.h"
+
+/**
+ * Paint_SetPixel() with Rotate, Mirror and bits per pixel fixed at compile
+ * time: the address calculation and bit packing of each instance are
+ * straight-line code. The image itself (buffer, size, band) still comes
+ * from Paint.
+ *
+ * Drawing loops are written once as a template over the painter and run
+ * through Paint_Dispatch(), which picks the instance matching Paint once
+ * per call instead of once per pixel:
+ *
+ *     Paint_Dispatch([&](auto P) { for (...) P.SetPixel(x, y, Color); });
+**/
+template <UWORD Rotate, UBYTE Mirror, UBYTE Bpp>
+struct Painter {
+    static_assert(Rotate == ROTATE_0 || Rotate == ROTATE_90 ||
+                  Rotate == ROTATE_180 || Rotate == ROTATE_270, "rotation");
+    static_assert(Mirror <= MIRROR_ORIGIN, "mirror");
+    static_assert(Bpp == 1 || Bpp == 2 || Bpp == 4, "bits per pixel");
+
+    static constexpr UBYTE Depth = Bpp;
+    static constexpr UBYTE PerByte = 8 / Bpp;
+    // Drawing rows run along memory columns
+    static constexpr bool Transposed = (Rotate == ROTATE_90 || Rotate == ROTATE_270);
+
+    // Memory column and row (from the top of the image) of a point
+    static inline void Map(UWORD Xpoint, UWORD Ypoint, UWORD &X, UWORD &Y)
+    {
+        if (Rotate == ROTATE_0) {
+            X = Xpoint;
+            Y = Ypoint;
+        } else if (Rotate == ROTATE_90) {
+            X = Paint.WidthMemory - Ypoint - 1;
+            Y = Xpoint;
+        } else if (Rotate == ROTATE_180) {
+            X = Paint.WidthMemory - Xpoint - 1;
+            Y = Paint.HeightMemory - Ypoint - 1;
+        } else {
+            X = Ypoint;
+            Y = Paint.HeightMemory - Xpoint - 1;
+        }
+
+        if (Mirror & MIRROR_HORIZONTAL)
+            X = Paint.WidthMemory - X - 1;
+        if (Mirror & MIRROR_VERTICAL)
+            Y = Paint.HeightMemory - Y - 1;
+    }
+
+    // Write one pixel at a memory column and a row of the band
+    static inline void Put(UWORD X, UWORD Row, UWORD Color)
+    {
+        UBYTE *Byte = &Paint.Image[X / PerByte + (UDOUBLE)Row * Paint.WidthByte];
+        if (Bpp == 1) {
+            if (Color == BLACK)
+                *Byte &= ~(0x80 >> (X % 8));
+            else
+                *Byte |= 0x80 >> (X % 8);
+        } else if (Bpp == 2) {
+            *Byte = (*Byte & ~(0xC0 >> ((X % 4) * 2))) | (((Color % 4) << 6) >> ((X % 4) * 2));
+        } else {
+            *Byte = (*Byte & ~(0xF0 >> ((X % 2) * 4))) | ((Color << 4) >> ((X % 2) * 4));
+        }
+    }
+
+    // Same checks and result as Paint_SetPixel()
+    static inline void SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+    {
+        if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+            Debug("Exceeding display boundaries\r\n");
+            return;
+        }
+        UWORD X, Y;
+        Map(Xpoint, Ypoint, X, Y);
+        if (X > Paint.WidthMemory || Y > Paint.HeightMemory) {
+            Debug("Exceeding display boundaries\r\n");
+            return;
+        }
+        //Outside the band being rendered
+        if (Y < Paint.BandStart || Y >= Paint.BandStart + Paint.BandRows)
+            return;
+        Put(X, Y - Paint.BandStart, Color);
+    }
+};
+
+template <UWORD Rotate, UBYTE Mirror, class Fn>
+static inline bool Paint_DispatchBpp(Fn &Draw)
+{
+    switch (Paint.Scale) {
+    case 2:
+        Draw(Painter<Rotate, Mirror, 1>());
+        return true;
+    case 4:
+        Draw(Painter<Rotate, Mirror, 2>());
+        return true;
+    case 6:
+    case 7:
+    case 16:
+        Draw(Painter<Rotate, Mirror, 4>());
+        return true;
+    default:
+        return false;
+    }
+}
+
+// A vertical mirror is a half turn plus a horizontal mirror, so the 16
+// rotation/mirror pairs map pixels in only 8 ways; each is compiled once
+template <UWORD Rotate, class Fn>
+static inline bool Paint_DispatchMirror(Fn &Draw)
+{
+    constexpr UWORD HalfTurn = (Rotate + ROTATE_180) % 360;
+    switch (Paint.Mirror) {
+    case MIRROR_NONE:       return Paint_DispatchBpp<Rotate, MIRROR_NONE>(Draw);
+    case MIRROR_HORIZONTAL: return Paint_DispatchBpp<Rotate, MIRROR_HORIZONTAL>(Draw);
+    case MIRROR_VERTICAL:   return Paint_DispatchBpp<HalfTurn, MIRROR_HORIZONTAL>(Draw);
+    case MIRROR_ORIGIN:     return Paint_DispatchBpp<HalfTurn, MIRROR_NONE>(Draw);
+    default:                return false;
+    }
+}
+
+/**
+ * Call Draw with the Painter matching Paint.Rotate, Paint.Mirror and
+ * Paint.Scale. Returns false, without calling it, when Paint holds a
+ * rotation, mirror or scale that Paint_SetPixel() would not draw with.
+**/
+template <class Fn>
+static inline bool Paint_Dispatch(Fn &&Draw)
+{
+    switch (Paint.Rotate) {
+    case ROTATE_0:   return Paint_DispatchMirror<ROTATE_0>(Draw);
+    case ROTATE_90:  return Paint_DispatchMirror<ROTATE_90>(Draw);
+    case ROTATE_180: return Paint_DispatchMirror<ROTATE_180>(Draw);
+    case ROTATE_270: return Paint_DispatchMirror<ROTATE_270>(Draw);
+    default:         return false;
+    }
+}
+
+#endif
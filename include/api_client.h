@@ -7,39 +7,74 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include "slideshow_types.h"
+#include "bump_arena.h"
+
+class HTTPClient;
 
 struct SlideshowVersionResponse {
   int slideshowVersion;
-  String status;  // "NEW" or "NO_CHANGE"
+  char status[16];  // "NEW" or "NO_CHANGE"
+  // Scheduling hints, 0 / false if the server sent none
+  uint32_t nextCheckSeconds;   // When to check again
+  uint32_t checkSpreadSeconds; // Window the fleet's checks are spread over
+  int64_t serverTime;          // Unix time in seconds
+  int32_t utcOffsetSeconds;    // Owner's local time offset, for quiet hours
+  bool hasUtcOffset;
+  bool outboxAccepted;  // Server took the ACK/event parameters sent with the check
   bool success;
 };
 
-struct SlideshowManifestResponse {
+template <int Capacity>
+struct SlideshowManifestT : ImageTable<Capacity> {
   int slideshowVersion;
-  String imageIds[12];
-  String imageHashes[12];
-  int imageCount;
+  int imageCount;   // Entries filled so far (across pages)
+  int totalCount;   // Images in the slideshow according to the server
+  uint16_t dwellMinutes[Capacity];  // How long each image stays up (0 = default)
+  ImageLayout layouts[Capacity];     // Stored size and view of each entry
+  int viewCount;                     // Composed views, across pages
+  ImageView views[COMPOSE_MAX_VIEWS];
   bool success;
 };
+typedef SlideshowManifestT<MAX_IMAGES> SlideshowManifestResponse;
 
-struct SignedUrlsResponse {
-  String urls[12];  // Array of signed URLs in same order as imageIds
+template <int Capacity>
+struct SignedUrlsT {
+  static const int capacity = Capacity;
+  const char* urls[Capacity];  // Signed URLs in same order as imageIds, stored in the caller's arena
   int count;
   bool success;
 };
+typedef SignedUrlsT<SIGNED_URL_BATCH_SIZE> SignedUrlsResponse;
 
 class APIClient {
 public:
-  static bool getSlideshowVersion(const String& deviceId, const String& deviceKey, SlideshowVersionResponse& response);
-  static bool getSlideshowManifest(const String& deviceId, const String& deviceKey, SlideshowManifestResponse& response);
-  static bool getSignedUrls(const String& deviceId, const String& deviceKey, const String* imageIds, int count, SignedUrlsResponse& response);
-  static bool ackDisplayed(const String& deviceId, const String& deviceKey, int slideshowVersion);
-  static bool downloadImage(const String& signedUrl, uint8_t* buffer, size_t bufferSize, size_t& bytesDownloaded);
-  static String parseUrl(const String& url, String& host, String& path);
+  // extraQuery ("&name=value...") is appended to the request, e.g. outbox entries
+  static bool getSlideshowVersion(const char* deviceId, const char* deviceKey, SlideshowVersionResponse& response,
+                                  const char* extraQuery = "");
+  // Fetch one page of the manifest into response entries [offset, offset + limit)
+  static bool getSlideshowManifest(const char* deviceId, const char* deviceKey, int offset, int limit,
+                                   SlideshowManifestResponse& response);
+  // URLs are copied into urlArena and stay valid until the arena is reset
+  static bool getSignedUrls(const char* deviceId, const char* deviceKey, const ImageId* imageIds, int count,
+                            BumpArena& urlArena, SignedUrlsResponse& response);
+  static bool ackDisplayed(const char* deviceId, const char* deviceKey, int slideshowVersion);
+  static bool downloadImage(const char* signedUrl, uint8_t* buffer, size_t bufferSize, size_t& bytesDownloaded);
+  // Split "https://host/path" into host (copied) and path (points into url)
+  static bool parseUrl(const char* url, char* host, size_t hostSize, const char*& path);
+
+  // Status of the last request: HTTP code, or a negative HTTPClient error
+  // (connection refused, read timeout...) if no response arrived
+  static int getLastHttpCode();
+  // Retry-After of the last response in seconds, 0 if none
+  static uint32_t getLastRetryAfter();
   
 private:
-  static String calculateSHA256(const uint8_t* data, size_t length);
+  static void beginRequest(HTTPClient& http);
+  static void endRequest(HTTPClient& http, int httpCode);
+  static void calculateSHA256(const uint8_t* data, size_t length, uint8_t hash[IMAGE_HASH_BYTES]);
+  static int lastHttpCode;
+  static uint32_t lastRetryAfter;
 };
 
 #endif
-
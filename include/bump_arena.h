@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * | File      	:   bump_arena.h
+ * | Function    :   Bump allocator over a caller-provided static buffer
+ ******************************************************************************/
+#ifndef _BUMP_ARENA_H_
+#define _BUMP_ARENA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Allocations are carved sequentially out of a fixed buffer and only freed
+// all at once with reset(), so memory use is deterministic and cannot
+// fragment. Each block carries a small size header so the most recent
+// block can be grown in place (used by the JSON parser).
+class BumpArena {
+public:
+  BumpArena(uint8_t* buffer, size_t capacity)
+    : buffer(buffer), capacity(capacity), used(0), highWater(0), last(nullptr) {}
+
+  void* allocate(size_t size) {
+    size_t blockSize = align(sizeof(uint32_t) + size);
+    if (blockSize > capacity - used) {
+      return nullptr;
+    }
+    uint8_t* block = buffer + used;
+    *(uint32_t*)block = (uint32_t)size;
+    used += blockSize;
+    if (used > highWater) highWater = used;
+    last = block;
+    return block + sizeof(uint32_t);
+  }
+
+  void* reallocate(void* ptr, size_t size) {
+    if (!ptr) return allocate(size);
+    uint8_t* block = (uint8_t*)ptr - sizeof(uint32_t);
+    size_t oldSize = *(uint32_t*)block;
+
+    // Most recent block - grow or shrink in place
+    if (block == last) {
+      size_t blockStart = block - buffer;
+      size_t blockSize = align(sizeof(uint32_t) + size);
+      if (blockSize > capacity - blockStart) {
+        return nullptr;
+      }
+      *(uint32_t*)block = (uint32_t)size;
+      used = blockStart + blockSize;
+      if (used > highWater) highWater = used;
+      return ptr;
+    }
+
+    if (size <= oldSize) {
+      *(uint32_t*)block = (uint32_t)size;
+      return ptr;
+    }
+    void* moved = allocate(size);
+    if (moved) {
+      memcpy(moved, ptr, oldSize);
+    }
+    return moved;
+  }
+
+  char* copyString(const char* str, size_t len) {
+    char* copy = (char*)allocate(len + 1);
+    if (copy) {
+      memcpy(copy, str, len);
+      copy[len] = '\0';
+    }
+    return copy;
+  }
+
+  void reset() {
+    used = 0;
+    last = nullptr;
+  }
+
+  size_t getUsed() const { return used; }
+  size_t getHighWater() const { return highWater; }
+  size_t getCapacity() const { return capacity; }
+
+private:
+  static size_t align(size_t size) { return (size + 3) & ~(size_t)3; }
+
+  uint8_t* buffer;
+  size_t capacity;
+  size_t used;
+  size_t highWater;
+  uint8_t* last;
+};
+
+#endif
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * | File      	:   compositor.h
+ * | Function    :   Panel frames composed row by row from stored images
+ ******************************************************************************/
+#ifndef _COMPOSITOR_H_
+#define _COMPOSITOR_H_
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "slideshow_types.h"
+#include "image_format.h"
+
+enum ComposeResult : uint8_t {
+  COMPOSE_PLAIN,   // A headerless panel-size image, stream the file as stored
+  COMPOSE_READY,   // Render the frame with Compositor::fillBand
+  COMPOSE_FAILED   // A source is missing or the layout is unreadable
+};
+
+// Sources and position of one frame while it is rendered
+struct ComposeFrame {
+  ImageView view;                    // Tiles clipped to their sources
+  uint8_t tileSource[COMPOSE_MAX_TILES];
+  ImageSource sources[COMPOSE_MAX_TILES];  // One per distinct source image
+  uint16_t sourceImage[COMPOSE_MAX_TILES];
+  uint8_t sourceCount;
+  uint16_t nextRow;
+  // Source rows of the scaled tile being filled: the row, the one above and
+  // the one below, each wide enough for a tile of half the panel width
+  // plus a pixel either side
+  int32_t scaleRow[3];
+  uint8_t scaleRows[3][DISPLAY_WIDTH / 4 + 2];
+};
+
+// Builds the panel stream from several stored images: a viewport panned
+// across a larger image, collages of thumbnails, solid fills. Only the
+// band being rendered is in RAM - each tile reads its rows straight from
+// flash as the band passes over it - so a frame costs no more memory
+// than drawing an overlay.
+//
+// Sources stored at a fraction of the size they are shown at (scale 2 for
+// a 200x300 image filling the panel) are enlarged row by row as they are
+// read, so they cost a quarter or less of the download and flash.
+//
+// The layout of the slideshow (image sizes and views, from the manifest)
+// is kept in flash next to the images and read when a frame is shown.
+class Compositor {
+public:
+  // Replace the stored layout with the one of a new slideshow
+  static bool saveLayouts(const ImageLayout* layouts, int count, const ImageView* views, int viewCount);
+
+  // Layout (and view, if any) of slideshow entry index. Entries of a
+  // slideshow without a stored layout are panel-size images.
+  static bool loadLayout(int index, ImageLayout& layout, ImageView* view);
+
+  // Entry is only a source for other views
+  static bool isHidden(int index);
+
+  // Open the sources of entry index. An image that is not panel-size and
+  // has no view is centered on a white panel, enlarged by its scale.
+  static ComposeResult begin(int index, ComposeFrame& frame);
+
+  // BAND_SOURCE (GUI_Band.h) filling the next rows of the frame, Context
+  // is the ComposeFrame
+  static bool fillBand(uint8_t* band, uint32_t length, void* context);
+
+  static void end(ComposeFrame& frame);
+};
+
+#endif
@@ -7,17 +7,102 @@
 
 // Image storage constants
 #define IMAGE_SIZE_BYTES 120000  // 400x600 pixels, 2 pixels per byte = 120,000 bytes
-#define MAX_IMAGES 12            // Maximum number of images we can store
+#define IMAGE_MAX_BYTES (4 * IMAGE_SIZE_BYTES) // Largest stored image, e.g. a 1200x600 panorama to pan across
+// Compile-time upper bound on slideshow length (sizes the state tables).
+// The runtime limit is FlashStorage::getImageCapacity(), derived from the
+// storage partition. Larger flash variants raise this in platformio.ini.
+#ifndef MAX_IMAGES
+#define MAX_IMAGES 12
+#endif
 #define STORAGE_PARTITION_LABEL "storage"
+#ifndef FLASH_WRITE_CHUNK_SIZE
+#define FLASH_WRITE_CHUNK_SIZE 8192 // Bytes buffered per LittleFS write while downloading
+#endif
+
+// Static memory for API responses (no heap allocation per request)
+#define URL_ARENA_SIZE 16384     // Signed URLs for one download batch (~1 KB each)
+#define JSON_ARENA_SIZE 20480    // Scratch space for one parsed JSON response
+#define MANIFEST_PAGE_SIZE 50    // Images requested per manifest page
+#define SIGNED_URL_BATCH_SIZE 12 // Signed URLs requested (and held in memory) at once
+
+// Flash wear accounting
+#define FLASH_ERASE_CYCLES 100000         // Rated program/erase cycles per sector
+#define NVS_ENTRY_BYTES 32                // NVS stores every value in 32-byte entries
+#define STORAGE_METADATA_COMMIT_BYTES 256 // Estimated LittleFS metadata commit per create/remove/rename
+#define WIFI_CONFIG_NVS_BYTES 256         // Estimated NVS entries rewritten for a new WiFi STA config
+#define WEAR_PERSIST_INTERVAL_WAKES 42    // Save wear totals to NVS about once a week
 
 // Display constants
 #define DISPLAY_WIDTH 400
 #define DISPLAY_HEIGHT 600
+#define DISPLAY_BAND_ROWS 40            // Rows per band when drawing over an image (8 KB buffer)
+#define STATUS_BADGE_AFTER_FAILURES 3   // Mark the image after this many failed checks in a row, 0 = never
+#define COMPOSE_MAX_TILES 9             // Crops and fills per composed frame (a 3x3 collage)
+#define COMPOSE_MAX_VIEWS 16            // Composed frames per slideshow (see compositor.h)
+#define COMPOSE_MAX_SCALE 8             // Largest upscale of a stored image, e.g. 50x75 to the full panel
+#define IMAGE_SEEK_POINTS 32            // PackBits restart points per source, whole rows apart (8 bytes each)
 
 // Wake cycle constants
 #define WAKE_INTERVAL_HOURS 4
 #define WAKE_INTERVAL_MICROSECONDS (WAKE_INTERVAL_HOURS * 3600ULL * 1000000ULL)
-#define WAKES_PER_DAY 6  // 24 hours / 4 hours = 6 wakes
+
+// Wake scheduling (see wake_scheduler.h - server hints take precedence)
+#define DEFAULT_DWELL_SECONDS (24UL * 3600UL)       // Per image, if the manifest sets none
+#define DEFAULT_CHECK_INTERVAL_SECONDS (WAKE_INTERVAL_HOURS * 3600UL)
+#define MIN_CHECK_INTERVAL_SECONDS (1UL * 3600UL)
+#define MAX_CHECK_INTERVAL_SECONDS (24UL * 3600UL)
+#define WAKE_COALESCE_SECONDS (30UL * 60UL)         // Do a deadline this close together with the other
+#define QUIET_HOURS_START 23                        // Local hour, no update checks until QUIET_HOURS_END
+#define QUIET_HOURS_END 6
+#define CHECK_SPREAD_SECONDS (60UL * 60UL)          // Fleet checks spread over this window (server can override)
+#define COLD_BOOT_SPREAD_SECONDS (5UL * 60UL)       // First check after power loss is spread over this
+#define BACKOFF_BASE_SECONDS (15UL * 60UL)          // First retry after a failed check, doubling
+#define BACKOFF_MAX_SECONDS (24UL * 3600UL)
+
+// Button (active low, wakes from deep sleep) for manual image advance
+#ifndef BUTTON_PIN
+#define BUTTON_PIN 2
+#endif
+// Must be able to wake the chip from deep sleep: GPIO 0-5 on the C3, the LP
+// GPIOs 0-7 on the C6 (checked in main.cpp)
+#define BUTTON_DEBOUNCE_MS 30
+#define BUTTON_MAX_REFRESHES 3          // Refreshes per button wake, later presses need a new wake
+#define BUTTON_FIRST_SPI_TARGET_MS 500  // Wake (app start) to first image byte on the panel SPI
+
+// Power profiles (see power_profile.h)
+#define POWER_MAX_CPU_MHZ 160
+#define POWER_SUPPLY_VOLTS 3.3f
+
+// Current model for the energy estimate (see energy_model.h). Rough
+// ESP32-C3 module and 4in0e panel figures - measure your board and adjust.
+#define ENERGY_MA_CPU_MAX 28        // CPU active at POWER_MAX_CPU_MHZ
+#define ENERGY_MA_CPU_80MHZ 20
+#define ENERGY_MA_CPU_XTAL 13       // 40 MHz crystal clock
+#define ENERGY_MA_LIGHT_SLEEP 1     // Auto light sleep, including BUSY poll wake-ups
+#define ENERGY_MA_RADIO_RX 60       // Added to the CPU while WiFi is up
+#define ENERGY_MA_RADIO_TX 250      // Added to the CPU while transmitting
+#define ENERGY_RADIO_TX_PERCENT 10  // Share of radio-on time spent transmitting
+#define ENERGY_MA_PANEL_REFRESH 20  // Panel supply during a refresh
+#define ENERGY_UA_DEEP_SLEEP 20     // Module and board in deep sleep
+#ifndef ENERGY_BATTERY_MAH
+#define ENERGY_BATTERY_MAH 2000
+#endif
+
+// Trace spans (see trace.h). -DTRACE_ENABLED=0 compiles them out.
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+#define TRACE_RING_SIZE 64  // Spans kept in RTC memory across wakes
+#define TRACE_NAME_LEN 16
+
+// Entries queued for the next version check (see outbox.h)
+#define OUTBOX_CAPACITY 8
+
+// WiFi connect timeouts, scaled within these by recent connect history
+#define WIFI_DIRECTED_TIMEOUT_MIN_MS 1500   // Saved channel/BSSID
+#define WIFI_DIRECTED_TIMEOUT_MAX_MS 5000
+#define WIFI_SCAN_TIMEOUT_MIN_MS 4000       // Full scan
+#define WIFI_SCAN_TIMEOUT_MAX_MS 30000
 
 #endif
 
@@ -0,0 +1,62 @@
+/*****************************************************************************
+ * | File      	:   energy_model.h
+ * | Function    :   Charge per wake and projected battery life
+ ******************************************************************************/
+#ifndef _ENERGY_MODEL_H_
+#define _ENERGY_MODEL_H_
+
+#include <stdint.h>
+
+// Charge used by one wake, split by consumer (milliamp-seconds)
+struct WakeCharge {
+  float cpu;    // CPU at the clock of each power profile, or light sleep
+  float radio;  // On top of the CPU while WiFi is up (RX plus a TX share)
+  float panel;  // Panel supply during refreshes
+  float sleep;  // Deep sleep before this wake
+  uint32_t activeMs;
+  uint32_t sleepMs;
+};
+
+// Totals accumulated across wakes (RTC memory, reset on power loss)
+struct EnergyTotals {
+  uint64_t activeMicroampSeconds;
+  uint64_t sleepMicroampSeconds;
+  uint64_t activeMs;
+  uint64_t sleepMs;
+  uint32_t wakes;
+};
+
+// Turns this wake's timings into charge with the ENERGY_* current model in
+// config.h: CPU time per power profile (PowerManager residency), radio-on
+// time (the crypto and io profiles), panel refresh time (timed by the EPD
+// driver) and the length of the deep sleep before the wake (measured by
+// PowerManager).
+// The running totals give the average current, mAh per day and a battery
+// life projection.
+class EnergyModel {
+public:
+  // Restore totals from RTC memory and account the deep sleep just ended
+  // (after PowerManager::begin())
+  static void begin();
+
+  // Fold this wake into the totals; later calls are no-ops
+  static void endWake();
+
+  static const WakeCharge& getWake();
+  static const EnergyTotals& getTotals();
+
+  // Average supply current over all wakes and sleeps so far, or a negative
+  // value until a full sleep/wake cycle has been seen
+  static float getAverageMilliamps();
+
+  // Days until ENERGY_BATTERY_MAH is used up at the average current
+  static float getBatteryLifeDays();
+
+  // Lines for the TIMING DIAGNOSTICS block
+  static void printDiagnostics();
+
+private:
+  static void store();
+};
+
+#endif
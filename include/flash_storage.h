@@ -1,6 +1,6 @@
 /*****************************************************************************
  * | File      	:   flash_storage.h
- * | Function    :   Flash storage for images (SPIFFS)
+ * | Function    :   Flash storage for images (LittleFS)
  ******************************************************************************/
 #ifndef _FLASH_STORAGE_H_
 #define _FLASH_STORAGE_H_
@@ -8,6 +8,10 @@
 #include <Arduino.h>
 #include <LittleFS.h>
 #include "config.h"
+#include "slideshow_types.h"
+#include "wear_stats.h"
+
+#define IMAGE_PATH_MAX_LEN 24
 
 class FlashStorage {
 public:
@@ -22,17 +26,46 @@ public:
   static bool hasImage(int index);
   static bool deleteImage(int index);
   static bool clearAllImages();
+  static void deleteImagesFrom(int firstIndex);
+
+  // Move an existing image aside so a new slideshow can reuse it at a
+  // different index without downloading it again
+  static bool stageImage(int fromIndex, int toIndex);
+  static bool hasStagedImage(int toIndex);
+  static bool commitStagedImage(int toIndex);
+  static void clearStagedImages();
   
-  // Get image file path
-  static String getImagePath(int index);
+  // Small files kept next to the images (e.g. the slideshow layout),
+  // replaced whole
+  static bool writeFile(const char* path, const uint8_t* data, size_t size);
+  static File openFile(const char* path);
+
+  // Get image file path (e.g. "/image_3.bin")
+  static void getImagePath(int index, char* path, size_t pathSize);
   
   // Storage info
   static size_t getFreeSpace();
   static size_t getUsedSpace();
   static size_t getTotalSpace();
+
+  // Number of images of the given encoded size that fit in the partition,
+  // capped by the compile-time MAX_IMAGES
+  static int getImageCapacity(size_t imageBytes = IMAGE_SIZE_BYTES);
+  // Number of leading images of a slideshow that fit in the partition
+  // together, each budgeted at the stored size of its layout
+  static int getImageCapacity(const ImageLayout* layouts, int count);
+
+  // Writes made through this class since boot
+  static const WriteCounters& getWriteCounters();
   
 private:
+  static size_t getImageBlocks();
+  static void countWrite(size_t dataBytes);
+  static bool removeFile(const char* path);
+  static bool renameFile(const char* pathFrom, const char* pathTo);
+
   static bool initialized;
+  static WriteCounters writeCounters;
 };
 
 #endif
@@ -61,16 +61,21 @@ typedef struct _tFont
   
 } sFONT;
 
-//GB2312
-typedef struct                                          // 汉字字模数据结构
+//Unicode, generated from fonts/fonts.txt by scripts/gen_font.py
+typedef struct
 {
-  unsigned char index[4];                               // 汉字内码索引
-  const unsigned char matrix[MAX_HEIGHT_FONT*MAX_WIDTH_FONT/8 + 1];  // 点阵码数据
-}CH_CN;
+  uint32_t offset;                                      // first byte in cFONT.bitmap
+  uint8_t width;                                        // ink box, rows of (width+7)/8 bytes
+  uint8_t height;
+  uint8_t left;                                         // ink box position in the cell
+  uint8_t top;
+}CH_GLYPH;
 
 typedef struct
 {    
-  const CH_CN *table;
+  const uint32_t *codepoints;                           // sorted, one per glyph
+  const CH_GLYPH *glyphs;
+  const uint8_t *bitmap;
   uint16_t size;
   uint16_t ASCII_Width;
   uint16_t Width;
@@ -0,0 +1,38 @@
+/*****************************************************************************
+ * | File      	:   image_container.h
+ * | Function    :   Image container header, shared with tools/img2epd
+ ******************************************************************************/
+#ifndef _IMAGE_CONTAINER_H_
+#define _IMAGE_CONTAINER_H_
+
+#include <stdint.h>
+#include "slideshow_types.h"
+
+// Bytes 89 'E' 'P' 'D'. 0x8 is not a panel color, so raw rows never start
+// with it and headerless images are told apart by their first byte.
+#define IMAGE_MAGIC 0x44504589
+#define IMAGE_FORMAT_VERSION 1  // Changes that old devices cannot read; fields are appended without one
+
+enum ImageCodec : uint8_t {
+  IMAGE_CODEC_RAW = 0,       // Rows of 2 pixels per byte, as the panel takes them
+  IMAGE_CODEC_PACKBITS = 1   // The same rows run-length coded (PackBits), runs may cross rows
+};
+
+// Little-endian, followed by the payload at headerSize
+struct __attribute__((packed)) ImageHeader {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t headerSize;    // Bytes up to the payload, at least sizeof(ImageHeader)
+  uint8_t codec;         // ImageCodec of the payload
+  uint8_t bpp;           // Bits per pixel of the decoded rows, 4
+  uint16_t width;
+  uint16_t height;
+  uint8_t scale;         // Panel pixels per pixel, 0 = as the manifest says
+  uint8_t filter;        // ImageFilter used when scale > 1
+  uint8_t palette[8];    // Panel color of stored colors 0-15, a nibble each (0x01, 0x23, ... is none)
+  uint32_t rawSize;      // Decoded bytes, ((width + 1) / 2) * height
+  uint32_t payloadSize;  // Bytes after the header
+  ImageHash hash;        // SHA-256 of the payload
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ * | File      	:   image_format.h
+ * | Function    :   Stored image decoders and download checks
+ ******************************************************************************/
+#ifndef _IMAGE_FORMAT_H_
+#define _IMAGE_FORMAT_H_
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <mbedtls/sha256.h>
+#include "config.h"
+#include "slideshow_types.h"
+#include "image_container.h"
+
+// Where a sequential decoder is: next code byte in the file and the run
+// being decoded
+struct ImageSeekPoint {
+  uint32_t codePosition;
+  uint8_t run;
+  bool literal;
+  uint8_t runValue;
+};
+
+// A stored image opened for reading decoded rows
+struct ImageSource {
+  File file;
+  uint8_t codec;
+  uint8_t scale;
+  uint8_t filter;
+  bool headerless;        // Raw rows without a header, geometry from the layout
+  bool remap;             // Colors go through palette
+  uint8_t palette[16];
+  uint16_t width;
+  uint16_t height;
+  uint32_t payloadOffset;
+  uint32_t payloadSize;
+  // Sequential decoders: next code byte in the file, decoded bytes before
+  // it and the run being decoded
+  uint32_t codePosition;
+  uint32_t decoded;
+  uint8_t run;
+  bool literal;
+  uint8_t runValue;
+  // Restart points for reads behind the decoder: seek[i] is where decoded
+  // byte i * seekSpan starts (whole rows apart, recorded the first time the
+  // decoder passes), rowMark the start of the row last read
+  uint32_t seekSpan;
+  uint8_t seekPoints;
+  ImageSeekPoint seek[IMAGE_SEEK_POINTS];
+  uint32_t rowMarkDecoded;
+  ImageSeekPoint rowMark;
+};
+
+// Reads decoded bytes of a source, `offset` counted from its first row
+typedef bool (*IMAGE_DECODER)(ImageSource& source, uint32_t offset, uint8_t* dest, size_t bytes);
+
+enum ImageDownloadKind : uint8_t {
+  IMAGE_DOWNLOAD_INVALID,
+  IMAGE_DOWNLOAD_RAW,       // Headerless rows of the size the manifest gave
+  IMAGE_DOWNLOAD_CONTAINER  // A header this firmware can decode
+};
+
+class ImageFormat {
+public:
+  // Open stored image index. A container describes itself; a headerless
+  // file must be the size of its layout.
+  static bool open(int index, const ImageLayout& layout, ImageSource& source);
+
+  // `rows` decoded rows from `row`, bytes firstByte to firstByte + bytes of
+  // each, `stride` bytes apart in dest
+  static bool readRows(ImageSource& source, uint16_t row, uint16_t rows, uint16_t firstByte, uint16_t bytes,
+                       uint8_t* dest, uint16_t stride);
+
+  // What the first bytes of a download of contentLength bytes are; raw
+  // downloads have to be rawSize bytes
+  static ImageDownloadKind checkDownload(const uint8_t* head, size_t headBytes, int contentLength,
+                                         size_t rawSize, ImageHeader& header);
+
+  // Stored image index opens for layout: a container whose header agrees
+  // with the file size, or raw rows of the layout's size. Reads the header
+  // only - the content is not hashed.
+  static bool storedFits(int index, const ImageLayout& layout);
+
+  // Codecs this firmware decodes, e.g. "raw,packbits", for the manifest request
+  static void codecList(char* out, size_t size);
+};
+
+// The download as saveImageFromStream reads it: the bytes read by
+// checkDownload first, then the HTTP stream, hashing the payload of a
+// container on the way to flash
+class ImageDownloadStream : public Stream {
+public:
+  ImageDownloadStream(Stream* stream, const uint8_t* head, size_t headBytes, const ImageHeader* header);
+  ~ImageDownloadStream();
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char* buffer, size_t length) override;
+  size_t write(uint8_t) { return 0; }
+  void flush() {}
+
+  // Payload matched the header's hash (always true for raw downloads)
+  bool hashMatches();
+
+private:
+  void hash(const uint8_t* data, size_t length);
+
+  Stream* stream;
+  const uint8_t* head;
+  size_t headBytes;
+  size_t position;  // Bytes handed out so far
+  const ImageHeader* header;
+  mbedtls_sha256_context sha;
+};
+
+#endif
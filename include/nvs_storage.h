@@ -7,17 +7,18 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "slideshow_types.h"
+#include "wear_stats.h"
 
 // Device state stored in NVS
-struct DeviceState {
-  String deviceKey;           // Raw device key (32 bytes hex = 64 chars)
+template <int Capacity>
+struct DeviceStateT : ImageTable<Capacity> {
   int currentImageIndex;      // Current image index (0-based)
   int wakeCounter;            // Wake counter (0-5, resets at 6)
   int slideshowVersion;       // Last known slideshow version
   int imageCount;             // Number of images in current slideshow
-  String imageIds[12];        // Image UUIDs (max 12)
-  String imageHashes[12];     // Image hashes (max 12)
 };
+typedef DeviceStateT<MAX_IMAGES> DeviceState;
 
 class NVSStorage {
 public:
@@ -25,26 +26,44 @@ public:
   static void end();
   
   // Device key management
-  static bool saveDeviceKey(const String& key);
-  static String loadDeviceKey();
+  static bool saveDeviceKey(const char* key);
+  static bool loadDeviceKey(char* key, size_t keySize);
   static bool hasDeviceKey();
   
   // State management
   static bool saveState(const DeviceState& state);
   static bool loadState(DeviceState& state);
+  // Load only the image IDs/hashes (StateCache keeps the rest in RTC memory).
+  // state.imageCount is set to the number of slots the table covers.
+  static bool loadImageTable(DeviceState& state);
+  // Save only the image IDs/hashes for state.imageCount slots, when images
+  // moved on flash before the new slideshow is complete
+  static bool saveImageTable(const DeviceState& state);
   static bool clearState();
   
   // Individual state fields
   static bool saveInt(const char* key, int value);
   static int loadInt(const char* key, int defaultValue);
-  static bool saveString(const char* key, const String& value);
-  static String loadString(const char* key, const String& defaultValue);
-  static bool saveStringArray(const char* key, const String* values, int count);
-  static int loadStringArray(const char* key, String* values, int maxCount);
+  static bool saveString(const char* key, const char* value);
+  static bool loadString(const char* key, char* value, size_t valueSize);
+  static bool saveBytes(const char* key, const void* value, size_t length);
+  static size_t loadBytes(const char* key, void* value, size_t length);
+
+  // Writes made through this class since boot
+  static const WriteCounters& getWriteCounters();
   
 private:
+  static void readImageTable(DeviceState& state);
+  static bool writeImageTable(const DeviceState& state);
+
+  // Counted wrappers around Preferences writes (preferences must be open)
+  static size_t writeInt(const char* key, int32_t value);
+  static size_t writeString(const char* key, const char* value);
+  static size_t writeBytes(const char* key, const void* value, size_t length);
+  static void eraseKey(const char* key);
+
   static Preferences preferences;
+  static WriteCounters writeCounters;
 };
 
 #endif
-
@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * | File      	:   outbox.h
+ * | Function    :   RTC-persisted queue of ACKs and events for the server
+ ******************************************************************************/
+#ifndef _OUTBOX_H_
+#define _OUTBOX_H_
+
+#include <Arduino.h>
+
+enum OutboxType : uint8_t {
+  OUTBOX_ACK_DISPLAYED = 1,  // value: slideshow version shown on the panel
+  OUTBOX_CHECK_FAILED,       // value: CheckFailure of a failed update check
+  OUTBOX_DISPLAY_FAILED      // value: image index that could not be shown
+};
+
+struct OutboxEntry {
+  uint8_t type;
+  int32_t value;
+};
+
+// Things to tell the server that don't justify a connection of their own.
+// Entries wait in RTC memory and ride along on the next version check as
+// query parameters ("&ack=<version>&events=<type>.<value>,..."), so a new
+// slideshow wake no longer reconnects after the refresh just to ACK it.
+// Lost on power loss - the server sees a missing ACK as "not displayed yet".
+class Outbox {
+public:
+  // Restore from RTC memory (empty on cold boot)
+  static void begin();
+
+  // Queue an entry. A newer ACK replaces an older one; when full the oldest
+  // event is dropped.
+  static void push(OutboxType type, int32_t value);
+
+  static int count();
+
+  // Latest queued ACK, or -1 if none
+  static int32_t pendingAck();
+
+  // Append the query parameters for all entries; returns false if they don't fit
+  static bool formatQuery(char* buffer, size_t size);
+
+  // The server has received everything queued
+  static void clear();
+
+private:
+  static void store();
+};
+
+#endif
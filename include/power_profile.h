@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * | File      	:   power_profile.h
+ * | Function    :   Per-phase CPU clock / light sleep profiles
+ ******************************************************************************/
+#ifndef _POWER_PROFILE_H_
+#define _POWER_PROFILE_H_
+
+#include <Arduino.h>
+
+enum PowerProfile : uint8_t {
+  POWER_PROFILE_CRYPTO = 0,  // TLS handshake, SHA-256: CPU locked at max clock
+  POWER_PROFILE_IO,          // Waiting on WiFi/HTTP: max clock on demand, XTAL when idle
+  POWER_PROFILE_BUS,         // SPI upload, flash reads: 80 MHz is enough to keep the bus busy
+  POWER_PROFILE_IDLE,        // Panel BUSY waits, radio off: XTAL clock, auto light sleep
+  POWER_PROFILE_COUNT
+};
+
+// The wake cycle switches profiles as it moves between phases. With
+// CONFIG_PM_ENABLE each profile is an esp_pm configuration (auto light
+// sleep also needs CONFIG_FREERTOS_USE_TICKLESS_IDLE); without it the CPU
+// clock is set directly. Time spent in each profile is recorded for the
+// energy model (energy_model.h).
+//
+// The length of the deep sleep between wakes is measured here too, on the
+// RTC clock, for the energy model and the wear stats.
+class PowerManager {
+public:
+  // Start accounting (in POWER_PROFILE_BUS) and measure the deep sleep that
+  // just ended
+  static void begin();
+
+  // Length of the deep sleep before this wake, 0 after a cold boot or a
+  // reset mid-wake
+  static uint32_t getSleptMs();
+
+  // Call right before esp_deep_sleep_start()
+  static void beginDeepSleep();
+
+  // Switch profile; no-op if already active
+  static void setProfile(PowerProfile profile);
+  static PowerProfile getProfile();
+
+  // Time in a profile this wake, including the active one up to now
+  static uint32_t getResidencyMs(PowerProfile profile);
+
+  // Clock the CPU spends most of a profile at (idle periods included),
+  // 0 if it light sleeps instead
+  static uint16_t getTypicalMhz(PowerProfile profile);
+
+  static void printDiagnostics();
+
+private:
+  static void account();
+  static void apply(PowerProfile profile);
+};
+
+#endif
@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * | File      	:   slideshow_types.h
+ * | Function    :   Fixed-capacity slideshow data model (no heap Strings)
+ ******************************************************************************/
+#ifndef _SLIDESHOW_TYPES_H_
+#define _SLIDESHOW_TYPES_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "config.h"
+
+#define IMAGE_ID_MAX_LEN 40     // Image UUIDs are 36 chars
+#define IMAGE_HASH_BYTES 32     // SHA-256
+#define DEVICE_ID_LEN 12        // MAC address as 12 hex digits
+#define DEVICE_KEY_LEN 64       // 32 bytes as 64 hex digits
+
+typedef char ImageId[IMAGE_ID_MAX_LEN + 1];
+typedef uint8_t ImageHash[IMAGE_HASH_BYTES];
+
+// Image IDs and hashes of a slideshow, sized at compile time
+template <int Capacity>
+struct ImageTable {
+  static const int capacity = Capacity;
+  ImageId imageIds[Capacity];
+  ImageHash imageHashes[Capacity];
+};
+
+// Composed frames (see compositor.h). A view builds the panel image from
+// viewports of stored images and solid fills instead of showing one image
+// as stored.
+enum ViewTileType : uint8_t {
+  VIEW_TILE_IMAGE = 1,  // Viewport of a stored image
+  VIEW_TILE_FILL        // Solid panel color
+};
+
+// How a source smaller than the panel area it covers is enlarged
+enum ImageFilter : uint8_t {
+  IMAGE_FILTER_NEAREST,  // Each source pixel becomes a scale x scale block (pixel art, text)
+  IMAGE_FILTER_DITHER    // Block edges blend into their neighbours with an ordered dither
+};
+
+// A rectangle of the panel. x and width are even, so every tile starts and
+// ends on a byte (2 pixels per byte); so is sourceX of unscaled tiles.
+struct ViewTile {
+  uint8_t type;
+  uint8_t color;              // VIEW_TILE_FILL
+  uint8_t scale;              // Panel pixels per source pixel, 0 = the source's own
+  uint8_t filter;             // ImageFilter of scaled tiles
+  uint16_t image;             // VIEW_TILE_IMAGE: slideshow index of the source
+  uint16_t x, y, width, height;
+  uint16_t sourceX, sourceY;  // Top left of the viewport in the source, in source pixels
+};
+
+#define VIEW_HIDDEN 0x01  // A source for other views only, skipped by the slideshow
+
+struct ImageView {
+  uint8_t flags;
+  uint8_t background;  // Panel color outside the tiles
+  uint8_t tileCount;
+  ViewTile tiles[COMPOSE_MAX_TILES];
+};
+
+// How a slideshow entry is stored and shown
+struct ImageLayout {
+  uint16_t width;   // Stored image in pixels, 0 = nothing stored (view only)
+  uint16_t height;
+  uint8_t view;     // 1-based index into the slideshow's views, 0 = shown as stored
+  uint8_t scale;    // Panel pixels per stored pixel, 1 to COMPOSE_MAX_SCALE
+  uint8_t filter;   // ImageFilter used when scale > 1
+};
+
+inline size_t imageStoredBytes(const ImageLayout& layout) {
+  return (size_t)((layout.width + 1) / 2) * layout.height;
+}
+
+// Copy a NUL-terminated string into a fixed buffer, always terminating it.
+// Returns false if the source had to be truncated.
+inline bool copyFixedString(char* dest, size_t destSize, const char* src) {
+  if (destSize == 0) return false;
+  if (!src) src = "";
+  size_t len = strlen(src);
+  bool fits = len < destSize;
+  if (!fits) len = destSize - 1;
+  memcpy(dest, src, len);
+  dest[len] = '\0';
+  return fits;
+}
+
+// Decode exactly outLen bytes from a hex string. Returns false on bad input.
+inline bool hexToBytes(const char* hex, uint8_t* out, size_t outLen) {
+  if (!hex || strlen(hex) != outLen * 2) return false;
+  for (size_t i = 0; i < outLen * 2; i++) {
+    char c = hex[i];
+    uint8_t nibble;
+    if (c >= '0' && c <= '9') nibble = c - '0';
+    else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+    else return false;
+    if (i % 2 == 0) out[i / 2] = nibble << 4;
+    else out[i / 2] |= nibble;
+  }
+  return true;
+}
+
+// Encode len bytes as lowercase hex. out must hold 2 * len + 1 chars.
+inline void bytesToHex(const uint8_t* in, size_t len, char* out) {
+  static const char digits[] = "0123456789abcdef";
+  for (size_t i = 0; i < len; i++) {
+    out[i * 2] = digits[in[i] >> 4];
+    out[i * 2 + 1] = digits[in[i] & 0x0F];
+  }
+  out[len * 2] = '\0';
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * | File      	:   state_cache.h
+ * | Function    :   Write-back cache of device state in RTC memory
+ ******************************************************************************/
+#ifndef _STATE_CACHE_H_
+#define _STATE_CACHE_H_
+
+#include <Arduino.h>
+#include "nvs_storage.h"
+
+// Counters kept in RTC memory (reset on cold boot)
+struct StateCacheStats {
+  uint32_t nvsWrites;         // Saves that were committed to NVS
+  uint32_t nvsWritesAvoided;  // Saves that only touched RTC memory
+  uint32_t nvsLoadsAvoided;   // Wakes that restored state from RTC memory
+};
+
+// Device state lives in RTC memory across deep sleep. NVS is only read on
+// cold boot (missing magic or bad checksum) and only written when the
+// slideshow itself changes (version or image count), so routine image
+// advances and wake counter updates never wear flash.
+class StateCache {
+public:
+  // Restore state from RTC memory, falling back to NVS on cold boot.
+  // Returns false if neither holds any state (first boot).
+  static bool load(DeviceState& state);
+
+  // Write state back to RTC memory, and to NVS if the slideshow changed
+  static bool save(const DeviceState& state);
+
+  // Write state to RTC memory and NVS unconditionally
+  static bool commit(const DeviceState& state);
+
+  // True if the last load() was served from RTC memory
+  static bool isWarm();
+
+  static const StateCacheStats& getStats();
+
+private:
+  static void storeRTC(const DeviceState& state);
+  static uint32_t checksum();
+  static bool warm;
+};
+
+#endif
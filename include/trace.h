@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * | File      	:   trace.h
+ * | Function    :   Scoped microsecond trace spans in an RTC ring buffer
+ ******************************************************************************/
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <Arduino.h>
+#include "config.h"
+
+#define TRACE_DEPTH_CURRENT 0xFE     // record() at the calling task's current depth
+#define TRACE_DEPTH_BACKGROUND 0xFF  // Work overlapping the loop task (radio, panel init)
+
+#if TRACE_ENABLED
+#include <esp_timer.h>
+
+// Spans are kept two ways:
+//  - a ring of the last TRACE_RING_SIZE spans in RTC memory, across wakes,
+//    printed as "TRACE,..." lines for scripts/trace_to_chrome.py
+//  - per-name totals for this wake (RAM), printed as a nested table, so
+//    long runs of repeated spans (per-image downloads) never get lost
+// Spans from the loop task nest by scope; spans from other tasks (panel
+// init) are marked as background.
+class Trace {
+public:
+  // Start a new wake: bumps the wake number, clears this wake's totals
+  static void begin();
+
+  static int64_t now() { return esp_timer_get_time(); }
+
+  // Depth for a span opened now on the calling task
+  static uint8_t enter();
+
+  // Record a finished span; a depth from enter() also closes that level
+  static void record(const char* name, int64_t startUs, int64_t endUs, uint8_t depth = TRACE_DEPTH_CURRENT);
+
+  // This wake's spans as a nested table of totals
+  static void printWake();
+
+  // Spans not printed yet as "TRACE,<wake>,<task>,<depth>,<startUs>,<durationUs>,<name>"
+  static void dump();
+
+  // Total time in spans of this name this wake
+  static uint32_t getTotalUs(const char* name);
+};
+
+// Records its lifetime as a span; end() closes it early (once)
+class TraceSpan {
+public:
+  explicit TraceSpan(const char* name) : name(name), depth(Trace::enter()), startUs(Trace::now()) {}
+  ~TraceSpan() { end(); }
+  void end() {
+    if (name) {
+      Trace::record(name, startUs, Trace::now(), depth);
+      name = nullptr;
+    }
+  }
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+  const char* name;
+  uint8_t depth;
+  int64_t startUs;
+};
+
+#else
+
+// Tracing compiled out - everything below is empty and optimized away
+class Trace {
+public:
+  static void begin() {}
+  static int64_t now() { return 0; }
+  static void record(const char*, int64_t, int64_t, uint8_t = 0) {}
+  static void printWake() {}
+  static void dump() {}
+  static uint32_t getTotalUs(const char*) { return 0; }
+};
+
+class TraceSpan {
+public:
+  explicit TraceSpan(const char*) {}
+  void end() {}
+};
+
+#endif
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+// Trace the rest of the enclosing scope
+#define TRACE_SCOPE(name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+
+#endif
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * | File      	:   wake_orchestrator.h
+ * | Function    :   Overlap boot phases (WiFi, state, flash, panel) per wake
+ ******************************************************************************/
+#ifndef _WAKE_ORCHESTRATOR_H_
+#define _WAKE_ORCHESTRATOR_H_
+
+#include <Arduino.h>
+
+enum WakePhase {
+  WAKE_PHASE_WIFI = 0,     // Association + DHCP (radio, runs on its own)
+  WAKE_PHASE_STATE,        // RTC/NVS state and device key
+  WAKE_PHASE_FLASH_MOUNT,  // LittleFS mount
+  WAKE_PHASE_PANEL_INIT,   // Panel reset + init (background task)
+  WAKE_PHASE_COUNT
+};
+
+// WiFi association is started first; state load, flash mount and - when a
+// display update is likely - panel init run while the radio associates.
+// The panel runs in its own task and signals completion on an event group.
+class WakeOrchestrator {
+public:
+  static void beginPhase(WakePhase phase);
+  static void endPhase(WakePhase phase);
+
+  // Start DEV_Module_Init() + EPD_4IN0E_Init() in a background task
+  static void startPanelInit();
+
+  // Block until the panel is initialized; initializes it inline if
+  // startPanelInit() was not called this wake
+  static bool ensurePanelReady(uint32_t timeoutMs = 10000);
+
+  // Per-phase start/end and the resulting critical path
+  static void printDiagnostics();
+};
+
+#endif
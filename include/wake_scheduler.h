@@ -0,0 +1,88 @@
+/*****************************************************************************
+ * | File      	:   wake_scheduler.h
+ * | Function    :   Computes the next wake from dwell times and server hints
+ ******************************************************************************/
+#ifndef _WAKE_SCHEDULER_H_
+#define _WAKE_SCHEDULER_H_
+
+#include <Arduino.h>
+#include "api_client.h"
+
+// What a wake has to do (bit flags)
+enum WakeAction : uint8_t {
+  WAKE_ACTION_NONE = 0,
+  WAKE_ACTION_ADVANCE = 1,  // Current image has been shown for its dwell time
+  WAKE_ACTION_CHECK = 2     // Ask the server for a new slideshow (needs WiFi)
+};
+
+// Why an update check failed, decides how long to back off
+enum CheckFailure : uint8_t {
+  CHECK_FAILURE_NONE = 0,
+  CHECK_FAILURE_NO_AP,        // Access point not found (frame moved, AP off)
+  CHECK_FAILURE_WIFI,         // Association or DHCP failed, or timed out
+  CHECK_FAILURE_CREDENTIALS,  // WiFi password rejected - needs the owner
+  CHECK_FAILURE_NETWORK,      // No HTTP response (DNS, connect, TLS, read timeout)
+  CHECK_FAILURE_SERVER,       // 5xx or an unusable response
+  CHECK_FAILURE_THROTTLED,    // 429, or 503 with Retry-After
+  CHECK_FAILURE_REJECTED      // Other 4xx, e.g. unknown device key - needs the owner
+};
+
+// Keeps two deadlines in RTC memory - the next image advance and the next
+// update check - and sleeps until the earlier one. Advance-only wakes never
+// touch the radio.
+//
+//  - Advance: per-image dwell from the manifest (DEFAULT_DWELL_SECONDS if none)
+//  - Check:   server nextCheckSeconds hint if given, otherwise a quarter of
+//             the owner's average time between slideshow changes, clamped to
+//             [MIN_CHECK_INTERVAL_SECONDS, MAX_CHECK_INTERVAL_SECONDS]
+//  - Checks are splayed by a hash of the MAC: each frame lands on its own
+//    phase within a CHECK_SPREAD_SECONDS window (server checkSpreadSeconds),
+//    and the first check after power loss within COLD_BOOT_SPREAD_SECONDS
+//  - Checks falling in QUIET_HOURS_START..QUIET_HOURS_END local time move to
+//    the end of the quiet period (once the server has provided the time)
+//  - Failed checks back off exponentially from BACKOFF_BASE_SECONDS to
+//    BACKOFF_MAX_SECONDS (failures that need the owner start high), jittered
+//    per device; a server Retry-After is honored
+//  - A deadline due within WAKE_COALESCE_SECONDS of the other is done early
+//    in the same wake
+class WakeScheduler {
+public:
+  // Restore from RTC memory; on cold boot an update check is due immediately.
+  // Only touches RTC memory, so it can run before the device state is loaded.
+  static void begin();
+
+  // Images in the current slideshow (reloads dwell times from NVS on cold boot)
+  static void setImageCount(int count);
+
+  // Actions due now
+  static uint8_t getDueActions();
+
+  // The image at currentIndex started showing now
+  static void noteAdvanced(int currentIndex);
+
+  // Update check finished. response (if any) applies server hints and time;
+  // a failure backs off the next check, CHECK_FAILURE_NONE ends any backoff.
+  static void noteChecked(const SlideshowVersionResponse* response, bool slideshowChanged,
+                          CheckFailure failure = CHECK_FAILURE_NONE, uint32_t retryAfterSeconds = 0);
+
+  static const char* failureName(CheckFailure failure);
+
+  // Failed checks in a row (0 = the last check succeeded)
+  static uint8_t getConsecutiveFailures();
+
+  // New slideshow stored - dwell per image in minutes (0 = default)
+  static void setImageDwell(const uint16_t* dwellMinutes, int count);
+
+  // Microseconds until the next due action
+  static uint64_t getSleepMicros();
+
+  static void printDiagnostics();
+
+private:
+  static uint32_t dwellSeconds(int index);
+  static int64_t nextAdvanceTime();
+  static int64_t nextCheckTime();
+  static void store();
+};
+
+#endif
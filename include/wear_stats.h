@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * | File      	:   wear_stats.h
+ * | Function    :   Flash and NVS write accounting with wear estimation
+ ******************************************************************************/
+#ifndef _WEAR_STATS_H_
+#define _WEAR_STATS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Mutations made by one storage layer since boot. Byte counts are what the
+// layer asked the flash to program, including estimated metadata overhead.
+struct WriteCounters {
+  uint32_t bytes;
+  uint32_t operations;
+};
+
+// Totals accumulated across wakes (RTC memory, persisted to NVS periodically)
+struct WearTotals {
+  uint64_t storageBytes;      // LittleFS "storage" partition
+  uint64_t nvsBytes;          // NVS, including WiFi driver config
+  uint32_t storageOps;
+  uint32_t nvsOps;
+  uint32_t wifiConfigWrites;  // Times the WiFi driver rewrote its NVS config
+  uint32_t wakes;
+  uint64_t elapsedMs;         // Time the totals cover, wakes and deep sleeps
+};
+
+// Collects the write counters of FlashStorage and NVSStorage once per wake,
+// keeps running totals and projects flash lifetime from the write rate per
+// elapsed time, whatever the wake rate is.
+class WearStats {
+public:
+  // Restore totals from RTC memory, or from NVS on cold boot, and add the
+  // deep sleep just ended (after PowerManager::begin())
+  static void begin();
+
+  // Call before WiFi.begin() with WiFi.persistent(true). The driver only
+  // rewrites its NVS config when SSID, password, channel or BSSID differ
+  // from what it has stored, so that is what gets counted.
+  static void noteWifiConfig(const char* ssid, const char* password, uint8_t channel, const uint8_t* bssid);
+
+  // Fold this wake's counters into the totals; persists every
+  // WEAR_PERSIST_INTERVAL_WAKES wakes
+  static void endWake();
+
+  static const WearTotals& getTotals();
+  static const WearTotals& getWake();
+
+  // Years until the partition reaches its rated erase cycles at the average
+  // write rate so far, or a negative value until something was written over
+  // a measured sleep
+  static float getStorageLifetimeYears();
+  static float getNvsLifetimeYears();
+
+  // Lines for the TIMING DIAGNOSTICS block
+  static void printDiagnostics();
+
+private:
+  static void collect();
+  static void store();
+};
+
+#endif
@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * | File      	:   wifi_connector.h
+ * | Function    :   Event-driven WiFi station connect with phase timings
+ ******************************************************************************/
+#ifndef _WIFI_CONNECTOR_H_
+#define _WIFI_CONNECTOR_H_
+
+#include <Arduino.h>
+
+// Why a connection attempt failed, derived from the disconnect reason
+enum WiFiFailure : uint8_t {
+  WIFI_FAILURE_NONE = 0,
+  WIFI_FAILURE_NO_AP,      // AP not found on the channel(s) scanned
+  WIFI_FAILURE_AUTH,       // Wrong password or handshake rejected - retrying won't help
+  WIFI_FAILURE_ASSOC,      // AP refused or dropped association (busy, out of range)
+  WIFI_FAILURE_LINK_LOST,  // Other disconnect before an IP was assigned
+  WIFI_FAILURE_DHCP,       // Link came up but no IP within the timeout
+  WIFI_FAILURE_TIMEOUT     // No event at all within the timeout
+};
+
+struct WiFiAttempt {
+  bool connected;
+  WiFiFailure failure;
+  uint8_t reason;       // Last disconnect reason (wifi_err_reason_t), 0 if none
+  uint32_t linkMs;      // begin() -> STA_CONNECTED: scan, auth, assoc, 4-way handshake
+  uint32_t dhcpMs;      // STA_CONNECTED -> GOT_IP (near zero with a static IP)
+  uint32_t totalMs;
+};
+
+// Wraps WiFi.begin() and blocks on a FreeRTOS event group instead of polling
+// WiFi.status(). The loop task sleeps until the driver reports GOT_IP or a
+// disconnect, so under POWER_PROFILE_IO the idle task can scale the CPU
+// clock down while association and DHCP are in progress.
+class WiFiConnector {
+public:
+  // Start associating; returns immediately. channel 0 scans all channels.
+  static void begin(const char* ssid, const char* password, uint8_t channel, const uint8_t* bssid);
+
+  // Wait for an IP, a disconnect or the timeout, whichever comes first
+  static WiFiAttempt wait(uint32_t timeoutMs);
+
+  // Timeout for the attempt begin() just started, from the typical connect
+  // time of that kind of attempt (known channel or full scan) and recent failures
+  static uint32_t timeoutMs();
+
+  // Result of the last wait()
+  static const WiFiAttempt& getLastAttempt();
+
+  static const char* failureName(WiFiFailure failure);
+
+private:
+  static void init();
+  static WiFiFailure classify(uint8_t reason);
+};
+
+#endif
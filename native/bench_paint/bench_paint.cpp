@@ -0,0 +1,227 @@
+/*****************************************************************************
+ * | File      	:   bench_paint.cpp
+ * | Function    :   Host benchmark of the GUI_Paint fill and text primitives
+ * | Info        :   pio run -e native_bench_paint -t exec
+ ******************************************************************************/
+#include <Arduino.h>
+#include "GUI_Paint.h"
+
+#define BENCH_WIDTH 400
+#define BENCH_HEIGHT 600
+#define BENCH_BUFFER_BYTES (BENCH_WIDTH * BENCH_HEIGHT / 2)
+#define BENCH_MIN_US 2000  // Draws repeat until a timing is this long, far above micros() resolution
+
+// Point-by-point versions of the fills and text, as GUI_Paint drew them
+// before spans and the glyph blitter
+static void pointClear(UWORD Color) {
+  for (UWORD Y = 0; Y < Paint.BandRows; Y++) {
+    for (UWORD X = 0; X < Paint.WidthByte; X++) {
+      UDOUBLE Addr = X + Y * Paint.WidthByte;
+      if (Paint.Scale == 2) {
+        Paint.Image[Addr] = Color;
+      } else if (Paint.Scale == 4) {
+        Paint.Image[Addr] = (Color << 6) | (Color << 4) | (Color << 2) | Color;
+      } else {
+        Paint.Image[Addr] = (Color << 4) | Color;
+      }
+    }
+  }
+}
+
+static void pointClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color) {
+  for (UWORD Y = Ystart; Y < Yend; Y++) {
+    for (UWORD X = Xstart; X < Xend; X++) {
+      Paint_SetPixel(X, Y, Color);
+    }
+  }
+}
+
+static void pointRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                           UWORD Color, DOT_PIXEL Line_width) {
+  for (UWORD Ypoint = Ystart; Ypoint < Yend; Ypoint++) {
+    Paint_DrawLine(Xstart, Ypoint, Xend, Ypoint, Color, Line_width, LINE_STYLE_SOLID);
+  }
+}
+
+static void pointCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color) {
+  int16_t XCurrent = 0;
+  int16_t YCurrent = Radius;
+  int16_t Esp = 3 - (Radius << 1);
+  while (XCurrent <= YCurrent) {
+    for (int16_t sCountY = XCurrent; sCountY <= YCurrent; sCountY++) {
+      Paint_DrawPoint(X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+      Paint_DrawPoint(X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+      Paint_DrawPoint(X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+      Paint_DrawPoint(X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+      Paint_DrawPoint(X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+      Paint_DrawPoint(X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+      Paint_DrawPoint(X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+      Paint_DrawPoint(X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+    }
+    if (Esp < 0) {
+      Esp += 4 * XCurrent + 6;
+    } else {
+      Esp += 10 + 4 * (XCurrent - YCurrent);
+      YCurrent--;
+    }
+    XCurrent++;
+  }
+}
+
+static void pointString(UWORD Xstart, UWORD Ystart, const char* pString, sFONT* Font,
+                        UWORD Color_Foreground, UWORD Color_Background) {
+  UWORD RowBytes = Font->Width / 8 + (Font->Width % 8 ? 1 : 0);
+  for (UWORD Xpoint = Xstart; *pString != '\0'; pString++, Xpoint += Font->Width) {
+    const unsigned char* ptr = &Font->table[(*pString - ' ') * Font->Height * RowBytes];
+    for (UWORD Page = 0; Page < Font->Height; Page++) {
+      for (UWORD Column = 0; Column < Font->Width; Column++) {
+        if (ptr[Page * RowBytes + Column / 8] & (0x80 >> (Column % 8))) {
+          Paint_SetPixel(Xpoint + Column, Ystart + Page, Color_Foreground);
+        } else if (Color_Background != FONT_BACKGROUND) {
+          Paint_SetPixel(Xpoint + Column, Ystart + Page, Color_Background);
+        }
+      }
+    }
+  }
+}
+
+static void spanString(UWORD Xstart, UWORD Ystart, const char* pString, sFONT* Font,
+                       UWORD Color_Foreground, UWORD Color_Background) {
+  for (UWORD Xpoint = Xstart; *pString != '\0'; pString++, Xpoint += Font->Width) {
+    Paint_DrawChar(Xpoint, Ystart, *pString, Font, Color_Foreground, Color_Background);
+  }
+}
+
+enum FillCase { FILL_CLEAR, FILL_WINDOW, FILL_RECT, FILL_RECT_WIDE, FILL_CIRCLE,
+                TEXT_OPAQUE, TEXT_TRANSPARENT, FILL_CASES };
+
+static const char* caseNames[FILL_CASES] = {"clear", "clear-window", "rect", "rect-3px", "circle",
+                                            "text", "text-overlay"};
+
+static const char* benchText = "Sat 18 Oct 2026  12:34";
+
+// Shapes are placed relative to the rotated drawing area, with odd offsets so
+// spans start and end mid-byte
+static uint32_t drawCase(FillCase fill, bool spans, UWORD Color) {
+  UWORD W = Paint.Width;
+  UWORD H = Paint.Height;
+  switch (fill) {
+  case FILL_CLEAR:
+    spans ? Paint_Clear(Color) : pointClear(Color);
+    return (uint32_t)W * H;
+  case FILL_WINDOW:
+    spans ? Paint_ClearWindows(13, 7, W - 11, H - 5, Color)
+          : pointClearWindows(13, 7, W - 11, H - 5, Color);
+    return (uint32_t)(W - 24) * (H - 12);
+  case FILL_RECT:
+    spans ? Paint_DrawRectangle(31, 45, W / 2 + 3, H / 2 + 1, Color, DOT_PIXEL_1X1, DRAW_FILL_FULL)
+          : pointRectangle(31, 45, W / 2 + 3, H / 2 + 1, Color, DOT_PIXEL_1X1);
+    return (uint32_t)(W / 2 + 3 - 31) * (H / 2 + 1 - 45);
+  case FILL_RECT_WIDE:
+    spans ? Paint_DrawRectangle(1, 2, W / 3, H / 3, Color, DOT_PIXEL_3X3, DRAW_FILL_FULL)
+          : pointRectangle(1, 2, W / 3, H / 3, Color, DOT_PIXEL_3X3);
+    return (uint32_t)(W / 3 - 1) * (H / 3 - 2);
+  case TEXT_OPAQUE:
+    // Odd start column, so half the glyphs begin mid-byte
+    spans ? spanString(13, 41, benchText, &Font24, Color, 1)
+          : pointString(13, 41, benchText, &Font24, Color, 1);
+    return (uint32_t)strlen(benchText) * Font24.Width * Font24.Height;
+  case TEXT_TRANSPARENT:
+    spans ? spanString(6, H - 40, benchText, &Font16, Color, FONT_BACKGROUND)
+          : pointString(6, H - 40, benchText, &Font16, Color, FONT_BACKGROUND);
+    return (uint32_t)strlen(benchText) * Font16.Width * Font16.Height;
+  case FILL_CIRCLE:
+  default: {
+    // Touches the left edge, where the 1x1 dot offset clips a column
+    UWORD Radius = W / 3;
+    spans ? Paint_DrawCircle(Radius, H / 2, Radius, Color, DOT_PIXEL_1X1, DRAW_FILL_FULL)
+          : pointCircle(Radius, H / 2, Radius, Color);
+    return (uint32_t)(3.14159 * Radius * Radius);
+  }
+  }
+}
+
+struct CaseTotals {
+  uint64_t pointPixels;
+  uint64_t spanPixels;
+  uint64_t pointUs;
+  uint64_t spanUs;
+  int mismatches;
+  int runs;
+};
+
+static UBYTE noise[BENCH_BUFFER_BYTES];
+static UBYTE pointImage[BENCH_BUFFER_BYTES];
+static UBYTE spanImage[BENCH_BUFFER_BYTES];
+
+static void setup(UBYTE* image, UWORD rotate, UBYTE mirror, UBYTE scale) {
+  memcpy(image, noise, BENCH_BUFFER_BYTES);
+  Paint_NewImage(image, BENCH_WIDTH, BENCH_HEIGHT, rotate, WHITE);
+  Paint_SetScale(scale);
+  Paint_SetMirroring(mirror);
+}
+
+// Draws `iterations` times, again and again until BENCH_MIN_US have passed
+// (a clear is a few microseconds). Every case draws the same pixels each
+// time, so the result does not depend on the repeats.
+static uint64_t timeCase(UBYTE* image, UWORD rotate, UBYTE mirror, UBYTE scale,
+                         FillCase fill, bool spans, UWORD Color, int iterations, uint64_t* pixels) {
+  setup(image, rotate, mirror, scale);
+  unsigned long start = micros();
+  unsigned long elapsed;
+  do {
+    for (int i = 0; i < iterations; i++) {
+      *pixels += drawCase(fill, spans, Color);
+    }
+    elapsed = micros() - start;
+  } while (elapsed < BENCH_MIN_US);
+  return elapsed;
+}
+
+int main() {
+  static const UWORD rotations[] = {ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270};
+  static const UBYTE mirrors[] = {MIRROR_NONE, MIRROR_HORIZONTAL, MIRROR_VERTICAL, MIRROR_ORIGIN};
+  static const UBYTE scales[] = {2, 4, 7};
+  const int iterations = 8;
+
+  uint32_t state = 0x2545F491;
+  for (int i = 0; i < BENCH_BUFFER_BYTES; i++) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    noise[i] = (UBYTE)state;
+  }
+
+  printf("GUI_Paint fill/text benchmark: %ux%u, 4 rotations x 4 mirrors, %d draws each (at least %d us)\n",
+         BENCH_WIDTH, BENCH_HEIGHT, iterations, BENCH_MIN_US);
+  printf("%-13s %5s %14s %14s %8s %10s\n", "case", "scale", "points Mpx/s", "spans Mpx/s", "speedup", "identical");
+
+  bool success = true;
+  for (int f = 0; f < FILL_CASES; f++) {
+    for (UBYTE scale : scales) {
+      CaseTotals totals = {};
+      // Colors whose pattern differs from the noise in every pixel width
+      UWORD Color = (scale == 2) ? BLACK : (scale == 4) ? 2 : 5;
+      for (UWORD rotate : rotations) {
+        for (UBYTE mirror : mirrors) {
+          totals.pointUs += timeCase(pointImage, rotate, mirror, scale, (FillCase)f, false, Color, iterations,
+                                     &totals.pointPixels);
+          totals.spanUs += timeCase(spanImage, rotate, mirror, scale, (FillCase)f, true, Color, iterations,
+                                    &totals.spanPixels);
+          totals.runs++;
+          if (memcmp(pointImage, spanImage, BENCH_BUFFER_BYTES) != 0) {
+            printf("  %s differs: scale %u, rotate %u, mirror %u\n",
+                   caseNames[f], scale, rotate, mirror);
+            totals.mismatches++;
+          }
+        }
+      }
+      double pointRate = totals.pointUs ? (double)totals.pointPixels / totals.pointUs : 0.0;
+      double spanRate = totals.spanUs ? (double)totals.spanPixels / totals.spanUs : 0.0;
+      printf("%-13s %5u %14.1f %14.1f %7.1fx %6d/%d\n", caseNames[f], scale, pointRate, spanRate,
+             pointRate > 0 ? spanRate / pointRate : 0.0, totals.runs - totals.mismatches, totals.runs);
+      success = success && totals.mismatches == 0;
+    }
+  }
+  return success ? 0 : 1;
+}
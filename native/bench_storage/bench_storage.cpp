@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * | File      	:   bench_storage.cpp
+ * | Function    :   Host benchmark of FlashStorage on simulated flash
+ * | Info        :   pio run -e native_bench_storage -t exec
+ ******************************************************************************/
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "flash_storage.h"
+
+// Image payload delivered the way HTTPClient hands it over: at most `burst`
+// bytes available at a time (one TCP segment or one TLS record)
+class ImageStream : public Stream {
+public:
+  ImageStream(uint32_t seed, size_t size, size_t burst)
+      : state(seed | 1), remaining(size), burst(burst), burstLeft(0) {}
+
+  int available() override {
+    if (burstLeft == 0) {
+      burstLeft = (remaining < burst) ? remaining : burst;
+    }
+    return (int)burstLeft;
+  }
+
+  int read() override {
+    char c;
+    return readBytes(&c, 1) == 1 ? (uint8_t)c : -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) override {
+    size_t count = (length < (size_t)available()) ? length : burstLeft;
+    for (size_t i = 0; i < count; i++) {
+      // xorshift32 - incompressible data, like dithered pixels
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      buffer[i] = (char)state;
+    }
+    remaining -= count;
+    burstLeft -= count;
+    return count;
+  }
+
+private:
+  uint32_t state;
+  size_t remaining;
+  size_t burst;
+  size_t burstLeft;
+};
+
+struct BenchConfig {
+  const char* name;
+  uint32_t readSize;
+  uint32_t progSize;
+  uint32_t cacheSize;
+  uint32_t lookaheadSize;
+  size_t streamBurst;
+};
+
+// First entry matches the esp_littlefs defaults used on the device
+static const BenchConfig configs[] = {
+  {"default",       128, 128,  512, 128,  1436},
+  {"tls-records",   128, 128,  512, 128, 16384},
+  {"cache-1k",      128, 128, 1024, 128,  1436},
+  {"cache-4k",      128, 128, 4096, 128,  1436},
+  {"prog-256",      256, 256,  512, 128,  1436},
+  {"lookahead-512", 128, 128,  512, 512,  1436},
+};
+
+static void printHeader() {
+  printf("%-14s %-10s %12s %7s %9s %10s %10s %9s\n",
+         "config", "scenario", "programmed", "amp", "erased", "read", "sim ms", "ms/image");
+}
+
+static void report(const BenchConfig& config, const char* scenario, int images, size_t payload) {
+  const SimFlashStats& stats = SimFlash::getStats();
+  double amplification = payload ? (double)stats.bytesProgrammed / payload : 0.0;
+  double simMs = stats.simulatedUs / 1000.0;
+  printf("%-14s %-10s %12llu %6.3fx %9llu %10llu %10.1f %9.1f\n",
+         config.name, scenario,
+         (unsigned long long)stats.bytesProgrammed, amplification,
+         (unsigned long long)stats.sectorsErased,
+         (unsigned long long)stats.bytesRead,
+         simMs, images ? simMs / images : 0.0);
+}
+
+static bool writeSlideshow(const BenchConfig& config, int images, uint32_t seed) {
+  for (int i = 0; i < images; i++) {
+    ImageStream stream(seed + i, IMAGE_SIZE_BYTES, config.streamBurst);
+    if (!FlashStorage::saveImageFromStream(i, &stream, IMAGE_SIZE_BYTES)) {
+      printf("  saveImageFromStream(%d) failed\n", i);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Same access pattern as EPD_4IN0E_DisplayFromFile: available() + read() per byte
+static bool displayRead(int index) {
+  File file = FlashStorage::openImageFile(index);
+  if (!file) return false;
+  size_t total = 0;
+  while (file.available() > 0) {
+    if (file.read() < 0) return false;
+    total++;
+  }
+  file.close();
+  return total == IMAGE_SIZE_BYTES;
+}
+
+static bool runConfig(const BenchConfig& config) {
+  SimFlashGeometry geometry;
+  geometry.readSize = config.readSize;
+  geometry.progSize = config.progSize;
+  geometry.cacheSize = config.cacheSize;
+  geometry.lookaheadSize = config.lookaheadSize;
+  SimFlash::configure(geometry, SimFlashTiming());
+
+  FlashStorage::end();
+  if (!LittleFS.format() || !FlashStorage::begin()) {
+    printf("%-14s mount failed\n", config.name);
+    return false;
+  }
+  int images = FlashStorage::getImageCapacity();
+
+  // Fresh slideshow on an empty partition
+  SimFlash::resetStats();
+  if (!writeSlideshow(config, images, 1)) return false;
+  report(config, "write", images, (size_t)images * IMAGE_SIZE_BYTES);
+
+  // New slideshow replacing every image of a full partition
+  SimFlash::resetStats();
+  if (!writeSlideshow(config, images, 1000)) return false;
+  report(config, "overwrite", images, (size_t)images * IMAGE_SIZE_BYTES);
+
+  // Reordered slideshow: every image kept but moved to a new index
+  SimFlash::resetStats();
+  for (int i = 0; i < images; i++) {
+    if (!FlashStorage::stageImage(i, images - 1 - i)) return false;
+  }
+  for (int i = 0; i < images; i++) {
+    if (!FlashStorage::commitStagedImage(i)) return false;
+  }
+  report(config, "reorder", images, 0);
+
+  // Remount, as on every wake
+  SimFlash::resetStats();
+  FlashStorage::end();
+  if (!FlashStorage::begin()) return false;
+  report(config, "mount", 0, 0);
+
+  // Display path: one full image streamed byte by byte
+  SimFlash::resetStats();
+  for (int i = 0; i < images; i++) {
+    if (!displayRead(i)) return false;
+  }
+  report(config, "display", images, 0);
+
+  return true;
+}
+
+int main() {
+  printf("FlashStorage benchmark: %u-byte images, %u KB partition, %u-byte write chunks\n",
+         (unsigned)IMAGE_SIZE_BYTES, (unsigned)(SimFlashGeometry().blockCount * SimFlashGeometry().blockSize / 1024),
+         (unsigned)FLASH_WRITE_CHUNK_SIZE);
+  printHeader();
+
+  bool success = true;
+  for (const BenchConfig& config : configs) {
+    success = runConfig(config) && success;
+  }
+  return success ? 0 : 1;
+}
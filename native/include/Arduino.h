@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * | File      	:   Arduino.h
+ * | Function    :   Minimal Arduino core for native (host) builds
+ ******************************************************************************/
+#ifndef _NATIVE_ARDUINO_H_
+#define _NATIVE_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <esp_attr.h>
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// GPIO and clock control, implemented by the wake simulator (native/sim)
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define CHANGE 0x03
+#define FALLING 0x02
+#define RISING 0x01
+#define digitalPinToInterrupt(pin) (pin)
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+uint32_t getCpuFrequencyMhz();
+bool setCpuFrequencyMhz(uint32_t mhz);
+uint32_t getXtalFrequencyMhz();
+
+inline bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+// Serial console, written to stdout
+class HardwareSerial {
+public:
+  void begin(unsigned long) {}
+  size_t print(const char* s) { return fputs(s, stdout) < 0 ? 0 : strlen(s); }
+  size_t println(const char* s = "") { return print(s) + print("\n"); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written < 0 ? 0 : (size_t)written;
+  }
+};
+extern HardwareSerial Serial;
+
+// The few String operations the firmware uses on HTTP header values
+class String {
+public:
+  String(const char* s = "") : length_(strlen(s)) {
+    data_ = (char*)malloc(length_ + 1);
+    memcpy(data_, s, length_ + 1);
+  }
+  String(const String& other) : String(other.data_) {}
+  String& operator=(const String& other) {
+    if (this != &other) {
+      free(data_);
+      length_ = other.length_;
+      data_ = (char*)malloc(length_ + 1);
+      memcpy(data_, other.data_, length_ + 1);
+    }
+    return *this;
+  }
+  ~String() { free(data_); }
+
+  unsigned int length() const { return (unsigned int)length_; }
+  const char* c_str() const { return data_; }
+  char operator[](unsigned int index) const { return index < length_ ? data_[index] : '\0'; }
+  long toInt() const { return atol(data_); }
+
+private:
+  char* data_;
+  size_t length_;
+};
+
+// Byte stream interface, same shape as the Arduino core's Stream
+class Stream {
+public:
+  virtual ~Stream() {}
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+
+  virtual size_t readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+      int c = read();
+      if (c < 0) break;
+      buffer[count++] = (char)c;
+    }
+    return count;
+  }
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+  void setTimeout(unsigned long) {}
+};
+
+#endif
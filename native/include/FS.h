@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * | File      	:   FS.h
+ * | Function    :   Arduino-compatible File wrapper for native builds
+ ******************************************************************************/
+#ifndef _NATIVE_FS_H_
+#define _NATIVE_FS_H_
+
+#include <Arduino.h>
+#include <memory>
+
+namespace fs {
+
+// Backend for one open file or directory (see LittleFS.cpp)
+class FileImpl {
+public:
+  virtual ~FileImpl() {}
+  virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+  virtual size_t read(uint8_t* buffer, size_t size) = 0;
+  virtual bool seek(uint32_t pos) = 0;
+  virtual size_t position() const = 0;
+  virtual size_t size() const = 0;
+  virtual void close() = 0;
+  virtual bool isDirectory() const = 0;
+  virtual std::shared_ptr<FileImpl> openNextFile() = 0;
+  virtual const char* name() const = 0;
+};
+
+class File : public Stream {
+public:
+  File() {}
+  explicit File(std::shared_ptr<FileImpl> impl) : impl(impl) {}
+
+  explicit operator bool() const { return impl != nullptr; }
+
+  size_t write(const uint8_t* buffer, size_t size) { return impl ? impl->write(buffer, size) : 0; }
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t read(uint8_t* buffer, size_t size) { return impl ? impl->read(buffer, size) : 0; }
+
+  int available() override { return impl ? (int)(impl->size() - impl->position()) : 0; }
+  int read() override {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  size_t readBytes(char* buffer, size_t length) override { return read((uint8_t*)buffer, length); }
+
+  bool seek(uint32_t pos) { return impl && impl->seek(pos); }
+  size_t position() const { return impl ? impl->position() : 0; }
+  size_t size() const { return impl ? impl->size() : 0; }
+  bool isDirectory() const { return impl && impl->isDirectory(); }
+  const char* name() const { return impl ? impl->name() : ""; }
+
+  void close() {
+    if (impl) {
+      impl->close();
+      impl.reset();
+    }
+  }
+
+  File openNextFile() { return impl ? File(impl->openNextFile()) : File(); }
+
+private:
+  std::shared_ptr<FileImpl> impl;
+};
+
+} // namespace fs
+
+using fs::File;
+
+#endif
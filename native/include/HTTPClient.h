@@ -0,0 +1,62 @@
+/*****************************************************************************
+ * | File      	:   HTTPClient.h
+ * | Function    :   HTTP/1.1 client over the simulated network (wake simulator)
+ ******************************************************************************/
+#ifndef _NATIVE_HTTP_CLIENT_H_
+#define _NATIVE_HTTP_CLIENT_H_
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <string>
+#include <vector>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+// Same calls as the ESP32 core's HTTPClient. Requests go to the stand-in
+// server (sim_server.h); the response body is read from the WiFiClient.
+class HTTPClient {
+public:
+  bool begin(WiFiClient& client, const char* host, uint16_t port, const char* uri = "/", bool https = false);
+  void end();
+
+  void setTimeout(uint16_t timeoutMs) { timeout = timeoutMs; }
+  void setReuse(bool reuse) { this->reuse = reuse; }
+  void useHTTP10(bool useHTTP10 = true);
+  void addHeader(const char* name, const char* value);
+  void collectHeaders(const char* headerKeys[], size_t count);
+
+  int GET();
+  int POST(uint8_t* payload, size_t size);
+
+  int getSize() { return size; }
+  String header(const char* name);
+  bool hasHeader(const char* name);
+  WiFiClient& getStream() { return *client; }
+  WiFiClient* getStreamPtr() { return client; }
+
+private:
+  int sendRequest(const char* method, const uint8_t* payload, size_t payloadSize);
+
+  WiFiClient* client = nullptr;
+  std::string host;
+  std::string uri;
+  std::vector<std::string> requestHeaders;
+  std::vector<std::string> collected;
+  std::vector<std::string> collectedValues;
+  uint16_t timeout = 5000;
+  bool reuse = true;
+  bool http10 = false;
+  int size = -1;
+};
+
+#endif
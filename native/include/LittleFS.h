@@ -0,0 +1,31 @@
+/*****************************************************************************
+ * | File      	:   LittleFS.h
+ * | Function    :   LittleFS on a simulated flash partition (native builds)
+ ******************************************************************************/
+#ifndef _NATIVE_LITTLEFS_H_
+#define _NATIVE_LITTLEFS_H_
+
+#include "FS.h"
+#include "sim_flash.h"
+
+// Same interface as the ESP32 core's LittleFSFS, backed by littlefs running
+// on SimFlash instead of the "storage" partition
+class LittleFSFS {
+public:
+  bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+             uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+  void end();
+  bool format();
+
+  File open(const char* path, const char* mode = "r");
+  bool exists(const char* path);
+  bool remove(const char* path);
+  bool rename(const char* pathFrom, const char* pathTo);
+
+  size_t totalBytes();
+  size_t usedBytes();
+};
+
+extern LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * | File      	:   Preferences.h
+ * | Function    :   NVS key-value store kept across simulated reboots
+ ******************************************************************************/
+#ifndef _NATIVE_PREFERENCES_H_
+#define _NATIVE_PREFERENCES_H_
+
+#include <Arduino.h>
+
+// Arduino Preferences over the simulator's NVS table, which outlives each
+// wake like the nvs partition does. Writes take effect immediately.
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+  void end();
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  size_t putInt(const char* key, int32_t value);
+  size_t putString(const char* key, const char* value);
+  size_t putBytes(const char* key, const void* value, size_t length);
+
+  int32_t getInt(const char* key, int32_t defaultValue = 0);
+  size_t getString(const char* key, char* value, size_t maxLength);
+  size_t getBytesLength(const char* key);
+  size_t getBytes(const char* key, void* buffer, size_t maxLength);
+
+private:
+  char ns[16] = "";
+  bool opened = false;
+  bool readOnly = false;
+};
+
+#endif
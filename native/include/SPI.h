@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * | File      	:   SPI.h
+ * | Function    :   Stand-in for the Arduino SPI library in native builds
+ ******************************************************************************/
+#ifndef _NATIVE_SPI_H_
+#define _NATIVE_SPI_H_
+
+#include <Arduino.h>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0x00
+
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+      : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+  uint32_t clock;
+  uint8_t bitOrder;
+  uint8_t dataMode;
+};
+
+// Only the wake simulator implements it: bytes go to the simulated panel
+// and take their time on the bus at the transaction's clock
+class SPIClass {
+public:
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1);
+  void end();
+  void beginTransaction(SPISettings settings);
+  void endTransaction();
+  uint8_t transfer(uint8_t data);
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,10 @@
+/*****************************************************************************
+ * | File      	:   Stream.h
+ * | Function    :   Arduino Stream header for native builds (see Arduino.h)
+ ******************************************************************************/
+#ifndef _NATIVE_STREAM_H_
+#define _NATIVE_STREAM_H_
+
+#include <Arduino.h>
+
+#endif
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * | File      	:   WiFi.h
+ * | Function    :   Simulated WiFi station (wake simulator, see native/sim)
+ ******************************************************************************/
+#ifndef _NATIVE_WIFI_H_
+#define _NATIVE_WIFI_H_
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+#include "WiFiClient.h"
+
+class IPAddress {
+public:
+  IPAddress() { address.dword = 0; }
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    address.bytes[0] = a;
+    address.bytes[1] = b;
+    address.bytes[2] = c;
+    address.bytes[3] = d;
+  }
+  IPAddress(uint32_t dword) { address.dword = dword; }
+
+  // Network byte order packed into a word, first octet in the low byte
+  operator uint32_t() const { return address.dword; }
+  IPAddress& operator=(uint32_t dword) {
+    address.dword = dword;
+    return *this;
+  }
+  uint8_t operator[](int index) const { return address.bytes[index]; }
+
+private:
+  union {
+    uint8_t bytes[4];
+    uint32_t dword;
+  } address;
+};
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum {
+  WIFI_MODE_NULL = 0,
+  WIFI_MODE_STA,
+} wifi_mode_t;
+#define WIFI_OFF WIFI_MODE_NULL
+#define WIFI_STA WIFI_MODE_STA
+
+typedef enum {
+  ARDUINO_EVENT_WIFI_STA_CONNECTED,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP,
+} arduino_event_id_t;
+
+typedef struct {
+  uint8_t reason;
+} wifi_event_sta_disconnected_t;
+
+typedef union {
+  wifi_event_sta_disconnected_t wifi_sta_disconnected;
+} arduino_event_info_t;
+
+typedef void (*WiFiEventFuncCb)(arduino_event_id_t event, arduino_event_info_t info);
+
+// Connects against the AP described by SimWiFiModel (sim.h). Connect
+// progress is reported through onEvent() callbacks at simulated times.
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t mode);
+  wifi_mode_t getMode();
+  bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(),
+              IPAddress dns2 = IPAddress());
+  wl_status_t begin(const char* ssid, const char* password = nullptr, int32_t channel = 0,
+                    const uint8_t* bssid = nullptr, bool connect = true);
+  bool setAutoReconnect(bool autoReconnect);
+  bool persistent(bool persistent);
+  int onEvent(WiFiEventFuncCb callback);
+  wl_status_t status();
+  bool disconnect(bool wifiOff = false);
+
+  IPAddress localIP();
+  IPAddress gatewayIP();
+  IPAddress subnetMask();
+  IPAddress dnsIP(uint8_t index = 0);
+  int8_t RSSI();
+  uint8_t* macAddress(uint8_t* mac);
+};
+
+extern WiFiClass WiFi;
+
+#endif
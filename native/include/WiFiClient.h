@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * | File      	:   WiFiClient.h
+ * | Function    :   Simulated TCP/TLS connection to the stand-in server
+ ******************************************************************************/
+#ifndef _NATIVE_WIFI_CLIENT_H_
+#define _NATIVE_WIFI_CLIENT_H_
+
+#include <Arduino.h>
+#include <memory>
+
+struct SimConnection;
+
+// A connection is opened by HTTPClient on the first request to a host and
+// kept for the next one if the response allows. The response body arrives
+// over simulated time at the network model's bandwidth: available() counts
+// what has arrived, reads wait for the rest up to the timeout.
+class WiFiClient : public Stream {
+public:
+  WiFiClient();
+  virtual ~WiFiClient();
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char* buffer, size_t length) override;
+  using Stream::readBytes;
+
+  void setTimeout(unsigned long ms) { timeoutMs = ms; }
+  uint8_t connected();
+  void stop();
+
+  // For HTTPClient: the open connection, or nullptr
+  std::shared_ptr<SimConnection>& connection() { return conn; }
+  bool isSecure() const { return secure; }
+  unsigned long getTimeout() const { return timeoutMs; }
+
+protected:
+  bool secure = false;
+
+private:
+  std::shared_ptr<SimConnection> conn;
+  unsigned long timeoutMs = 3000;
+};
+
+#endif
@@ -0,0 +1,16 @@
+/*****************************************************************************
+ * | File      	:   WiFiClientSecure.h
+ * | Function    :   Simulated TLS client (handshake cost per new connection)
+ ******************************************************************************/
+#ifndef _NATIVE_WIFI_CLIENT_SECURE_H_
+#define _NATIVE_WIFI_CLIENT_SECURE_H_
+
+#include <WiFi.h>
+
+class WiFiClientSecure : public WiFiClient {
+public:
+  WiFiClientSecure() { secure = true; }
+  void setInsecure() {}
+};
+
+#endif
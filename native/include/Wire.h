@@ -0,0 +1,11 @@
+/*****************************************************************************
+ * | File      	:   Wire.h
+ * | Function    :   Stand-in for the Arduino Wire library in native builds
+ ******************************************************************************/
+#ifndef _NATIVE_WIRE_H_
+#define _NATIVE_WIRE_H_
+
+// Only pulled in by Debug.h for Serial, which lives in the native Arduino.h
+#include <Arduino.h>
+
+#endif
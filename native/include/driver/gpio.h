@@ -0,0 +1,25 @@
+/*****************************************************************************
+ * | File      	:   gpio.h
+ * | Function    :   Stand-in for the ESP-IDF GPIO driver (wake simulator)
+ ******************************************************************************/
+#ifndef _NATIVE_DRIVER_GPIO_H_
+#define _NATIVE_DRIVER_GPIO_H_
+
+#include <esp_err.h>
+
+typedef int gpio_num_t;
+
+typedef enum {
+  GPIO_INTR_DISABLE = 0,
+  GPIO_INTR_POSEDGE = 1,
+  GPIO_INTR_NEGEDGE = 2,
+  GPIO_INTR_ANYEDGE = 3,
+  GPIO_INTR_LOW_LEVEL = 4,
+  GPIO_INTR_HIGH_LEVEL = 5,
+} gpio_int_type_t;
+
+int gpio_get_level(gpio_num_t gpio_num);
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type);
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num);
+
+#endif
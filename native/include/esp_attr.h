@@ -0,0 +1,15 @@
+/*****************************************************************************
+ * | File      	:   esp_attr.h
+ * | Function    :   Stand-in for the ESP-IDF memory placement attributes
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_ATTR_H_
+#define _NATIVE_ESP_ATTR_H_
+
+// RTC slow memory is one linker section; the wake simulator keeps it across
+// simulated deep sleeps (__start_rtc_data/__stop_rtc_data) and clears it on
+// power loss
+#define RTC_DATA_ATTR __attribute__((section("rtc_data")))
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#endif
@@ -0,0 +1,18 @@
+/*****************************************************************************
+ * | File      	:   esp_err.h
+ * | Function    :   Stand-in for the ESP-IDF error codes
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_ERR_H_
+#define _NATIVE_ESP_ERR_H_
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_WIFI_NOT_CONNECT 0x300A
+
+#endif
@@ -0,0 +1,19 @@
+/*****************************************************************************
+ * | File      	:   esp_mac.h
+ * | Function    :   Stand-in for the ESP-IDF MAC address API
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_MAC_H_
+#define _NATIVE_ESP_MAC_H_
+
+#include <esp_err.h>
+
+typedef enum {
+  ESP_MAC_WIFI_STA,
+  ESP_MAC_WIFI_SOFTAP,
+  ESP_MAC_BT,
+  ESP_MAC_ETH,
+} esp_mac_type_t;
+
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type);
+
+#endif
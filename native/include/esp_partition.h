@@ -0,0 +1,33 @@
+/*****************************************************************************
+ * | File      	:   esp_partition.h
+ * | Function    :   Stand-in for the ESP-IDF partition table API
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_PARTITION_H_
+#define _NATIVE_ESP_PARTITION_H_
+
+#include <stdint.h>
+
+typedef enum {
+  ESP_PARTITION_TYPE_APP = 0x00,
+  ESP_PARTITION_TYPE_DATA = 0x01,
+} esp_partition_type_t;
+
+typedef enum {
+  ESP_PARTITION_SUBTYPE_DATA_NVS = 0x02,
+  ESP_PARTITION_SUBTYPE_DATA_LITTLEFS = 0x83,
+  ESP_PARTITION_SUBTYPE_ANY = 0xff,
+} esp_partition_subtype_t;
+
+typedef struct {
+  esp_partition_type_t type;
+  esp_partition_subtype_t subtype;
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+} esp_partition_t;
+
+// The partitions of partitions.csv, nullptr for anything else
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label);
+
+#endif
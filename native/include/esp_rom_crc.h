@@ -0,0 +1,22 @@
+/*****************************************************************************
+ * | File      	:   esp_rom_crc.h
+ * | Function    :   CRC-32 of the ESP32 ROM, for native builds
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_ROM_CRC_H_
+#define _NATIVE_ESP_ROM_CRC_H_
+
+#include <stdint.h>
+
+// Same result as the ROM function: reflected CRC-32 (zlib), crc = 0 to start
+inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *buf++;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+#endif
@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * | File      	:   esp_sleep.h
+ * | Function    :   Stand-in for the ESP-IDF sleep API (wake simulator)
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_SLEEP_H_
+#define _NATIVE_ESP_SLEEP_H_
+
+#include <esp_err.h>
+
+typedef enum {
+  ESP_SLEEP_WAKEUP_UNDEFINED,
+  ESP_SLEEP_WAKEUP_ALL,
+  ESP_SLEEP_WAKEUP_EXT0,
+  ESP_SLEEP_WAKEUP_EXT1,
+  ESP_SLEEP_WAKEUP_TIMER,
+  ESP_SLEEP_WAKEUP_TOUCHPAD,
+  ESP_SLEEP_WAKEUP_ULP,
+  ESP_SLEEP_WAKEUP_GPIO,
+} esp_sleep_wakeup_cause_t;
+
+typedef enum {
+  ESP_GPIO_WAKEUP_GPIO_LOW = 0,
+  ESP_GPIO_WAKEUP_GPIO_HIGH = 1,
+} esp_deepsleep_gpio_wake_up_mode_t;
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause();
+uint64_t esp_sleep_get_gpio_wakeup_status();
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us);
+esp_err_t esp_sleep_enable_gpio_wakeup();
+esp_err_t esp_deep_sleep_enable_gpio_wakeup(uint64_t gpio_pin_mask, esp_deepsleep_gpio_wake_up_mode_t mode);
+
+// Advances the clock to the wake-up; GPIO wake-ups on the panel BUSY line
+// fire when the simulated panel releases it
+esp_err_t esp_light_sleep_start();
+
+// Ends the simulated wake - RTC memory, flash and NVS are kept for the next
+[[noreturn]] void esp_deep_sleep_start();
+
+#endif
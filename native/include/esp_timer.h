@@ -0,0 +1,13 @@
+/*****************************************************************************
+ * | File      	:   esp_timer.h
+ * | Function    :   Stand-in for the ESP-IDF high resolution timer
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_TIMER_H_
+#define _NATIVE_ESP_TIMER_H_
+
+#include <stdint.h>
+
+// Microseconds since boot
+int64_t esp_timer_get_time();
+
+#endif
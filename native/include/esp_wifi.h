@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * | File      	:   esp_wifi.h
+ * | Function    :   Stand-in for the ESP-IDF WiFi driver API (wake simulator)
+ ******************************************************************************/
+#ifndef _NATIVE_ESP_WIFI_H_
+#define _NATIVE_ESP_WIFI_H_
+
+#include <esp_err.h>
+
+typedef enum {
+  WIFI_IF_STA = 0,
+  WIFI_IF_AP = 1,
+} wifi_interface_t;
+
+typedef enum {
+  WIFI_PS_NONE,
+  WIFI_PS_MIN_MODEM,
+  WIFI_PS_MAX_MODEM,
+} wifi_ps_type_t;
+
+typedef enum {
+  WIFI_REASON_UNSPECIFIED = 1,
+  WIFI_REASON_AUTH_EXPIRE = 2,
+  WIFI_REASON_AUTH_LEAVE = 3,
+  WIFI_REASON_ASSOC_EXPIRE = 4,
+  WIFI_REASON_ASSOC_TOOMANY = 5,
+  WIFI_REASON_NOT_AUTHED = 6,
+  WIFI_REASON_NOT_ASSOCED = 7,
+  WIFI_REASON_ASSOC_LEAVE = 8,
+  WIFI_REASON_MIC_FAILURE = 14,
+  WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT = 15,
+  WIFI_REASON_BEACON_TIMEOUT = 200,
+  WIFI_REASON_NO_AP_FOUND = 201,
+  WIFI_REASON_AUTH_FAIL = 202,
+  WIFI_REASON_ASSOC_FAIL = 203,
+  WIFI_REASON_HANDSHAKE_TIMEOUT = 204,
+  WIFI_REASON_CONNECTION_FAIL = 205,
+} wifi_err_reason_t;
+
+typedef struct {
+  uint8_t ssid[32];
+  uint8_t password[64];
+  uint8_t channel;
+  bool bssid_set;
+  uint8_t bssid[6];
+} wifi_sta_config_t;
+
+typedef union {
+  wifi_sta_config_t sta;
+} wifi_config_t;
+
+typedef struct {
+  uint8_t bssid[6];
+  uint8_t ssid[33];
+  uint8_t primary;
+  int8_t rssi;
+} wifi_ap_record_t;
+
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t type);
+// The station config the driver keeps in NVS (written by WiFi.begin() when persistent)
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* config);
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* info);
+
+#endif
@@ -0,0 +1,21 @@
+/*****************************************************************************
+ * | File      	:   event_groups.h
+ * | Function    :   Stand-in for FreeRTOS event groups (wake simulator)
+ ******************************************************************************/
+#ifndef _NATIVE_FREERTOS_EVENT_GROUPS_H_
+#define _NATIVE_FREERTOS_EVENT_GROUPS_H_
+
+#include "FreeRTOS.h"
+
+typedef uint32_t EventBits_t;
+typedef struct SimEventGroup* EventGroupHandle_t;
+
+EventGroupHandle_t xEventGroupCreate();
+// From a background task the bits are set at that task's time
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits);
+// Advances the clock, firing due events, until the bits are set or the timeout
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t waitForAll, TickType_t ticksToWait);
+
+#endif
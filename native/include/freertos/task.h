@@ -0,0 +1,23 @@
+/*****************************************************************************
+ * | File      	:   task.h
+ * | Function    :   Stand-in for FreeRTOS tasks (wake simulator)
+ ******************************************************************************/
+#ifndef _NATIVE_FREERTOS_TASK_H_
+#define _NATIVE_FREERTOS_TASK_H_
+
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+// A new task runs to completion right away on a timeline of its own that
+// starts at the creator's time (see SimClock::runBackground)
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth, void* parameters,
+                       UBaseType_t priority, TaskHandle_t* createdTask);
+// Tasks end by returning after it
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+
+#endif
@@ -0,0 +1,24 @@
+/*****************************************************************************
+ * | File      	:   sha256.h
+ * | Function    :   mbedtls SHA-256 API for native builds (native/sim/sha256.cpp)
+ ******************************************************************************/
+#ifndef _NATIVE_MBEDTLS_SHA256_H_
+#define _NATIVE_MBEDTLS_SHA256_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct {
+  uint32_t state[8];
+  uint64_t total;        // Bytes hashed so far
+  uint8_t buffer[64];    // Partial block
+} mbedtls_sha256_context;
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx);
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx);
+// is224 must be 0, SHA-224 is not implemented
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int is224);
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t length);
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char output[32]);
+
+#endif
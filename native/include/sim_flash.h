@@ -0,0 +1,65 @@
+/*****************************************************************************
+ * | File      	:   sim_flash.h
+ * | Function    :   RAM-backed SPI NOR flash model with erase/program costs
+ ******************************************************************************/
+#ifndef _SIM_FLASH_H_
+#define _SIM_FLASH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Partition layout and the littlefs parameters used to mount it. Defaults
+// match partitions.csv and the esp_littlefs component defaults.
+struct SimFlashGeometry {
+  uint32_t blockSize = 4096;       // Erase unit (one NOR sector)
+  uint32_t blockCount = 0x170000 / 4096;
+  uint32_t readSize = 128;
+  uint32_t progSize = 128;
+  uint32_t cacheSize = 512;
+  uint32_t lookaheadSize = 128;
+  int32_t blockCycles = 512;
+};
+
+// Typical datasheet numbers for the 25Q-series parts on ESP32-C3/C6 modules
+struct SimFlashTiming {
+  double sectorEraseUs = 45000;    // 4 KB sector erase
+  double pageProgramUs = 400;      // One 256-byte page program
+  uint32_t pageSize = 256;
+  double readUsPerByte = 0.05;     // ~20 MB/s, 80 MHz DIO
+  double commandUs = 2;            // Command + address phase of every access
+};
+
+struct SimFlashStats {
+  uint64_t bytesRead;
+  uint64_t bytesProgrammed;
+  uint64_t pagesProgrammed;
+  uint64_t sectorsErased;
+  uint64_t readOps;
+  uint64_t progOps;
+  uint64_t syncOps;
+  double simulatedUs;              // Time the flash chip would have been busy
+};
+
+class SimFlash {
+public:
+  // Reallocate the partition (all bytes erased) and reset the stats
+  static void configure(const SimFlashGeometry& geometry, const SimFlashTiming& timing);
+
+  static const SimFlashGeometry& getGeometry();
+  static const SimFlashTiming& getTiming();
+  static const SimFlashStats& getStats();
+  static void resetStats();
+
+  // The partition contents, e.g. to keep them across simulated reboots
+  static uint8_t* data();
+  static size_t size();
+
+  // Block device operations; return 0 or a negative littlefs error code.
+  // Programming only clears bits, like real NOR - an unerased write fails.
+  static int read(uint32_t block, uint32_t offset, void* buffer, uint32_t size);
+  static int prog(uint32_t block, uint32_t offset, const void* buffer, uint32_t size);
+  static int erase(uint32_t block);
+  static int sync();
+};
+
+#endif
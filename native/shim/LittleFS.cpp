@@ -0,0 +1,210 @@
+#include <LittleFS.h>
+#include <lfs.h>
+#include <vector>
+
+LittleFSFS LittleFS;
+
+static lfs_t lfs;
+static lfs_config config;
+static bool mounted = false;
+static std::vector<uint8_t> readBuffer;
+static std::vector<uint8_t> progBuffer;
+static std::vector<uint8_t> lookaheadBuffer;
+
+static int bdRead(const lfs_config*, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size) {
+  return SimFlash::read(block, off, buffer, size);
+}
+
+static int bdProg(const lfs_config*, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size) {
+  return SimFlash::prog(block, off, buffer, size);
+}
+
+static int bdErase(const lfs_config*, lfs_block_t block) {
+  return SimFlash::erase(block);
+}
+
+static int bdSync(const lfs_config*) {
+  return SimFlash::sync();
+}
+
+static void setupConfig() {
+  const SimFlashGeometry& geometry = SimFlash::getGeometry();
+  memset(&config, 0, sizeof(config));
+  config.read = bdRead;
+  config.prog = bdProg;
+  config.erase = bdErase;
+  config.sync = bdSync;
+  config.read_size = geometry.readSize;
+  config.prog_size = geometry.progSize;
+  config.block_size = geometry.blockSize;
+  config.block_count = geometry.blockCount;
+  config.block_cycles = geometry.blockCycles;
+  config.cache_size = geometry.cacheSize;
+  config.lookahead_size = geometry.lookaheadSize;
+
+  readBuffer.assign(geometry.cacheSize, 0);
+  progBuffer.assign(geometry.cacheSize, 0);
+  lookaheadBuffer.assign(geometry.lookaheadSize, 0);
+  config.read_buffer = readBuffer.data();
+  config.prog_buffer = progBuffer.data();
+  config.lookahead_buffer = lookaheadBuffer.data();
+}
+
+// Strip the VFS base path if a caller passes one
+static const char* lfsPath(const char* path) {
+  if (strncmp(path, "/littlefs", 9) == 0) {
+    path += 9;
+  }
+  return (*path == '\0') ? "/" : path;
+}
+
+class LfsFileImpl : public fs::FileImpl {
+public:
+  LfsFileImpl(const char* path) {
+    snprintf(fileName, sizeof(fileName), "%s", path);
+  }
+
+  ~LfsFileImpl() override { close(); }
+
+  bool openFile(int flags) {
+    open = lfs_file_open(&lfs, &file, fileName, flags) == 0;
+    return open;
+  }
+
+  bool openDir() {
+    open = lfs_dir_open(&lfs, &dir, fileName) == 0;
+    directory = open;
+    return open;
+  }
+
+  size_t write(const uint8_t* buffer, size_t size) override {
+    if (!open || directory) return 0;
+    lfs_ssize_t written = lfs_file_write(&lfs, &file, buffer, size);
+    return written < 0 ? 0 : (size_t)written;
+  }
+
+  size_t read(uint8_t* buffer, size_t size) override {
+    if (!open || directory) return 0;
+    lfs_ssize_t count = lfs_file_read(&lfs, &file, buffer, size);
+    return count < 0 ? 0 : (size_t)count;
+  }
+
+  bool seek(uint32_t pos) override {
+    if (!open || directory) return false;
+    return lfs_file_seek(&lfs, &file, pos, LFS_SEEK_SET) >= 0;
+  }
+
+  size_t position() const override {
+    return (open && !directory) ? (size_t)lfs_file_tell(&lfs, (lfs_file_t*)&file) : 0;
+  }
+
+  size_t size() const override {
+    return (open && !directory) ? (size_t)lfs_file_size(&lfs, (lfs_file_t*)&file) : 0;
+  }
+
+  void close() override {
+    if (!open) return;
+    if (directory) {
+      lfs_dir_close(&lfs, &dir);
+    } else {
+      lfs_file_close(&lfs, &file);
+    }
+    open = false;
+  }
+
+  bool isDirectory() const override { return directory; }
+
+  std::shared_ptr<fs::FileImpl> openNextFile() override {
+    if (!open || !directory) return nullptr;
+    lfs_info info;
+    while (lfs_dir_read(&lfs, &dir, &info) > 0) {
+      if (strcmp(info.name, ".") == 0 || strcmp(info.name, "..") == 0) continue;
+      char path[LFS_NAME_MAX + 2];
+      snprintf(path, sizeof(path), "/%s", info.name);
+      auto next = std::make_shared<LfsFileImpl>(path);
+      bool opened = (info.type == LFS_TYPE_DIR) ? next->openDir() : next->openFile(LFS_O_RDONLY);
+      if (opened) return next;
+    }
+    return nullptr;
+  }
+
+  const char* name() const override { return fileName; }
+
+private:
+  char fileName[LFS_NAME_MAX + 2];
+  lfs_file_t file;
+  lfs_dir_t dir;
+  bool open = false;
+  bool directory = false;
+};
+
+bool LittleFSFS::begin(bool formatOnFail, const char*, uint8_t, const char*) {
+  if (mounted) return true;
+  setupConfig();
+  if (lfs_mount(&lfs, &config) != 0) {
+    if (!formatOnFail || lfs_format(&lfs, &config) != 0 || lfs_mount(&lfs, &config) != 0) {
+      return false;
+    }
+  }
+  mounted = true;
+  return true;
+}
+
+void LittleFSFS::end() {
+  if (mounted) {
+    lfs_unmount(&lfs);
+    mounted = false;
+  }
+}
+
+bool LittleFSFS::format() {
+  end();
+  setupConfig();
+  return lfs_format(&lfs, &config) == 0;
+}
+
+File LittleFSFS::open(const char* path, const char* mode) {
+  if (!mounted) return File();
+  path = lfsPath(path);
+
+  lfs_info info;
+  if (lfs_stat(&lfs, path, &info) == 0 && info.type == LFS_TYPE_DIR) {
+    auto dir = std::make_shared<LfsFileImpl>(path);
+    return dir->openDir() ? File(dir) : File();
+  }
+
+  int flags = LFS_O_RDONLY;
+  if (strcmp(mode, "w") == 0) {
+    flags = LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC;
+  } else if (strcmp(mode, "a") == 0) {
+    flags = LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND;
+  } else if (strcmp(mode, "r+") == 0) {
+    flags = LFS_O_RDWR;
+  }
+  auto file = std::make_shared<LfsFileImpl>(path);
+  return file->openFile(flags) ? File(file) : File();
+}
+
+bool LittleFSFS::exists(const char* path) {
+  if (!mounted) return false;
+  lfs_info info;
+  return lfs_stat(&lfs, lfsPath(path), &info) == 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+  return mounted && lfs_remove(&lfs, lfsPath(path)) == 0;
+}
+
+bool LittleFSFS::rename(const char* pathFrom, const char* pathTo) {
+  return mounted && lfs_rename(&lfs, lfsPath(pathFrom), lfsPath(pathTo)) == 0;
+}
+
+size_t LittleFSFS::totalBytes() {
+  return (size_t)config.block_size * config.block_count;
+}
+
+size_t LittleFSFS::usedBytes() {
+  if (!mounted) return 0;
+  lfs_ssize_t blocks = lfs_fs_size(&lfs);
+  return blocks < 0 ? 0 : (size_t)blocks * config.block_size;
+}
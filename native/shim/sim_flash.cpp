@@ -0,0 +1,87 @@
+#include "sim_flash.h"
+#include <lfs.h>
+#include <string.h>
+#include <vector>
+
+static SimFlashGeometry geometry;
+static SimFlashTiming timing;
+static SimFlashStats stats;
+static std::vector<uint8_t> flash;
+
+void SimFlash::configure(const SimFlashGeometry& newGeometry, const SimFlashTiming& newTiming) {
+  geometry = newGeometry;
+  timing = newTiming;
+  flash.assign((size_t)geometry.blockSize * geometry.blockCount, 0xFF);
+  resetStats();
+}
+
+const SimFlashGeometry& SimFlash::getGeometry() {
+  return geometry;
+}
+
+const SimFlashTiming& SimFlash::getTiming() {
+  return timing;
+}
+
+const SimFlashStats& SimFlash::getStats() {
+  return stats;
+}
+
+void SimFlash::resetStats() {
+  memset(&stats, 0, sizeof(stats));
+}
+
+uint8_t* SimFlash::data() {
+  return flash.data();
+}
+
+size_t SimFlash::size() {
+  return flash.size();
+}
+
+static bool inRange(uint32_t block, uint32_t offset, uint32_t size) {
+  return block < geometry.blockCount && (uint64_t)offset + size <= geometry.blockSize;
+}
+
+int SimFlash::read(uint32_t block, uint32_t offset, void* buffer, uint32_t size) {
+  if (!inRange(block, offset, size)) return LFS_ERR_IO;
+  memcpy(buffer, &flash[(size_t)block * geometry.blockSize + offset], size);
+  stats.readOps++;
+  stats.bytesRead += size;
+  stats.simulatedUs += timing.commandUs + size * timing.readUsPerByte;
+  return 0;
+}
+
+int SimFlash::prog(uint32_t block, uint32_t offset, const void* buffer, uint32_t size) {
+  if (!inRange(block, offset, size)) return LFS_ERR_IO;
+  uint8_t* dst = &flash[(size_t)block * geometry.blockSize + offset];
+  const uint8_t* src = (const uint8_t*)buffer;
+  for (uint32_t i = 0; i < size; i++) {
+    // NOR can only turn 1s into 0s; anything else means a missing erase
+    if ((dst[i] & src[i]) != src[i]) return LFS_ERR_CORRUPT;
+    dst[i] = src[i];
+  }
+
+  // Each touched page costs a full page program cycle
+  uint32_t firstPage = offset / timing.pageSize;
+  uint32_t lastPage = (offset + size - 1) / timing.pageSize;
+  uint32_t pages = lastPage - firstPage + 1;
+  stats.progOps++;
+  stats.bytesProgrammed += size;
+  stats.pagesProgrammed += pages;
+  stats.simulatedUs += pages * (timing.commandUs + timing.pageProgramUs);
+  return 0;
+}
+
+int SimFlash::erase(uint32_t block) {
+  if (block >= geometry.blockCount) return LFS_ERR_IO;
+  memset(&flash[(size_t)block * geometry.blockSize], 0xFF, geometry.blockSize);
+  stats.sectorsErased++;
+  stats.simulatedUs += timing.commandUs + timing.sectorEraseUs;
+  return 0;
+}
+
+int SimFlash::sync() {
+  stats.syncOps++;
+  return 0;
+}
@@ -0,0 +1,83 @@
+// Arduino core, system time and GPIO on the simulated clock
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+#include <sys/time.h>
+#include <time.h>
+#include "sim.h"
+
+HardwareSerial Serial;
+
+static uint32_t cpuMhz = 160;
+
+unsigned long millis() {
+  return (unsigned long)(SimClock::now() / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)SimClock::now();
+}
+
+void delay(unsigned long ms) {
+  SimClock::advance((int64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  SimClock::advance(us);
+}
+
+int64_t esp_timer_get_time() {
+  return SimClock::now();
+}
+
+uint32_t getCpuFrequencyMhz() {
+  return cpuMhz;
+}
+
+bool setCpuFrequencyMhz(uint32_t mhz) {
+  cpuMhz = mhz;
+  return true;
+}
+
+uint32_t getXtalFrequencyMhz() {
+  return 40;
+}
+
+// Pins outside the panel read high: the button (pulled up) is never pressed
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  SimPanel::pinWrite(pin, value);
+}
+
+int digitalRead(uint8_t pin) {
+  return (pin == EPD_BUSY_PIN) ? SimPanel::busyLevel() : HIGH;
+}
+
+int gpio_get_level(gpio_num_t pin) {
+  return digitalRead((uint8_t)pin);
+}
+
+void attachInterrupt(uint8_t, void (*)(void), int) {}
+
+void detachInterrupt(uint8_t) {}
+
+// time(), gettimeofday() and settimeofday() are linked with
+// -Wl,--wrap so the firmware reads the simulated device clock
+extern "C" time_t __wrap_time(time_t* t) {
+  time_t seconds = (time_t)(SimDevice::deviceTimeUs() / 1000000);
+  if (t) *t = seconds;
+  return seconds;
+}
+
+extern "C" int __wrap_gettimeofday(struct timeval* tv, void*) {
+  int64_t us = SimDevice::deviceTimeUs();
+  tv->tv_sec = (time_t)(us / 1000000);
+  tv->tv_usec = (suseconds_t)(us % 1000000);
+  return 0;
+}
+
+extern "C" int __wrap_settimeofday(const struct timeval* tv, const void*) {
+  SimDevice::setDeviceTimeUs((int64_t)tv->tv_sec * 1000000 + tv->tv_usec);
+  return 0;
+}
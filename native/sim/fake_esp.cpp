@@ -0,0 +1,182 @@
+// ESP-IDF sleep, partition, MAC and FreeRTOS calls on the simulated clock
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_sleep.h>
+#include <esp_partition.h>
+#include <esp_mac.h>
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
+#include "sim.h"
+
+#define SIM_LIGHT_SLEEP_IDLE_US 1000  // Light sleep with nothing to wake it
+
+/****************************************************************************
+ * Sleep
+ ****************************************************************************/
+
+static bool causeSet = false;
+static esp_sleep_wakeup_cause_t lastCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+static uint64_t timerWakeUs = 0;
+static bool gpioWake = false;
+static bool busyWake = false;
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+  return causeSet ? lastCause : SimDevice::bootCause();
+}
+
+// The button is never pressed
+uint64_t esp_sleep_get_gpio_wakeup_status() {
+  return 0;
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us) {
+  timerWakeUs = time_in_us;
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup() {
+  gpioWake = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_deep_sleep_enable_gpio_wakeup(uint64_t, esp_deepsleep_gpio_wake_up_mode_t) {
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type) {
+  if (gpio_num == EPD_BUSY_PIN && intr_type == GPIO_INTR_HIGH_LEVEL) busyWake = true;
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num) {
+  if (gpio_num == EPD_BUSY_PIN) busyWake = false;
+  return ESP_OK;
+}
+
+esp_err_t esp_light_sleep_start() {
+  causeSet = true;
+  int64_t now = SimClock::now();
+  int64_t busyRelease = SimPanel::busyReleaseUs();
+  int64_t timerAt = timerWakeUs ? now + (int64_t)timerWakeUs : INT64_MAX;
+
+  if (gpioWake && busyWake && busyRelease > now && busyRelease <= timerAt) {
+    SimClock::advanceTo(busyRelease);
+    lastCause = ESP_SLEEP_WAKEUP_GPIO;
+  } else if (gpioWake && busyWake && busyRelease == 0) {
+    lastCause = ESP_SLEEP_WAKEUP_GPIO;
+  } else if (timerWakeUs) {
+    SimClock::advanceTo(timerAt);
+    lastCause = ESP_SLEEP_WAKEUP_TIMER;
+  } else {
+    SimClock::advance(SIM_LIGHT_SLEEP_IDLE_US);
+    lastCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+  }
+  return ESP_OK;
+}
+
+void esp_deep_sleep_start() {
+  SimDevice::stats().radioOnAtSleep = WiFi.getMode() != WIFI_MODE_NULL;
+  SimDevice::deepSleep(timerWakeUs);
+}
+
+/****************************************************************************
+ * Partitions and MAC
+ ****************************************************************************/
+
+// partitions.csv
+static const esp_partition_t partitions[] = {
+    {ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS, 0x9000, 0x6000, "nvs"},
+    {ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_LITTLEFS, 0x290000, 0x170000, "storage"},
+};
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+  for (const esp_partition_t& partition : partitions) {
+    if (partition.type != type) continue;
+    if (subtype != ESP_PARTITION_SUBTYPE_ANY && partition.subtype != subtype) continue;
+    if (label && strcmp(partition.label, label) != 0) continue;
+    return &partition;
+  }
+  return nullptr;
+}
+
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type) {
+  static const uint8_t base[6] = {0x58, 0xcf, 0x79, 0xa1, 0x2b, 0x3c};
+  memcpy(mac, base, sizeof(base));
+  if (type != ESP_MAC_WIFI_STA) mac[5] += (uint8_t)type;
+  return ESP_OK;
+}
+
+/****************************************************************************
+ * FreeRTOS
+ ****************************************************************************/
+
+static int loopTask;
+static int backgroundTask;
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char*, uint32_t, void* parameters, UBaseType_t,
+                       TaskHandle_t* createdTask) {
+  if (createdTask) *createdTask = &backgroundTask;
+  SimClock::runBackground([task, parameters]() { task(parameters); });
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t) {}
+
+void vTaskDelay(TickType_t ticks) {
+  SimClock::advance((int64_t)ticks * portTICK_PERIOD_MS * 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return SimClock::inBackground() ? (TaskHandle_t)&backgroundTask : (TaskHandle_t)&loopTask;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t) {
+  return 1;
+}
+
+struct SimEventGroup {
+  EventBits_t bits;
+};
+
+EventGroupHandle_t xEventGroupCreate() {
+  return new SimEventGroup{0};
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+  if (SimClock::inBackground()) {
+    SimClock::schedule(SimClock::now(), [group, bits]() { group->bits |= bits; });
+    return group->bits | bits;
+  }
+  group->bits |= bits;
+  return group->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+  EventBits_t previous = group->bits;
+  group->bits &= ~bits;
+  return previous;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t waitForAll, TickType_t ticksToWait) {
+  int64_t deadline = (ticksToWait == portMAX_DELAY)
+                         ? INT64_MAX
+                         : SimClock::now() + (int64_t)ticksToWait * portTICK_PERIOD_MS * 1000;
+  while (true) {
+    EventBits_t current = group->bits;
+    bool done = waitForAll ? (current & bits) == bits : (current & bits) != 0;
+    if (done) {
+      if (clearOnExit) group->bits &= ~bits;
+      return current;
+    }
+
+    int64_t next = SimClock::nextEvent();
+    // Nothing left that could set the bits
+    if (next == INT64_MAX && deadline == INT64_MAX) return current;
+    if (SimClock::now() >= deadline) return current;
+    SimClock::advanceTo(next < deadline ? next : deadline);
+  }
+}
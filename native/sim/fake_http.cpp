@@ -0,0 +1,253 @@
+// WiFiClient and HTTPClient over the network model and the stand-in server
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include "sim.h"
+#include "sim_server.h"
+
+#define SIM_RESPONSE_HEADER_BYTES 220  // Status line, date, length, type, connection
+
+// One TCP (and TLS) connection; carries one response at a time
+struct SimConnection {
+  std::string host;
+  SimEndpoint endpoint;
+  bool open;          // Server has not closed it
+  bool keepAlive;     // Stays open for the next request after the response
+  std::string body;
+  size_t limit;       // Body bytes the server sends before it stops
+  size_t consumed;    // Body bytes read by the firmware
+  size_t counted;     // Body bytes already in the stats
+  int64_t bodyStartUs;
+  double usPerByte;
+};
+
+static double usPerByte(uint32_t kBps) {
+  return 1e6 / ((double)kBps * 1024);
+}
+
+// Body bytes received by `us`, whole TLS records at a time
+static size_t arrivedBy(const SimConnection& conn, int64_t us) {
+  if (us < conn.bodyStartUs) return 0;
+  size_t raw = (size_t)((double)(us - conn.bodyStartUs) / conn.usPerByte);
+  if (raw >= conn.limit) return conn.limit;
+  uint32_t record = SimDevice::models().network.tlsRecordBytes;
+  return raw / record * record;
+}
+
+// When byte `count` of the body is received
+static int64_t arrivalOf(const SimConnection& conn, size_t count) {
+  uint32_t record = SimDevice::models().network.tlsRecordBytes;
+  size_t recordEnd = (count + record - 1) / record * record;
+  if (recordEnd > conn.limit) recordEnd = conn.limit;
+  return conn.bodyStartUs + (int64_t)((double)recordEnd * conn.usPerByte + 0.999);
+}
+
+// Radio bytes of the body received so far into the stats
+static void settle(SimConnection& conn) {
+  size_t arrived = arrivedBy(conn, SimClock::now());
+  if (arrived <= conn.counted) return;
+  const SimNetworkModel& model = SimDevice::models().network;
+  size_t records = (arrived + model.tlsRecordBytes - 1) / model.tlsRecordBytes -
+                   (conn.counted + model.tlsRecordBytes - 1) / model.tlsRecordBytes;
+  SimDevice::stats().bytesDown += (uint32_t)(arrived - conn.counted + records * model.tlsRecordOverhead);
+  conn.counted = arrived;
+}
+
+/****************************************************************************
+ * WiFiClient
+ ****************************************************************************/
+
+WiFiClient::WiFiClient() {}
+
+WiFiClient::~WiFiClient() {
+  stop();
+}
+
+int WiFiClient::available() {
+  if (!conn) return 0;
+  return (int)(arrivedBy(*conn, SimClock::now()) - conn->consumed);
+}
+
+// Wait up to the timeout for the next body byte, false if it never comes
+static bool waitForByte(SimConnection& conn, unsigned long timeoutMs) {
+  int64_t now = SimClock::now();
+  if (arrivedBy(conn, now) > conn.consumed) return true;
+  int64_t deadline = now + (int64_t)timeoutMs * 1000;
+  if (conn.consumed >= conn.limit) {
+    // Nothing more is coming; a closed connection reads -1 right away
+    if (conn.open) SimClock::advanceTo(deadline);
+    return false;
+  }
+  int64_t at = arrivalOf(conn, conn.consumed + 1);
+  if (at > deadline) {
+    SimClock::advanceTo(deadline);
+    return false;
+  }
+  SimClock::advanceTo(at);
+  return true;
+}
+
+int WiFiClient::read() {
+  if (!conn || !waitForByte(*conn, timeoutMs)) return -1;
+  return (uint8_t)conn->body[conn->consumed++];
+}
+
+int WiFiClient::peek() {
+  if (!conn || !waitForByte(*conn, timeoutMs)) return -1;
+  return (uint8_t)conn->body[conn->consumed];
+}
+
+size_t WiFiClient::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+  while (count < length && conn && waitForByte(*conn, timeoutMs)) {
+    size_t ready = arrivedBy(*conn, SimClock::now()) - conn->consumed;
+    size_t chunk = (ready < length - count) ? ready : length - count;
+    memcpy(buffer + count, conn->body.data() + conn->consumed, chunk);
+    conn->consumed += chunk;
+    count += chunk;
+  }
+  return count;
+}
+
+uint8_t WiFiClient::connected() {
+  return conn && (conn->open || available() > 0);
+}
+
+void WiFiClient::stop() {
+  if (!conn) return;
+  settle(*conn);
+  conn.reset();
+}
+
+/****************************************************************************
+ * HTTPClient
+ ****************************************************************************/
+
+bool HTTPClient::begin(WiFiClient& client, const char* host, uint16_t, const char* uri, bool) {
+  // A kept connection only serves the host it was opened to
+  std::shared_ptr<SimConnection>& conn = client.connection();
+  if (conn && conn->host != host) client.stop();
+  this->client = &client;
+  this->host = host;
+  this->uri = uri;
+  requestHeaders.clear();
+  collectedValues.assign(collected.size(), "");
+  size = -1;
+  return true;
+}
+
+void HTTPClient::end() {
+  if (!client) return;
+  std::shared_ptr<SimConnection>& conn = client->connection();
+  if (conn) {
+    // Keep the connection only once the whole response has been read
+    if (reuse && !http10 && conn->keepAlive && conn->open && conn->consumed >= conn->body.size()) {
+      settle(*conn);
+    } else {
+      client->stop();
+    }
+  }
+  client = nullptr;
+}
+
+// The ESP32 core closes HTTP/1.0 connections after every response
+void HTTPClient::useHTTP10(bool useHTTP10) {
+  http10 = useHTTP10;
+  reuse = !useHTTP10;
+}
+
+void HTTPClient::addHeader(const char* name, const char* value) {
+  requestHeaders.push_back(std::string(name) + ": " + value);
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], size_t count) {
+  collected.assign(headerKeys, headerKeys + count);
+  collectedValues.assign(count, "");
+}
+
+String HTTPClient::header(const char* name) {
+  for (size_t i = 0; i < collected.size(); i++) {
+    if (strcasecmp(collected[i].c_str(), name) == 0) return String(collectedValues[i].c_str());
+  }
+  return String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+  for (size_t i = 0; i < collected.size(); i++) {
+    if (strcasecmp(collected[i].c_str(), name) == 0) return !collectedValues[i].empty();
+  }
+  return false;
+}
+
+int HTTPClient::GET() {
+  return sendRequest("GET", nullptr, 0);
+}
+
+int HTTPClient::POST(uint8_t* payload, size_t size) {
+  return sendRequest("POST", payload, size);
+}
+
+int HTTPClient::sendRequest(const char* method, const uint8_t* payload, size_t payloadSize) {
+  if (!client) return HTTPC_ERROR_NOT_CONNECTED;
+  if (WiFi.status() != WL_CONNECTED) return HTTPC_ERROR_CONNECTION_REFUSED;
+  const SimNetworkModel& model = SimDevice::models().network;
+  SimWakeStats& stats = SimDevice::stats();
+
+  std::shared_ptr<SimConnection>& conn = client->connection();
+  if (conn && !(conn->open && conn->keepAlive && conn->consumed >= conn->body.size())) {
+    client->stop();
+  }
+  std::string body(payload ? (const char*)payload : "", payloadSize);
+  SimResponse response = SimServer::handle(method, host.c_str(), uri.c_str(), body);
+
+  if (!conn) {
+    SimClock::advance((int64_t)(model.dnsMs + model.rttMs) * 1000);
+    if (response.refuse) return HTTPC_ERROR_CONNECTION_REFUSED;
+    if (client->isSecure()) {
+      SimClock::advance((int64_t)model.tlsHandshakeMs * 1000);
+      stats.bytesDown += model.tlsBytesDown;
+      stats.bytesUp += model.tlsBytesUp;
+      stats.tlsHandshakes++;
+    }
+    conn = std::make_shared<SimConnection>();
+    conn->host = host;
+    conn->open = true;
+  }
+
+  std::string request = std::string(method) + " " + uri + (http10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n") +
+                        "Host: " + host + "\r\nUser-Agent: ESP32HTTPClient\r\nConnection: " +
+                        (reuse ? "keep-alive" : "close") + "\r\nAccept-Encoding: identity;q=1,chunked;q=0.1,*;q=0\r\n";
+  for (const std::string& header : requestHeaders) {
+    request += header + "\r\n";
+  }
+  if (payload) request += "Content-Length: " + std::to_string(payloadSize) + "\r\n";
+  request += "\r\n";
+  size_t upBytes = request.size() + payloadSize + model.tlsRecordOverhead;
+  stats.bytesUp += (uint32_t)upBytes;
+  stats.requests++;
+  SimClock::advance((int64_t)(upBytes * usPerByte(model.upKBps)) + (int64_t)(model.rttMs + response.serverMs) * 1000);
+  stats.bytesDown += SIM_RESPONSE_HEADER_BYTES + model.tlsRecordOverhead;
+
+  conn->endpoint = SimServer::endpointOf(host.c_str());
+  conn->body = response.body;
+  conn->consumed = 0;
+  conn->counted = 0;
+  conn->bodyStartUs = SimClock::now();
+  conn->usPerByte = usPerByte(model.downKBps);
+  conn->limit = conn->body.size();
+  conn->keepAlive = reuse;
+  if (response.truncateAt >= 0 && (size_t)response.truncateAt < conn->limit) {
+    conn->limit = response.truncateAt;
+    conn->open = false;
+  }
+
+  for (size_t i = 0; i < collected.size(); i++) {
+    if (strcasecmp(collected[i].c_str(), "Retry-After") == 0 && response.retryAfter) {
+      collectedValues[i] = std::to_string(response.retryAfter);
+    }
+  }
+  size = (int)conn->body.size();
+  if (conn->endpoint == SIM_ENDPOINT_IMAGE && response.status == 200 && conn->limit == conn->body.size()) {
+    stats.imagesServed++;
+  }
+  return response.status;
+}
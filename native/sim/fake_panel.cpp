@@ -0,0 +1,118 @@
+// Panel controller model behind the EPD GPIO and SPI calls
+#include <Arduino.h>
+#include <SPI.h>
+#include <esp_rom_crc.h>
+#include "sim.h"
+
+#define SIM_PANEL_FRAME_BYTES (400 * 600 / 2)
+
+SPIClass SPI;
+
+static uint32_t spiClockHz = 1000000;
+
+void SPIClass::begin(int8_t, int8_t, int8_t, int8_t) {}
+
+void SPIClass::end() {}
+
+void SPIClass::beginTransaction(SPISettings settings) {
+  spiClockHz = settings.clock;
+}
+
+void SPIClass::endTransaction() {}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  SimPanel::transfer(data, spiClockHz);
+  return 0xFF;
+}
+
+static uint8_t dcLevel = HIGH;
+static uint8_t rstLevel = HIGH;
+static uint8_t command = 0;
+static uint32_t dataIndex = 0;
+static int64_t busyUntil = 0;
+static double busFractionUs = 0;
+static uint8_t frame[SIM_PANEL_FRAME_BYTES];
+
+static void busyFor(uint32_t ms) {
+  busyUntil = SimClock::now() + (int64_t)ms * 1000;
+}
+
+void SimPanel::reset() {
+  dcLevel = HIGH;
+  rstLevel = HIGH;
+  command = 0;
+  dataIndex = 0;
+  busyUntil = 0;
+  busFractionUs = 0;
+}
+
+void SimPanel::pinWrite(uint8_t pin, uint8_t value) {
+  if (pin == EPD_DC_PIN) {
+    dcLevel = value;
+  } else if (pin == EPD_RST_PIN) {
+    // Controller restarts on the rising edge and holds BUSY low meanwhile
+    if (rstLevel == LOW && value == HIGH) busyFor(SimDevice::models().panel.resetBusyMs);
+    rstLevel = value;
+  }
+}
+
+static void onCommand(uint8_t cmd) {
+  const SimPanelModel& model = SimDevice::models().panel;
+  command = cmd;
+  dataIndex = 0;
+  switch (cmd) {
+    case 0x04:  // POWER_ON
+      busyFor(model.powerOnMs);
+      break;
+    case 0x84:  // Booster soft start
+      busyFor(model.commandBusyMs);
+      break;
+    default:
+      break;
+  }
+}
+
+static void onData(uint8_t data) {
+  const SimPanelModel& model = SimDevice::models().panel;
+  switch (command) {
+    case 0x10:  // Frame data
+      if (dataIndex < SIM_PANEL_FRAME_BYTES) frame[dataIndex] = data;
+      break;
+    case 0x12:  // DISPLAY_REFRESH
+      if (dataIndex == 0) {
+        busyFor(model.refreshMs);
+        SimWakeStats& stats = SimDevice::stats();
+        stats.refreshes++;
+        stats.shownCrc = esp_rom_crc32_le(0, frame, sizeof(frame));
+      }
+      break;
+    case 0x02:  // POWER_OFF
+      if (dataIndex == 0) busyFor(model.powerOffMs);
+      break;
+    default:
+      break;
+  }
+  dataIndex++;
+}
+
+void SimPanel::transfer(uint8_t data, uint32_t clockHz) {
+  // Bus time in whole microseconds, carrying the fraction to the next byte
+  busFractionUs += 8e6 / clockHz + SimDevice::models().panel.byteOverheadUs;
+  int64_t wholeUs = (int64_t)busFractionUs;
+  busFractionUs -= (double)wholeUs;
+  SimClock::advance(wholeUs);
+
+  if (dcLevel == LOW) {
+    onCommand(data);
+  } else {
+    onData(data);
+  }
+}
+
+int SimPanel::busyLevel() {
+  return (SimClock::now() < busyUntil) ? LOW : HIGH;
+}
+
+int64_t SimPanel::busyReleaseUs() {
+  return (SimClock::now() < busyUntil) ? busyUntil : 0;
+}
@@ -0,0 +1,129 @@
+// Preferences over the NVS table kept by SimDevice
+#include <Preferences.h>
+#include "sim.h"
+
+enum NvsType : uint8_t { NVS_TYPE_INT = 1, NVS_TYPE_STRING = 2, NVS_TYPE_BLOB = 3 };
+
+static SimDevice::NvsEntry* find(const char* ns, const char* key) {
+  SimDevice::NvsEntry* table = SimDevice::nvs();
+  for (int i = 0; i < SimDevice::nvsCapacity; i++) {
+    if (table[i].used && strcmp(table[i].ns, ns) == 0 && strcmp(table[i].key, key) == 0) {
+      return &table[i];
+    }
+  }
+  return nullptr;
+}
+
+static void readCost() {
+  SimClock::advance(SimDevice::models().nvs.readUs);
+}
+
+// Returns length, or 0 if the key does not fit or the table is full
+static size_t write(const char* ns, const char* key, uint8_t type, const void* data, size_t length) {
+  SimDevice::NvsEntry* entry = find(ns, key);
+  if (!entry) {
+    SimDevice::NvsEntry* table = SimDevice::nvs();
+    for (int i = 0; i < SimDevice::nvsCapacity && !entry; i++) {
+      if (!table[i].used) entry = &table[i];
+    }
+  }
+  if (!entry || strlen(key) >= sizeof(entry->key) || length > sizeof(entry->data)) return 0;
+
+  entry->used = true;
+  entry->type = type;
+  strcpy(entry->ns, ns);
+  strcpy(entry->key, key);
+  entry->length = (uint16_t)length;
+  memcpy(entry->data, data, length);
+  SimClock::advance(SimDevice::models().nvs.writeUs);
+  SimDevice::stats().nvsWrites++;
+  return length;
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char*) {
+  if (strlen(name) >= sizeof(ns)) return false;
+  strcpy(ns, name);
+  this->readOnly = readOnly;
+  opened = true;
+  return true;
+}
+
+void Preferences::end() {
+  opened = false;
+}
+
+bool Preferences::clear() {
+  if (!opened || readOnly) return false;
+  SimDevice::NvsEntry* table = SimDevice::nvs();
+  for (int i = 0; i < SimDevice::nvsCapacity; i++) {
+    if (table[i].used && strcmp(table[i].ns, ns) == 0) table[i].used = false;
+  }
+  SimClock::advance(SimDevice::models().nvs.writeUs);
+  SimDevice::stats().nvsWrites++;
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  if (!opened || readOnly) return false;
+  SimDevice::NvsEntry* entry = find(ns, key);
+  if (!entry) return false;
+  entry->used = false;
+  SimClock::advance(SimDevice::models().nvs.writeUs);
+  SimDevice::stats().nvsWrites++;
+  return true;
+}
+
+bool Preferences::isKey(const char* key) {
+  return opened && find(ns, key) != nullptr;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) {
+  if (!opened || readOnly) return 0;
+  return write(ns, key, NVS_TYPE_INT, &value, sizeof(value));
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+  if (!opened || readOnly) return 0;
+  return write(ns, key, NVS_TYPE_STRING, value, strlen(value) + 1) ? strlen(value) : 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+  if (!opened || readOnly) return 0;
+  return write(ns, key, NVS_TYPE_BLOB, value, length);
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+  if (!opened) return defaultValue;
+  readCost();
+  SimDevice::NvsEntry* entry = find(ns, key);
+  if (!entry || entry->type != NVS_TYPE_INT) return defaultValue;
+  int32_t value;
+  memcpy(&value, entry->data, sizeof(value));
+  return value;
+}
+
+// Leaves value untouched if the key is missing, like the ESP32 core
+size_t Preferences::getString(const char* key, char* value, size_t maxLength) {
+  if (!opened) return 0;
+  readCost();
+  SimDevice::NvsEntry* entry = find(ns, key);
+  if (!entry || entry->type != NVS_TYPE_STRING || entry->length > maxLength) return 0;
+  memcpy(value, entry->data, entry->length);
+  return entry->length;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  if (!opened) return 0;
+  readCost();
+  SimDevice::NvsEntry* entry = find(ns, key);
+  return (entry && entry->type == NVS_TYPE_BLOB) ? entry->length : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+  if (!opened) return 0;
+  readCost();
+  SimDevice::NvsEntry* entry = find(ns, key);
+  if (!entry || entry->type != NVS_TYPE_BLOB || entry->length > maxLength) return 0;
+  memcpy(buffer, entry->data, entry->length);
+  return entry->length;
+}
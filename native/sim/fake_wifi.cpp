@@ -0,0 +1,184 @@
+// Station side of the WiFi driver against SimWiFiModel
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <esp_mac.h>
+#include <vector>
+#include "sim.h"
+
+WiFiClass WiFi;
+
+static wifi_mode_t wifiMode = WIFI_MODE_NULL;
+static wl_status_t wifiStatus = WL_IDLE_STATUS;
+static bool persistentConfig = true;
+static bool staticIp = false;
+static IPAddress staticAddress[5];  // ip, gateway, subnet, dns1, dns2
+static uint32_t attempt = 0;        // Events of an older attempt are dropped
+static std::vector<WiFiEventFuncCb> callbacks;
+
+// What DHCP hands out on the simulated network
+static const IPAddress dhcpAddress[5] = {
+    IPAddress(192, 168, 1, 57), IPAddress(192, 168, 1, 1), IPAddress(255, 255, 255, 0),
+    IPAddress(192, 168, 1, 1), IPAddress(0, 0, 0, 0),
+};
+
+static void dispatch(arduino_event_id_t event, uint8_t reason) {
+  arduino_event_info_t info = {};
+  info.wifi_sta_disconnected.reason = reason;
+  for (WiFiEventFuncCb callback : callbacks) {
+    callback(event, info);
+  }
+}
+
+static void scheduleEvent(int64_t atUs, arduino_event_id_t event, uint8_t reason = 0) {
+  uint32_t scheduledFor = attempt;
+  SimClock::schedule(atUs, [scheduledFor, event, reason]() {
+    if (scheduledFor != attempt) return;
+    SimWakeStats& stats = SimDevice::stats();
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+      wifiStatus = WL_CONNECTED;
+      stats.wifiConnected = true;
+    } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+      wifiStatus = (reason == WIFI_REASON_NO_AP_FOUND) ? WL_NO_SSID_AVAIL : WL_CONNECT_FAILED;
+      stats.wifiReason = reason;
+    }
+    dispatch(event, reason);
+  });
+}
+
+bool WiFiClass::mode(wifi_mode_t mode) {
+  if (mode == WIFI_MODE_NULL) disconnect(true);
+  wifiMode = mode;
+  return true;
+}
+
+wifi_mode_t WiFiClass::getMode() {
+  return wifiMode;
+}
+
+bool WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+  staticIp = (uint32_t)localIP != 0;
+  staticAddress[0] = localIP;
+  staticAddress[1] = gateway;
+  staticAddress[2] = subnet;
+  staticAddress[3] = dns1;
+  staticAddress[4] = dns2;
+  return true;
+}
+
+// Directed attempts (channel and BSSID given) only probe the saved channel
+wl_status_t WiFiClass::begin(const char* ssid, const char* password, int32_t channel, const uint8_t* bssid,
+                             bool connect) {
+  const SimWiFiModel& model = SimDevice::models().wifi;
+  if (wifiMode == WIFI_MODE_NULL) wifiMode = WIFI_MODE_STA;
+  attempt++;
+  wifiStatus = WL_DISCONNECTED;
+  SimDevice::stats().wifiAttempts++;
+
+  if (persistentConfig) {
+    wifi_config_t& saved = SimDevice::staConfig();
+    memset(&saved, 0, sizeof(saved));
+    strncpy((char*)saved.sta.ssid, ssid, sizeof(saved.sta.ssid));
+    if (password) strncpy((char*)saved.sta.password, password, sizeof(saved.sta.password));
+    saved.sta.channel = (uint8_t)channel;
+    saved.sta.bssid_set = bssid != nullptr;
+    if (bssid) memcpy(saved.sta.bssid, bssid, sizeof(saved.sta.bssid));
+  }
+  if (!connect) return wifiStatus;
+
+  int64_t now = SimClock::now();
+  bool directed = channel > 0;
+  bool found = model.apPresent &&
+               (!directed || (channel == model.channel &&
+                              (!bssid || memcmp(bssid, model.bssid, sizeof(model.bssid)) == 0)));
+  if (!found) {
+    uint32_t searchMs = directed ? model.directedMissMs : model.scanMs;
+    scheduleEvent(now + (int64_t)searchMs * 1000, ARDUINO_EVENT_WIFI_STA_DISCONNECTED, WIFI_REASON_NO_AP_FOUND);
+    return wifiStatus;
+  }
+
+  int64_t linkUp = now + (int64_t)((directed ? model.directedMs : model.scanMs) + model.authAssocMs) * 1000;
+  if (model.wrongPassword) {
+    scheduleEvent(linkUp, ARDUINO_EVENT_WIFI_STA_DISCONNECTED, WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT);
+    return wifiStatus;
+  }
+  scheduleEvent(linkUp, ARDUINO_EVENT_WIFI_STA_CONNECTED);
+  scheduleEvent(linkUp + (int64_t)(staticIp ? model.staticIpMs : model.dhcpMs) * 1000,
+                ARDUINO_EVENT_WIFI_STA_GOT_IP);
+  return wifiStatus;
+}
+
+bool WiFiClass::setAutoReconnect(bool) {
+  return true;
+}
+
+bool WiFiClass::persistent(bool persistent) {
+  persistentConfig = persistent;
+  return true;
+}
+
+int WiFiClass::onEvent(WiFiEventFuncCb callback) {
+  callbacks.push_back(callback);
+  return (int)callbacks.size();
+}
+
+wl_status_t WiFiClass::status() {
+  SimClock::now();  // Runs any event that is due
+  return wifiStatus;
+}
+
+bool WiFiClass::disconnect(bool wifiOff) {
+  attempt++;
+  wifiStatus = WL_DISCONNECTED;
+  if (wifiOff) wifiMode = WIFI_MODE_NULL;
+  return true;
+}
+
+static IPAddress address(int index) {
+  if (WiFi.status() != WL_CONNECTED) return IPAddress();
+  return staticIp ? staticAddress[index] : dhcpAddress[index];
+}
+
+IPAddress WiFiClass::localIP() {
+  return address(0);
+}
+
+IPAddress WiFiClass::gatewayIP() {
+  return address(1);
+}
+
+IPAddress WiFiClass::subnetMask() {
+  return address(2);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t index) {
+  return address(index ? 4 : 3);
+}
+
+int8_t WiFiClass::RSSI() {
+  return (status() == WL_CONNECTED) ? SimDevice::models().wifi.rssi : 0;
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+  esp_read_mac(mac, ESP_MAC_WIFI_STA);
+  return mac;
+}
+
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t) {
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_config(wifi_interface_t, wifi_config_t* config) {
+  *config = SimDevice::staConfig();
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* info) {
+  if (WiFi.status() != WL_CONNECTED) return ESP_ERR_WIFI_NOT_CONNECT;
+  const SimWiFiModel& model = SimDevice::models().wifi;
+  memset(info, 0, sizeof(*info));
+  memcpy(info->bssid, model.bssid, sizeof(info->bssid));
+  strncpy((char*)info->ssid, (const char*)SimDevice::staConfig().sta.ssid, sizeof(info->ssid) - 1);
+  info->primary = model.channel;
+  info->rssi = model.rssi;
+  return ESP_OK;
+}
@@ -0,0 +1,268 @@
+#include "sim.h"
+#include <sim_flash.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <map>
+#include <utility>
+#include "energy_model.h"
+
+// RTC_DATA_ATTR variables, collected by the linker (see esp_attr.h)
+extern uint8_t __start_rtc_data[];
+extern uint8_t __stop_rtc_data[];
+
+#define SIM_RTC_BYTES 16384
+#define SIM_WAKE_HOST_SECONDS 120       // Host time a wake may take before it counts as hung
+#define SIM_FIRST_POWER_ON_US (1772442000LL * 1000000LL)  // Monday 2026-03-02 09:00 UTC
+
+/****************************************************************************
+ * Clock
+ ****************************************************************************/
+
+static int64_t loopUs = 0;
+static int64_t backgroundUs = 0;
+static bool background = false;
+static bool runningEvents = false;
+static int64_t eventUs = 0;
+static int64_t flashSeenUs = 0;
+static uint64_t eventOrder = 0;
+static std::map<std::pair<int64_t, uint64_t>, std::function<void()>> events;
+
+static int64_t& timeline() {
+  return background ? backgroundUs : loopUs;
+}
+
+// Flash operations run on the calling task, their busy time is its time
+static void foldFlashTime() {
+  int64_t flashUs = (int64_t)SimFlash::getStats().simulatedUs;
+  if (flashUs > flashSeenUs) {
+    timeline() += flashUs - flashSeenUs;
+    flashSeenUs = flashUs;
+  }
+}
+
+// Events run like a higher priority task: as soon as the loop task's time
+// passes them, and seeing the time they were due
+static void runDueEvents() {
+  if (background || runningEvents) return;
+  runningEvents = true;
+  while (!events.empty() && events.begin()->first.first <= loopUs) {
+    auto first = events.begin();
+    std::function<void()> event = std::move(first->second);
+    eventUs = first->first.first;
+    events.erase(first);
+    event();
+  }
+  runningEvents = false;
+}
+
+void SimClock::reset() {
+  loopUs = 0;
+  backgroundUs = 0;
+  background = false;
+  runningEvents = false;
+  flashSeenUs = (int64_t)SimFlash::getStats().simulatedUs;
+  events.clear();
+}
+
+int64_t SimClock::now() {
+  foldFlashTime();
+  if (runningEvents && !background) return eventUs;
+  runDueEvents();
+  return timeline();
+}
+
+void SimClock::advance(int64_t us) {
+  foldFlashTime();
+  if (us > 0) timeline() += us;
+  runDueEvents();
+}
+
+void SimClock::advanceTo(int64_t us) {
+  int64_t current = now();
+  if (us > current) advance(us - current);
+}
+
+void SimClock::schedule(int64_t atUs, std::function<void()> event) {
+  events.emplace(std::make_pair(atUs, eventOrder++), std::move(event));
+}
+
+int64_t SimClock::nextEvent() {
+  return events.empty() ? INT64_MAX : events.begin()->first.first;
+}
+
+void SimClock::runBackground(const std::function<void()>& task) {
+  if (background) {
+    task();
+    return;
+  }
+  backgroundUs = now();
+  background = true;
+  task();
+  foldFlashTime();
+  background = false;
+}
+
+bool SimClock::inBackground() {
+  return background;
+}
+
+/****************************************************************************
+ * Device
+ ****************************************************************************/
+
+// Everything that outlives a wake, in memory shared with the wake processes
+struct SimShared {
+  int64_t wallUs;          // UTC when the current wake started
+  int64_t deviceOffsetUs;  // Device clock minus UTC
+  esp_sleep_wakeup_cause_t cause;
+  bool rtcSaved;
+  uint8_t rtc[SIM_RTC_BYTES];
+  wifi_config_t staConfig;
+  SimDevice::NvsEntry nvs[SimDevice::nvsCapacity];
+  SimWakeStats stats;
+};
+
+static SimShared* shared = nullptr;
+static uint8_t* sharedFlash = nullptr;
+static SimModels modelSet;
+
+static void* mapShared(size_t size) {
+  void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    perror("mmap");
+    exit(1);
+  }
+  return memory;
+}
+
+void SimDevice::init() {
+  if (rtcBytes() > SIM_RTC_BYTES) {
+    fprintf(stderr, "RTC_DATA_ATTR variables take %zu bytes, the simulator keeps %d\n", rtcBytes(), SIM_RTC_BYTES);
+    exit(1);
+  }
+  SimFlash::configure(SimFlashGeometry(), SimFlashTiming());
+  shared = (SimShared*)mapShared(sizeof(SimShared));
+  sharedFlash = (uint8_t*)mapShared(SimFlash::size());
+  shared->wallUs = SIM_FIRST_POWER_ON_US;
+  factoryReset();
+  powerLoss();
+}
+
+SimModels& SimDevice::models() {
+  return modelSet;
+}
+
+void SimDevice::factoryReset() {
+  memset(sharedFlash, 0xFF, SimFlash::size());
+  memset(shared->nvs, 0, sizeof(shared->nvs));
+  memset(&shared->staConfig, 0, sizeof(shared->staConfig));
+}
+
+void SimDevice::powerLoss() {
+  shared->rtcSaved = false;
+  shared->deviceOffsetUs = -shared->wallUs;
+  shared->cause = ESP_SLEEP_WAKEUP_UNDEFINED;
+}
+
+// Child side of a wake: reboot into the state the last one left
+static void boot(bool verbose) {
+  if (!verbose) {
+    int devNull = open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+      dup2(devNull, STDOUT_FILENO);
+      close(devNull);
+    }
+  }
+  alarm(SIM_WAKE_HOST_SECONDS);
+  if (shared->rtcSaved) {
+    memcpy(__start_rtc_data, shared->rtc, SimDevice::rtcBytes());
+  }
+  memcpy(SimFlash::data(), sharedFlash, SimFlash::size());
+  SimFlash::resetStats();
+  SimClock::reset();
+  SimPanel::reset();
+}
+
+SimWakeStats SimDevice::runWake(void (*entry)(), bool verbose) {
+  memset(&shared->stats, 0, sizeof(shared->stats));
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("fork");
+    exit(1);
+  }
+  if (pid == 0) {
+    boot(verbose);
+    entry();
+    fprintf(stderr, "setup() returned instead of going to deep sleep\n");
+    _exit(2);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  SimWakeStats stats = shared->stats;
+  if (WIFSIGNALED(status)) {
+    fprintf(stderr, "wake ended by signal %d\n", WTERMSIG(status));
+  }
+  stats.slept = stats.slept && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  return stats;
+}
+
+SimWakeStats& SimDevice::stats() {
+  return shared->stats;
+}
+
+int64_t SimDevice::wallUs() {
+  return shared->wallUs + SimClock::now();
+}
+
+int64_t SimDevice::deviceTimeUs() {
+  return wallUs() + shared->deviceOffsetUs;
+}
+
+void SimDevice::setDeviceTimeUs(int64_t us) {
+  shared->deviceOffsetUs = us - wallUs();
+}
+
+esp_sleep_wakeup_cause_t SimDevice::bootCause() {
+  return shared->cause;
+}
+
+void SimDevice::deepSleep(uint64_t sleepUs) {
+  SimWakeStats& stats = shared->stats;
+  int64_t wakeUs = SimClock::now();
+  stats.wakeUs = wakeUs;
+  stats.sleepUs = sleepUs;
+  stats.flashBytesProgrammed = SimFlash::getStats().bytesProgrammed;
+  stats.flashSectorsErased = (uint32_t)SimFlash::getStats().sectorsErased;
+  const WakeCharge& charge = EnergyModel::getWake();
+  stats.chargeMas = charge.cpu + charge.radio + charge.panel;
+
+  memcpy(shared->rtc, __start_rtc_data, rtcBytes());
+  shared->rtcSaved = true;
+  memcpy(sharedFlash, SimFlash::data(), SimFlash::size());
+  shared->wallUs += wakeUs + (int64_t)sleepUs;
+  shared->cause = ESP_SLEEP_WAKEUP_TIMER;
+  stats.slept = true;
+
+  fflush(stdout);
+  _exit(0);
+}
+
+size_t SimDevice::rtcBytes() {
+  return (size_t)(__stop_rtc_data - __start_rtc_data);
+}
+
+wifi_config_t& SimDevice::staConfig() {
+  return shared->staConfig;
+}
+
+SimDevice::NvsEntry* SimDevice::nvs() {
+  return shared->nvs;
+}
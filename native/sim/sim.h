@@ -0,0 +1,167 @@
+/*****************************************************************************
+ * | File      	:   sim.h
+ * | Function    :   Host simulation of whole wake cycles (clock, reboots, models)
+ ******************************************************************************/
+#ifndef _SIM_H_
+#define _SIM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <esp_sleep.h>
+#include <esp_wifi.h>
+
+// The access point as the station sees it. Connect phases take these
+// times; a failed attempt reports its disconnect reason when it gives up.
+struct SimWiFiModel {
+  bool apPresent = true;
+  bool wrongPassword = false;
+  uint8_t channel = 6;
+  uint8_t bssid[6] = {0x3c, 0x84, 0x6a, 0x12, 0x9e, 0x40};
+  int8_t rssi = -63;
+  uint32_t scanMs = 2200;          // Full scan of all channels
+  uint32_t directedMs = 120;       // Probe on the saved channel and BSSID
+  uint32_t directedMissMs = 450;   // Saved channel probed without an answer
+  uint32_t authAssocMs = 180;      // Auth, assoc and the 4-way handshake
+  uint32_t dhcpMs = 900;
+  uint32_t staticIpMs = 5;
+};
+
+// Internet path to the stand-in server, per request on top of its own time
+struct SimNetworkModel {
+  uint32_t dnsMs = 25;
+  uint32_t rttMs = 45;
+  uint32_t tlsHandshakeMs = 420;   // Two round trips plus the ECDHE math on the chip
+  uint32_t tlsBytesDown = 4700;    // Server hello and certificate chain
+  uint32_t tlsBytesUp = 520;
+  uint32_t tlsRecordBytes = 16384; // Body bytes reach the client a whole record at a time
+  uint32_t tlsRecordOverhead = 29; // Header, MAC and padding per record
+  uint32_t downKBps = 450;
+  uint32_t upKBps = 120;
+};
+
+// Waveshare 4in0e controller: how long BUSY stays low after each command
+struct SimPanelModel {
+  uint32_t resetBusyMs = 8;
+  uint32_t powerOnMs = 110;
+  uint32_t refreshMs = 31500;
+  uint32_t powerOffMs = 90;
+  uint32_t commandBusyMs = 2;      // Booster soft start (0x84)
+  double byteOverheadUs = 1.5;     // GPIO toggling and the driver call per SPI byte
+};
+
+struct SimNvsModel {
+  uint32_t writeUs = 700;          // Entry write; erases are amortized into it
+  uint32_t readUs = 25;
+};
+
+struct SimModels {
+  SimWiFiModel wifi;
+  SimNetworkModel network;
+  SimPanelModel panel;
+  SimNvsModel nvs;
+};
+
+// What one wake did, filled in by the fakes (shared with the parent process)
+struct SimWakeStats {
+  bool slept;              // Ended in esp_deep_sleep_start()
+  uint64_t wakeUs;         // Boot to deep sleep
+  uint64_t sleepUs;        // Timer wake-up set for the sleep that followed
+  uint32_t bytesDown;      // Radio payload: TLS handshakes, headers, bodies
+  uint32_t bytesUp;
+  uint32_t requests;
+  uint32_t tlsHandshakes;
+  uint32_t wifiAttempts;   // WiFi.begin() calls
+  bool wifiConnected;
+  uint8_t wifiReason;      // Last disconnect reason, 0 if none
+  bool radioOnAtSleep;     // WiFi not turned off before deep sleep
+  uint32_t refreshes;
+  uint32_t shownCrc;       // CRC-32 of the frame of the last refresh
+  uint32_t imagesServed;   // Image bodies the server sent in full
+  uint64_t flashBytesProgrammed;
+  uint32_t flashSectorsErased;
+  uint32_t nvsWrites;
+  float chargeMas;         // EnergyModel estimate (CPU, radio, panel)
+};
+
+// Simulated time. Each task sees its own timeline: the loop task's, and
+// while a task created with xTaskCreate() runs, that task's. Waiting
+// (delay, light sleep, network, SPI and flash busy time) moves it forward;
+// CPU time is not modelled. Events scheduled on the loop timeline (WiFi
+// driver callbacks, bits set by background tasks) run once it passes them.
+class SimClock {
+public:
+  static void reset();
+
+  // Microseconds since boot on the calling task's timeline
+  static int64_t now();
+  static void advance(int64_t us);
+  static void advanceTo(int64_t us);
+
+  // Run event at atUs on the loop timeline
+  static void schedule(int64_t atUs, std::function<void()> event);
+  // Time of the next pending event, INT64_MAX if none
+  static int64_t nextEvent();
+
+  // Run task to completion on a timeline that starts at the current time
+  static void runBackground(const std::function<void()>& task);
+  static bool inBackground();
+};
+
+// The device across wakes. Each wake runs setup() in a forked process, so
+// RAM starts over like after a reset. RTC memory, the storage partition,
+// NVS, the driver's WiFi config and the clock are kept in shared memory.
+class SimDevice {
+public:
+  static void init();
+  static SimModels& models();
+
+  // New device: storage partition erased, NVS empty
+  static void factoryReset();
+  // Battery pulled: RTC memory lost, the clock starts over at 0
+  static void powerLoss();
+
+  // Boot, run entry until deep sleep and return what the wake did.
+  // Firmware output goes to stdout only if verbose.
+  static SimWakeStats runWake(void (*entry)(), bool verbose);
+
+  static SimWakeStats& stats();
+  // UTC and the device's own clock (set by settimeofday), in microseconds
+  static int64_t wallUs();
+  static int64_t deviceTimeUs();
+  static void setDeviceTimeUs(int64_t us);
+
+  static esp_sleep_wakeup_cause_t bootCause();
+  [[noreturn]] static void deepSleep(uint64_t sleepUs);
+
+  // RTC_DATA_ATTR bytes of the firmware (8 KB on the ESP32-C3)
+  static size_t rtcBytes();
+
+  // Driver config written by WiFi.begin() with persistent(true)
+  static wifi_config_t& staConfig();
+
+  // NVS entries for Preferences (see fake_preferences.cpp)
+  struct NvsEntry {
+    bool used;
+    uint8_t type;
+    char ns[16];
+    char key[16];
+    uint16_t length;
+    uint8_t data[4000];
+  };
+  static const int nvsCapacity = 64;
+  static NvsEntry* nvs();
+};
+
+// Panel controller on the EPD pins and SPI bus (fake_panel.cpp)
+class SimPanel {
+public:
+  static void reset();
+  static void pinWrite(uint8_t pin, uint8_t value);
+  static void transfer(uint8_t data, uint32_t clockHz);
+  static int busyLevel();
+  // When BUSY goes high again, 0 if it is high
+  static int64_t busyReleaseUs();
+};
+
+#endif
@@ -0,0 +1,405 @@
+#include "sim_server.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sys/mman.h>
+#include <map>
+#include <vector>
+#include <esp_rom_crc.h>
+#include <mbedtls/sha256.h>
+#include "image_container.h"
+
+#define SIM_NEXT_CHECK_SECONDS 14400
+#define SIM_UTC_OFFSET_SECONDS 3600    // Owner in CET
+#define SIM_DWELL_SECONDS 7200
+#define SIM_SIGNED_URL_SECONDS 900
+#define SIM_RAW_BYTES (400 / 2 * 600)
+
+struct ServerState {
+  int version;
+  int imageCount;
+  SimImage images[SIM_SERVER_MAX_IMAGES];
+  int ackedVersion;
+  bool legacy;  // No outbox support: ignores &ack=, ACKs only via ack-displayed
+  SimFault faults[SIM_SERVER_MAX_FAULTS];
+};
+
+static ServerState* state = nullptr;
+
+void SimServer::init() {
+  void* memory = mmap(nullptr, sizeof(ServerState), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    perror("mmap");
+    exit(1);
+  }
+  state = (ServerState*)memory;
+  memset(state, 0, sizeof(*state));
+}
+
+void SimServer::publish(int version, const SimImage* images, int count) {
+  if (count > SIM_SERVER_MAX_IMAGES) count = SIM_SERVER_MAX_IMAGES;
+  state->version = version;
+  state->imageCount = count;
+  memcpy(state->images, images, count * sizeof(SimImage));
+}
+
+void SimServer::addFault(const SimFault& fault) {
+  for (SimFault& slot : state->faults) {
+    if (slot.remaining == 0) {
+      slot = fault;
+      return;
+    }
+  }
+}
+
+void SimServer::clearFaults() {
+  memset(state->faults, 0, sizeof(state->faults));
+}
+
+void SimServer::setOutboxSupport(bool supported) {
+  state->legacy = !supported;
+}
+
+int SimServer::ackedVersion() {
+  return state->ackedVersion;
+}
+
+/****************************************************************************
+ * Images
+ ****************************************************************************/
+
+static uint32_t nextRandom(uint32_t& x) {
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return x;
+}
+
+static std::vector<uint8_t> rawRows(uint32_t seed) {
+  static const uint8_t colors[6] = {0, 1, 2, 3, 5, 6};  // Black, white, yellow, red, blue, green
+  std::vector<uint8_t> rows(SIM_RAW_BYTES);
+  uint32_t x = seed * 2654435761u + 1;
+  int row = 0;
+  while (row < 600) {
+    int height = 24 + (int)(nextRandom(x) % 64);
+    uint8_t color = colors[nextRandom(x) % 6];
+    bool noisy = (nextRandom(x) % 5) == 0;
+    for (int end = (row + height < 600) ? row + height : 600; row < end; row++) {
+      uint8_t* line = &rows[row * 200];
+      for (int i = 0; i < 200; i++) {
+        if (noisy && i >= 40 && i < 160) {
+          uint32_t r = nextRandom(x);
+          line[i] = (uint8_t)((colors[r % 6] << 4) | colors[(r >> 8) % 6]);
+        } else {
+          line[i] = (uint8_t)((color << 4) | color);
+        }
+      }
+    }
+  }
+  return rows;
+}
+
+static std::vector<uint8_t> packBits(const std::vector<uint8_t>& in) {
+  std::vector<uint8_t> out;
+  size_t i = 0;
+  while (i < in.size()) {
+    size_t run = 1;
+    while (i + run < in.size() && run < 128 && in[i + run] == in[i]) run++;
+    if (run >= 2) {
+      out.push_back((uint8_t)(int8_t)(1 - (int)run));
+      out.push_back(in[i]);
+      i += run;
+      continue;
+    }
+    // Literals up to the next run of two or more
+    size_t start = i;
+    while (i < in.size() && i - start < 128 && !(i + 1 < in.size() && in[i + 1] == in[i])) i++;
+    if (i == start) i++;
+    out.push_back((uint8_t)(i - start - 1));
+    out.insert(out.end(), in.begin() + start, in.begin() + i);
+  }
+  return out;
+}
+
+static void sha256(const uint8_t* data, size_t length, uint8_t out[32]) {
+  mbedtls_sha256_context ctx;
+  mbedtls_sha256_init(&ctx);
+  mbedtls_sha256_starts(&ctx, 0);
+  mbedtls_sha256_update(&ctx, data, length);
+  mbedtls_sha256_finish(&ctx, out);
+  mbedtls_sha256_free(&ctx);
+}
+
+static std::string hex(const uint8_t* data, size_t length) {
+  static const char digits[] = "0123456789abcdef";
+  std::string out;
+  for (size_t i = 0; i < length; i++) {
+    out += digits[data[i] >> 4];
+    out += digits[data[i] & 0x0F];
+  }
+  return out;
+}
+
+// What the image host serves for an image, generated once per process
+static const std::string& imageBody(const SimImage& image) {
+  static std::map<std::string, std::string> bodies;
+  std::string key = std::string(image.id) + (image.container ? "/c" : "/r");
+  auto found = bodies.find(key);
+  if (found != bodies.end()) return found->second;
+
+  std::vector<uint8_t> rows = rawRows(image.seed);
+  std::string body;
+  if (!image.container) {
+    body.assign(rows.begin(), rows.end());
+  } else {
+    std::vector<uint8_t> payload = packBits(rows);
+    ImageHeader header = {};
+    header.magic = IMAGE_MAGIC;
+    header.version = IMAGE_FORMAT_VERSION;
+    header.headerSize = sizeof(ImageHeader);
+    header.codec = IMAGE_CODEC_PACKBITS;
+    header.bpp = 4;
+    header.width = 400;
+    header.height = 600;
+    static const uint8_t identity[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    memcpy(header.palette, identity, sizeof(identity));
+    header.rawSize = (uint32_t)rows.size();
+    header.payloadSize = (uint32_t)payload.size();
+    sha256(payload.data(), payload.size(), header.hash);
+    body.assign((const char*)&header, sizeof(header));
+    body.append(payload.begin(), payload.end());
+  }
+  return bodies.emplace(key, std::move(body)).first->second;
+}
+
+uint32_t SimServer::frameCrc(const char* id) {
+  for (int i = 0; i < state->imageCount; i++) {
+    if (strcmp(state->images[i].id, id) == 0) {
+      std::vector<uint8_t> rows = rawRows(state->images[i].seed);
+      return esp_rom_crc32_le(0, rows.data(), (uint32_t)rows.size());
+    }
+  }
+  return 0;
+}
+
+static const SimImage* findImage(const std::string& id) {
+  for (int i = 0; i < state->imageCount; i++) {
+    if (id == state->images[i].id) return &state->images[i];
+  }
+  return nullptr;
+}
+
+/****************************************************************************
+ * Requests
+ ****************************************************************************/
+
+// Value of a query parameter of uri
+static bool queryParam(const char* uri, const char* name, std::string& value) {
+  const char* query = strchr(uri, '?');
+  if (!query) return false;
+  size_t nameLength = strlen(name);
+  for (const char* p = query + 1; *p;) {
+    const char* end = strchr(p, '&');
+    if (!end) end = p + strlen(p);
+    if ((size_t)(end - p) > nameLength && strncmp(p, name, nameLength) == 0 && p[nameLength] == '=') {
+      value.assign(p + nameLength + 1, end);
+      return true;
+    }
+    p = *end ? end + 1 : end;
+  }
+  return false;
+}
+
+// Value of a "name":value member of a flat JSON body
+static bool jsonMember(const std::string& body, const char* name, std::string& value) {
+  std::string key = std::string("\"") + name + "\":";
+  size_t at = body.find(key);
+  if (at == std::string::npos) return false;
+  at += key.size();
+  if (body[at] == '"') {
+    size_t end = body.find('"', at + 1);
+    if (end == std::string::npos) return false;
+    value = body.substr(at + 1, end - at - 1);
+  } else {
+    size_t end = body.find_first_of(",}]", at);
+    value = body.substr(at, end - at);
+  }
+  return true;
+}
+
+static bool isHex(const std::string& s, size_t length) {
+  if (s.size() != length) return false;
+  for (char c : s) {
+    if (!isxdigit((unsigned char)c)) return false;
+  }
+  return true;
+}
+
+SimEndpoint SimServer::endpointOf(const char* host) {
+  if (strcmp(host, SIM_HOST_VERSION) == 0) return SIM_ENDPOINT_VERSION;
+  if (strcmp(host, SIM_HOST_MANIFEST) == 0) return SIM_ENDPOINT_MANIFEST;
+  if (strcmp(host, SIM_HOST_SIGNED_URLS) == 0) return SIM_ENDPOINT_SIGNED_URLS;
+  if (strcmp(host, SIM_HOST_ACK) == 0) return SIM_ENDPOINT_ACK;
+  if (strcmp(host, SIM_HOST_STORAGE) == 0) return SIM_ENDPOINT_IMAGE;
+  return SIM_ENDPOINT_UNKNOWN;
+}
+
+static int64_t serverTime() {
+  return SimDevice::wallUs() / 1000000;
+}
+
+static void versionResponse(const char* uri, SimResponse& response) {
+  std::string ack;
+  if (!state->legacy && queryParam(uri, "ack", ack) && atoi(ack.c_str()) > state->ackedVersion) {
+    state->ackedVersion = atoi(ack.c_str());
+  }
+  bool changed = state->version > state->ackedVersion;
+  char body[256];
+  snprintf(body, sizeof(body),
+           "{\"slideshowVersion\":%d,\"status\":\"%s\",\"nextCheckSeconds\":%d,\"serverTime\":%lld,"
+           "\"utcOffsetSeconds\":%d%s}",
+           state->version, changed ? "NEW" : "NO_CHANGE", SIM_NEXT_CHECK_SECONDS, (long long)serverTime(),
+           SIM_UTC_OFFSET_SECONDS, state->legacy ? "" : ",\"outboxAccepted\":true");
+  response.body = body;
+  response.serverMs = 60;
+}
+
+static void manifestResponse(const char* uri, SimResponse& response) {
+  std::string param;
+  int offset = queryParam(uri, "offset", param) ? atoi(param.c_str()) : 0;
+  int limit = queryParam(uri, "limit", param) ? atoi(param.c_str()) : state->imageCount;
+  bool containers = queryParam(uri, "container", param) && atoi(param.c_str()) >= IMAGE_FORMAT_VERSION &&
+                    queryParam(uri, "codecs", param) && param.find("packbits") != std::string::npos;
+  if (offset < 0) offset = 0;
+  int end = (offset + limit < state->imageCount) ? offset + limit : state->imageCount;
+
+  std::string ids, hashes;
+  for (int i = offset; i < end; i++) {
+    SimImage image = state->images[i];
+    image.container = image.container && containers;
+    uint8_t hash[32];
+    const std::string& body = imageBody(image);
+    sha256((const uint8_t*)body.data(), body.size(), hash);
+    ids += std::string(i > offset ? "," : "") + "\"" + image.id + "\"";
+    hashes += std::string(i > offset ? "," : "") + "\"" + hex(hash, sizeof(hash)) + "\"";
+  }
+  char head[160];
+  snprintf(head, sizeof(head), "{\"slideshowVersion\":%d,\"totalImages\":%d,\"dwellSeconds\":%d,", state->version,
+           state->imageCount, SIM_DWELL_SECONDS);
+  response.body = std::string(head) + "\"imageIds\":[" + ids + "],\"imageHashes\":[" + hashes + "]}";
+  response.serverMs = 90;
+}
+
+static void signedUrlsResponse(const std::string& request, SimResponse& response) {
+  size_t at = request.find("\"imageIds\":[");
+  std::string body = "{";
+  int64_t expires = serverTime() + SIM_SIGNED_URL_SECONDS;
+  while (at != std::string::npos) {
+    size_t open = request.find('"', request.find_first_of("[,", at) + 1);
+    size_t close = (open == std::string::npos) ? std::string::npos : request.find('"', open + 1);
+    if (close == std::string::npos) break;
+    std::string id = request.substr(open + 1, close - open - 1);
+    if (findImage(id)) {
+      uint8_t sig[32];
+      std::string signedPart = id + std::to_string(expires);
+      sha256((const uint8_t*)signedPart.data(), signedPart.size(), sig);
+      body += std::string(body.size() > 1 ? "," : "") + "\"" + id + "\":\"https://" SIM_HOST_STORAGE "/images/" +
+              id + "?expires=" + std::to_string(expires) + "&sig=" + hex(sig, sizeof(sig)) + "\"";
+    }
+    at = (request[close + 1] == ',') ? close + 1 : std::string::npos;
+  }
+  response.body = body + "}";
+  response.serverMs = 120;
+}
+
+static void imageResponse(const char* uri, SimResponse& response) {
+  const char* prefix = "/images/";
+  if (strncmp(uri, prefix, strlen(prefix)) != 0) {
+    response.status = 404;
+    return;
+  }
+  std::string id(uri + strlen(prefix));
+  id = id.substr(0, id.find('?'));
+  const SimImage* image = findImage(id);
+  if (!image) {
+    response.status = 404;
+    return;
+  }
+  response.body = imageBody(*image);
+  response.serverMs = 30;
+}
+
+// A pending fault for the endpoint, counted down
+static const SimFault* takeFault(SimEndpoint endpoint) {
+  for (SimFault& fault : state->faults) {
+    if (fault.remaining == 0 || fault.target != endpoint) continue;
+    fault.remaining--;
+    return &fault;
+  }
+  return nullptr;
+}
+
+SimResponse SimServer::handle(const char* method, const char* host, const char* uri, const std::string& body) {
+  SimResponse response = {200, "", 0, -1, false, 20};
+  SimEndpoint endpoint = endpointOf(host);
+  const SimFault* fault = takeFault(endpoint);
+  if (fault && fault->refuse) {
+    response.status = 0;
+    response.refuse = true;
+    return response;
+  }
+
+  // Devices authenticate with their id and key
+  std::string deviceId, deviceKey;
+  bool post = strcmp(method, "POST") == 0;
+  if (endpoint == SIM_ENDPOINT_UNKNOWN) {
+    response.status = 404;
+  } else if (endpoint != SIM_ENDPOINT_IMAGE) {
+    bool found = post ? jsonMember(body, "device_id", deviceId) && jsonMember(body, "device_key", deviceKey)
+                      : queryParam(uri, "device_id", deviceId) && queryParam(uri, "device_key", deviceKey);
+    if (!found || !isHex(deviceId, 12) || !isHex(deviceKey, 64)) response.status = 401;
+  }
+
+  // A failing server answers before doing anything
+  if (fault && fault->status) {
+    response.status = fault->status;
+    response.body = "{\"error\":\"injected\"}";
+    response.retryAfter = fault->retryAfter;
+    return response;
+  }
+
+  if (response.status == 200) {
+    switch (endpoint) {
+      case SIM_ENDPOINT_VERSION:
+        versionResponse(uri, response);
+        break;
+      case SIM_ENDPOINT_MANIFEST:
+        manifestResponse(uri, response);
+        break;
+      case SIM_ENDPOINT_SIGNED_URLS:
+        signedUrlsResponse(body, response);
+        break;
+      case SIM_ENDPOINT_ACK: {
+        std::string version;
+        if (jsonMember(body, "slideshow_version", version) && atoi(version.c_str()) > state->ackedVersion) {
+          state->ackedVersion = atoi(version.c_str());
+        }
+        response.body = "{\"ok\":true}";
+        response.serverMs = 50;
+        break;
+      }
+      case SIM_ENDPOINT_IMAGE:
+        imageResponse(uri, response);
+        break;
+      default:
+        break;
+    }
+  }
+  if (fault) {
+    response.retryAfter = fault->retryAfter;
+    response.truncateAt = fault->truncateAt;
+  }
+  return response;
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * | File      	:   sim_server.h
+ * | Function    :   Stand-in for the slideshow backend and image storage
+ ******************************************************************************/
+#ifndef _SIM_SERVER_H_
+#define _SIM_SERVER_H_
+
+#include <stdint.h>
+#include <string>
+
+// Hosts of native/sim/wifi_config.cpp
+#define SIM_HOST_VERSION "get-slideshow-version.frame.sim"
+#define SIM_HOST_MANIFEST "get-slideshow-manifest.frame.sim"
+#define SIM_HOST_SIGNED_URLS "get-signed-urls.frame.sim"
+#define SIM_HOST_ACK "ack-displayed.frame.sim"
+#define SIM_HOST_STORAGE "storage.frame.sim"
+
+#define SIM_SERVER_MAX_IMAGES 16
+#define SIM_SERVER_MAX_FAULTS 8
+
+enum SimEndpoint {
+  SIM_ENDPOINT_VERSION,
+  SIM_ENDPOINT_MANIFEST,
+  SIM_ENDPOINT_SIGNED_URLS,
+  SIM_ENDPOINT_ACK,
+  SIM_ENDPOINT_IMAGE,
+  SIM_ENDPOINT_UNKNOWN
+};
+
+// A panel-size test picture. Stripes of the six panel colors with a
+// noisy band, so PackBits has runs to find and some bytes it cannot pack.
+struct SimImage {
+  char id[48];
+  uint32_t seed;
+  bool container;  // Served as a PackBits container instead of raw rows
+};
+
+// Applied to the next `remaining` requests to an endpoint
+struct SimFault {
+  SimEndpoint target;
+  int status;           // Replaces 200 if non-zero
+  uint32_t retryAfter;  // Retry-After seconds, 0 for none
+  int32_t truncateAt;   // Connection closes after this many body bytes, -1 for never
+  bool refuse;          // Connection refused before any request
+  uint32_t remaining;
+};
+
+struct SimResponse {
+  int status;
+  std::string body;
+  uint32_t retryAfter;
+  int32_t truncateAt;
+  bool refuse;
+  uint32_t serverMs;  // Time to the first response byte, besides the network
+};
+
+// The four endpoints api_client.cpp calls and the image host the signed
+// URLs point at, answered in-process. State that must outlive a wake (the
+// acknowledged version, pending faults) lives in memory shared with the
+// wake processes.
+class SimServer {
+public:
+  static void init();
+
+  // New slideshow version with these images, in order
+  static void publish(int version, const SimImage* images, int count);
+  static void addFault(const SimFault& fault);
+  static void clearFaults();
+  // A server from before the outbox ignores the ACK sent with the version
+  // check and leaves outboxAccepted out of the response
+  static void setOutboxSupport(bool supported);
+
+  static SimResponse handle(const char* method, const char* host, const char* uri, const std::string& body);
+  static SimEndpoint endpointOf(const char* host);
+
+  // Last version a device acknowledged, 0 if none
+  static int ackedVersion();
+  // CRC-32 of the panel frame showing image id as is
+  static uint32_t frameCrc(const char* id);
+};
+
+#endif
@@ -0,0 +1,10 @@
+#include "wifi_config.h"
+
+// The simulated access point and the stand-in server's hosts
+const char *WIFI_SSID = "frame-sim";
+const char *WIFI_PASSWORD = "frame-sim-password";
+
+const char *GET_SLIDESHOW_VERSION_URL = "https://get-slideshow-version.frame.sim";
+const char *GET_SLIDESHOW_MANIFEST_URL = "https://get-slideshow-manifest.frame.sim";
+const char *GET_SIGNED_URLS_URL = "https://get-signed-urls.frame.sim";
+const char *ACK_DISPLAYED_URL = "https://ack-displayed.frame.sim";
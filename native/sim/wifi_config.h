@@ -0,0 +1,16 @@
+/*****************************************************************************
+ * | File      	:   wifi_config.h
+ * | Function    :   Network settings of the wake simulator (see sim_server.h)
+ ******************************************************************************/
+#ifndef _WIFI_CONFIG_H_
+#define _WIFI_CONFIG_H_
+
+extern const char *WIFI_SSID;
+extern const char *WIFI_PASSWORD;
+
+extern const char *GET_SLIDESHOW_VERSION_URL;
+extern const char *GET_SLIDESHOW_MANIFEST_URL;
+extern const char *GET_SIGNED_URLS_URL;
+extern const char *ACK_DISPLAYED_URL;
+
+#endif
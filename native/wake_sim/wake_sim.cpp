@@ -0,0 +1,309 @@
+/*****************************************************************************
+ * | File      	:   wake_sim.cpp
+ * | Function    :   Whole wake cycles of the firmware against simulated
+ * |                 WiFi, server, flash and panel, as a regression baseline
+ * | Info        :   pio run -e native_sim_wake -t exec   (-v: firmware output)
+ ******************************************************************************/
+#include <Arduino.h>
+#include <string>
+#include "sim.h"
+#include "sim_server.h"
+#include "config.h"
+
+// The firmware (src/main.cpp)
+void setup();
+
+#define SIM_RTC_CAPACITY 8192      // RTC slow memory of the ESP32-C3
+#define SIM_MAX_WAKES 24           // Per step, before a scenario counts as stuck
+
+static bool verbose = false;
+static bool success = true;
+
+static const SimImage imageA = {"7c1e2a40-0d4b-4f1e-9d57-2b3f1f6a0a01", 11, false};
+static const SimImage imageB = {"7c1e2a40-0d4b-4f1e-9d57-2b3f1f6a0b02", 22, true};
+static const SimImage imageC = {"7c1e2a40-0d4b-4f1e-9d57-2b3f1f6a0c03", 33, false};
+static const SimImage imageD = {"7c1e2a40-0d4b-4f1e-9d57-2b3f1f6a0d04", 44, true};
+static const SimImage imageE = {"7c1e2a40-0d4b-4f1e-9d57-2b3f1f6a0e05", 55, false};
+static const SimImage imageF = {"7c1e2a40-0d4b-4f1e-9d57-2b3f1f6a0f06", 66, true};
+
+struct ScenarioTotals {
+  int wakes;
+  double wakeMs;
+  uint64_t bytesDown;
+  uint64_t bytesUp;
+  uint32_t requests;
+  uint32_t tlsHandshakes;
+  uint64_t flashBytes;
+  uint32_t sectorsErased;
+  uint32_t nvsWrites;
+  uint32_t refreshes;
+  double chargeMas;
+};
+
+static ScenarioTotals totals;
+
+static void entry() {
+  setup();
+}
+
+static const char* kindOf(const SimWakeStats& stats) {
+  if (stats.wifiAttempts > 0) return "check";
+  if (stats.refreshes > 0) return "advance";
+  return "idle";
+}
+
+static void printHeader() {
+  printf("%-10s %4s %-7s %9s %8s %7s %4s %3s %8s %4s %4s %4s %7s %7s  %s\n", "scenario", "wake", "kind",
+         "wake ms", "KB down", "KB up", "req", "tls", "flash KB", "ers", "nvs", "ref", "mAs", "sleep s", "note");
+}
+
+static void printRow(const char* scenario, int wake, const SimWakeStats& stats, const char* note) {
+  printf("%-10s %4d %-7s %9.1f %8.1f %7.1f %4u %3u %8.1f %4u %4u %4u %7.2f %7llu  %s\n", scenario, wake,
+         kindOf(stats), stats.wakeUs / 1000.0, stats.bytesDown / 1024.0, stats.bytesUp / 1024.0, stats.requests,
+         stats.tlsHandshakes, stats.flashBytesProgrammed / 1024.0, stats.flashSectorsErased, stats.nvsWrites,
+         stats.refreshes, stats.chargeMas, (unsigned long long)(stats.sleepUs / 1000000), note);
+}
+
+static void printTotals(const char* scenario) {
+  printf("%-10s %4d %-7s %9.1f %8.1f %7.1f %4u %3u %8.1f %4u %4u %4u %7.2f\n\n", scenario, totals.wakes, "total",
+         totals.wakeMs, totals.bytesDown / 1024.0, totals.bytesUp / 1024.0, totals.requests, totals.tlsHandshakes,
+         totals.flashBytes / 1024.0, totals.sectorsErased, totals.nvsWrites, totals.refreshes, totals.chargeMas);
+}
+
+static SimWakeStats wake(const char* scenario) {
+  SimWakeStats stats = SimDevice::runWake(entry, verbose);
+  totals.wakes++;
+  totals.wakeMs += stats.wakeUs / 1000.0;
+  totals.bytesDown += stats.bytesDown;
+  totals.bytesUp += stats.bytesUp;
+  totals.requests += stats.requests;
+  totals.tlsHandshakes += stats.tlsHandshakes;
+  totals.flashBytes += stats.flashBytesProgrammed;
+  totals.sectorsErased += stats.flashSectorsErased;
+  totals.nvsWrites += stats.nvsWrites;
+  totals.refreshes += stats.refreshes;
+  totals.chargeMas += stats.chargeMas;
+  if (!stats.slept) {
+    printRow(scenario, totals.wakes, stats, "FAIL: did not reach deep sleep");
+    success = false;
+  }
+  return stats;
+}
+
+// Runs wakes until one checks the server and returns its stats; the
+// wakes before it (advancing the slideshow or idle) are printed as they go
+static SimWakeStats runUntilCheck(const char* scenario) {
+  for (int i = 0; i < SIM_MAX_WAKES; i++) {
+    SimWakeStats stats = wake(scenario);
+    if (!stats.slept || stats.wifiAttempts > 0) return stats;
+    printRow(scenario, totals.wakes, stats, "");
+  }
+  printf("%-10s FAIL: no check wake in %d wakes\n", scenario, SIM_MAX_WAKES);
+  success = false;
+  return SimWakeStats();
+}
+
+static void expect(bool condition, const char* what, std::string& note) {
+  if (!condition) {
+    note += std::string(note.empty() ? "FAIL: " : "; ") + what;
+    success = false;
+  }
+}
+
+static void beginScenario() {
+  memset(&totals, 0, sizeof(totals));
+}
+
+static void firstBoot() {
+  const char* name = "first-boot";
+  beginScenario();
+  SimDevice::factoryReset();
+  SimDevice::powerLoss();
+  SimImage images[] = {imageA, imageB, imageC};
+  SimServer::publish(1, images, 3);
+
+  std::string note;
+  SimWakeStats stats = runUntilCheck(name);
+  expect(stats.wifiConnected, "not connected", note);
+  expect(stats.imagesServed == 3, "expected 3 downloads", note);
+  expect(stats.refreshes == 1 && stats.shownCrc == SimServer::frameCrc(imageA.id), "expected image A shown", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+}
+
+static void noChange() {
+  const char* name = "no-change";
+  beginScenario();
+  std::string note;
+  SimWakeStats stats = runUntilCheck(name);
+  expect(stats.wifiConnected, "not connected", note);
+  expect(stats.requests == 1, "expected only the version check", note);
+  expect(stats.imagesServed == 0, "expected no downloads", note);
+  expect(SimServer::ackedVersion() == 1, "version 1 not acknowledged", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+}
+
+static void newSlideshow() {
+  const char* name = "new-show";
+  beginScenario();
+  // B moves to the front, D is new, C stays in place
+  SimImage images[] = {imageB, imageD, imageC};
+  SimServer::publish(2, images, 3);
+
+  std::string note;
+  SimWakeStats stats = runUntilCheck(name);
+  expect(stats.imagesServed == 1, "expected 1 download", note);
+  expect(stats.refreshes == 1 && stats.shownCrc == SimServer::frameCrc(imageB.id), "expected image B shown", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+}
+
+static void apMissing() {
+  const char* name = "ap-missing";
+  beginScenario();
+  SimDevice::models().wifi.apPresent = false;
+
+  std::string note;
+  SimWakeStats stats = runUntilCheck(name);
+  expect(!stats.wifiConnected && stats.requests == 0, "expected no requests", note);
+  expect(stats.wifiReason == WIFI_REASON_NO_AP_FOUND, "expected NO_AP_FOUND", note);
+  expect(stats.sleepUs <= 900ULL * 1000000, "expected a retry within 15 min", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+
+  // The retry comes before the next advance: nothing to show, so the panel
+  // keeps its image without a refresh
+  note.clear();
+  stats = runUntilCheck(name);
+  expect(!stats.wifiConnected && stats.refreshes == 0, "expected no refresh on a failed retry", note);
+  expect(stats.sleepUs <= 1800ULL * 1000000, "expected a retry within 30 min", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+
+  // Access point back: the next retry goes through and ends the backoff
+  SimDevice::models().wifi.apPresent = true;
+  note.clear();
+  stats = runUntilCheck(name);
+  expect(stats.wifiConnected && stats.requests == 1, "expected the version check on the next retry", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+}
+
+static void partialDownload() {
+  const char* name = "partial";
+  beginScenario();
+  SimImage images[] = {imageB, imageD, imageC, imageE};
+  SimServer::publish(3, images, 4);
+  SimFault truncated = {SIM_ENDPOINT_IMAGE, 0, 0, 60000, false, 1};
+  SimServer::addFault(truncated);
+
+  std::string note;
+  SimWakeStats stats = runUntilCheck(name);
+  expect(stats.imagesServed == 0, "expected the download to break off", note);
+  // First failed check since ap-missing recovered: the backoff starts over
+  expect(stats.sleepUs <= 900ULL * 1000000, "expected a retry within 15 min", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+
+  note.clear();
+  stats = runUntilCheck(name);
+  expect(stats.imagesServed == 1, "expected 1 download on the retry", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+}
+
+static void legacyServer() {
+  const char* name = "legacy";
+  beginScenario();
+  // Server from before the outbox: the ACK needs its own request
+  SimServer::setOutboxSupport(false);
+  SimImage images[] = {imageE, imageB, imageD, imageC};
+  SimServer::publish(4, images, 4);
+
+  std::string note;
+  SimWakeStats stats = runUntilCheck(name);
+  expect(stats.imagesServed == 0 && stats.refreshes == 1, "expected the new order shown without downloads", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+
+  // This check still says NEW for version 4 - it was answered before the ACK
+  note.clear();
+  stats = runUntilCheck(name);
+  expect(stats.requests == 2, "expected the version check and a separate ACK", note);
+  expect(stats.imagesServed == 0, "expected no downloads", note);
+  expect(SimServer::ackedVersion() == 4, "version 4 not acknowledged", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+
+  note.clear();
+  stats = runUntilCheck(name);
+  expect(stats.requests == 1 && stats.imagesServed == 0, "expected only the version check", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+  SimServer::setOutboxSupport(true);
+}
+
+static void reorderedPartial() {
+  const char* name = "reorder";
+  beginScenario();
+  // Every old image moves and the new one breaks off, after the renames
+  SimImage images[] = {imageB, imageE, imageF, imageD};
+  SimServer::publish(5, images, 4);
+  SimFault truncated = {SIM_ENDPOINT_IMAGE, 0, 0, 4000, false, 1};
+  SimServer::addFault(truncated);
+
+  std::string note;
+  SimWakeStats stats = runUntilCheck(name);
+  expect(stats.imagesServed == 0, "expected the download to break off", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+
+  // The moved images have to be found where the first attempt put them
+  note.clear();
+  stats = runUntilCheck(name);
+  expect(stats.imagesServed == 1, "expected 1 download on the retry", note);
+  expect(stats.refreshes == 1 && stats.shownCrc == SimServer::frameCrc(imageB.id), "expected image B shown", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+}
+
+static void powerCut() {
+  const char* name = "power-cut";
+  beginScenario();
+  // RTC memory is lost: association starts before the state load shows
+  // there are images, and so that the first check is splayed
+  SimDevice::powerLoss();
+
+  std::string note;
+  SimWakeStats stats = wake(name);
+  expect(stats.requests == 0, "expected the check splayed after power loss", note);
+  expect(!stats.radioOnAtSleep, "expected the radio off before sleep", note);
+  expect(stats.sleepUs <= COLD_BOOT_SPREAD_SECONDS * 1000000ULL, "expected the check within the cold boot spread", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+
+  // The slideshow in flash is still the one on the server
+  note.clear();
+  stats = runUntilCheck(name);
+  expect(stats.wifiConnected && stats.imagesServed == 0, "expected no downloads", note);
+  printRow(name, totals.wakes, stats, note.c_str());
+  printTotals(name);
+}
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-v") == 0) verbose = true;
+  }
+  SimDevice::init();
+  SimServer::init();
+
+  printf("Wake simulation: simulated time of I/O and waits, CPU time not modelled\n");
+  printHeader();
+  firstBoot();
+  noChange();
+  newSlideshow();
+  apMissing();
+  partialDownload();
+  legacyServer();
+  reorderedPartial();
+  powerCut();
+
+  printf("RTC_DATA_ATTR: %zu of %d bytes\n", SimDevice::rtcBytes(), SIM_RTC_CAPACITY);
+  if (SimDevice::rtcBytes() > SIM_RTC_CAPACITY) success = false;
+  printf("%s\n", success ? "All scenarios passed" : "Scenario expectations failed");
+  return success ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+"""
+PlatformIO extra script: regenerate the packed fonts listed in
+fonts/fonts.txt before building, when their source or the generator
+changed (see gen_font.py)
+"""
+
+import os
+import sys
+
+Import("env")
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "scripts"))
+import gen_font  # noqa: E402
+
+gen_font.build_all(env.subst("$PROJECT_DIR"))
@@ -0,0 +1,323 @@
+#!/usr/bin/env python3
+"""
+Generate packed Unicode fonts (cFONT) for Paint_DrawString_CN
+
+Each font listed in fonts/fonts.txt becomes src/<font name>.cpp holding
+  - the codepoints, sorted, searched with a binary search at draw time
+  - per glyph: bitmap offset, ink box size and position in the cell
+  - the bitmaps, trimmed to their ink box, rows padded to a whole byte
+so flash grows with what is drawn instead of a fixed cell per glyph.
+
+Sources are either the Waveshare CH_CN tables (fonts/waveshare/) or BDF
+bitmap fonts. A BDF source takes a charset file listing what to keep:
+characters as UTF-8 text and/or lines of U+XXXX or U+XXXX-U+YYYY ranges
+('#' starts a comment line).
+
+Usage:
+    python3 scripts/gen_font.py            regenerate stale fonts
+    python3 scripts/gen_font.py --force    regenerate all fonts
+
+Also run before every build by scripts/build_fonts.py.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MANIFEST = os.path.join("fonts", "fonts.txt")
+GENERATOR = os.path.join("scripts", "gen_font.py")
+# Ink boxes are stored in bytes (CH_GLYPH)
+MAX_CELL = 255
+
+
+class Font:
+    def __init__(self, name, ascii_width, width, height):
+        self.name = name
+        self.ascii_width = ascii_width
+        self.width = width
+        self.height = height
+        # codepoint -> rows of the full cell, each a list of 0/1
+        self.cells = {}
+
+    def add(self, codepoint, rows):
+        # First definition wins, as with the old linear scan
+        self.cells.setdefault(codepoint, rows)
+
+
+def blank_cell(width, height):
+    return [[0] * width for _ in range(height)]
+
+
+def unpack_rows(data, width, height):
+    row_bytes = (width + 7) // 8
+    rows = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            byte = data[y * row_bytes + x // 8] if y * row_bytes + x // 8 < len(data) else 0
+            row.append((byte >> (7 - x % 8)) & 1)
+        rows.append(row)
+    return rows
+
+
+def load_waveshare(path, name):
+    """
+    Waveshare tables: {"字", 0x.., ...} entries of Width x Height bitmaps and
+    a cFONT initializer carrying the ASCII width, width and height.
+    """
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+
+    metrics = {}
+    for key, pattern in (("ascii", r"ASCII Width"), ("width", r"\bWidth"), ("height", r"\bHeight")):
+        match = re.search(r"(\d+)\s*,\s*/\*\s*" + pattern + r"\s*\*/", text)
+        if not match:
+            raise ValueError(f"{path}: no '{pattern}' in the cFONT initializer")
+        metrics[key] = int(match.group(1))
+
+    font = Font(name, metrics["ascii"], metrics["width"], metrics["height"])
+    for match in re.finditer(r'\{\s*"([^"]+)"\s*,([^}]*)\}', text):
+        chars = match.group(1)
+        if len(chars) != 1:
+            raise ValueError(f"{path}: index '{chars}' is not one character")
+        data = [int(value, 16) for value in re.findall(r"0x([0-9A-Fa-f]{2})", match.group(2))]
+        font.add(ord(chars), unpack_rows(data, font.width, font.height))
+    return font
+
+
+def load_charset(path):
+    codepoints = set()
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            match = re.fullmatch(r"U\+([0-9A-Fa-f]+)(?:\s*-\s*U\+([0-9A-Fa-f]+))?", line)
+            if match:
+                first = int(match.group(1), 16)
+                last = int(match.group(2), 16) if match.group(2) else first
+                codepoints.update(range(first, last + 1))
+            else:
+                codepoints.update(ord(c) for c in line if not c.isspace())
+    return codepoints
+
+
+def load_bdf(path, name, charset):
+    """
+    BDF glyphs are placed in a cell of FONTBOUNDINGBOX width and
+    FONT_ASCENT + FONT_DESCENT height; ASCII advances by DWIDTH of 'a'.
+    """
+    props = {}
+    glyphs = []
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] in ("FONTBOUNDINGBOX", "FONT_ASCENT", "FONT_DESCENT"):
+            props[words[0]] = [int(w) for w in words[1:]]
+        elif words[0] == "STARTCHAR":
+            glyph = {}
+            for line in lines:
+                words = line.split()
+                if not words:
+                    continue
+                if words[0] == "ENCODING":
+                    glyph["codepoint"] = int(words[1])
+                elif words[0] == "DWIDTH":
+                    glyph["advance"] = int(words[1])
+                elif words[0] == "BBX":
+                    glyph["bbx"] = [int(w) for w in words[1:5]]
+                elif words[0] == "BITMAP":
+                    glyph["bitmap"] = []
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        glyph["bitmap"].append(bytes.fromhex(line.strip()))
+                    break
+            glyphs.append(glyph)
+
+    box = props["FONTBOUNDINGBOX"]
+    ascent = props.get("FONT_ASCENT", [box[1] + box[3]])[0]
+    descent = props.get("FONT_DESCENT", [-box[3]])[0]
+    width, height = box[0], ascent + descent
+    advances = {g["codepoint"]: g.get("advance", width) for g in glyphs if "codepoint" in g}
+    font = Font(name, advances.get(ord("a"), (width + 1) // 2), width, height)
+
+    for glyph in glyphs:
+        codepoint = glyph.get("codepoint", -1)
+        if codepoint < 0 or codepoint not in charset or "bbx" not in glyph:
+            continue
+        w, h, xoff, yoff = glyph["bbx"]
+        rows = blank_cell(width, height)
+        top = ascent - (yoff + h)
+        left = xoff - box[2]
+        for y, data in enumerate(glyph["bitmap"][:h]):
+            for x in range(w):
+                cx, cy = left + x, top + y
+                if 0 <= cx < width and 0 <= cy < height and (data[x // 8] >> (7 - x % 8)) & 1:
+                    rows[cy][cx] = 1
+        font.add(codepoint, rows)
+    return font
+
+
+def ink_box(rows):
+    """(left, top, width, height) of the set pixels, all 0 for a blank glyph"""
+    ys = [y for y, row in enumerate(rows) if any(row)]
+    if not ys:
+        return 0, 0, 0, 0
+    xs = [x for row in rows for x, bit in enumerate(row) if bit]
+    return min(xs), ys[0], max(xs) - min(xs) + 1, ys[-1] - ys[0] + 1
+
+
+def pack_box(rows, left, top, width, height):
+    data = []
+    for row in rows[top:top + height]:
+        bits = row[left:left + width]
+        for x in range(0, width, 8):
+            byte = 0
+            for i, bit in enumerate(bits[x:x + 8]):
+                byte |= bit << (7 - i)
+            data.append(byte)
+    return data
+
+
+def format_bytes(data, indent="  ", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ",".join(f"0x{b:02X}" for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def printable(codepoint):
+    char = chr(codepoint)
+    return char if char.isprintable() and char not in "\\*/" else ""
+
+
+def render(font, source):
+    if font.width > MAX_CELL or font.height > MAX_CELL:
+        raise ValueError(f"{font.name}: cell {font.width}x{font.height} is larger than {MAX_CELL}")
+
+    codepoints = sorted(font.cells)
+    glyphs = []
+    bitmap = []
+    for codepoint in codepoints:
+        left, top, width, height = ink_box(font.cells[codepoint])
+        glyphs.append((len(bitmap), width, height, left, top))
+        bitmap += pack_box(font.cells[codepoint], left, top, width, height)
+
+    fixed = len(codepoints) * ((font.width + 7) // 8) * font.height
+    out = []
+    out.append(f"/* Generated by {GENERATOR.replace(os.sep, '/')} from {source}, do not edit */")
+    out.append('#include "fonts.h"')
+    out.append("")
+    out.append(f"// {len(codepoints)} glyphs in a {font.width}x{font.height} cell: "
+               f"{len(bitmap)} bytes of bitmaps ({fixed} as whole cells)")
+    out.append("")
+    out.append(f"static const uint32_t {font.name}_Codepoints[] =")
+    out.append("{")
+    for i in range(0, len(codepoints), 8):
+        out.append("  " + ", ".join(f"0x{c:04X}" for c in codepoints[i:i + 8]) + ",")
+    out.append("};")
+    out.append("")
+    out.append(f"static const CH_GLYPH {font.name}_Glyphs[] =")
+    out.append("{")
+    for codepoint, (offset, width, height, left, top) in zip(codepoints, glyphs):
+        label = " ".join(filter(None, (f"U+{codepoint:04X}", printable(codepoint))))
+        out.append(f"  {{{offset:6d}, {width:3d}, {height:3d}, {left:3d}, {top:3d}}}, /* {label} */")
+    out.append("};")
+    out.append("")
+    out.append(f"static const uint8_t {font.name}_Bitmap[] =")
+    out.append("{")
+    if bitmap:
+        out.append(format_bytes(bitmap))
+    else:
+        out.append("  0x00,")
+    out.append("};")
+    out.append("")
+    out.append(f"cFONT {font.name} = {{")
+    out.append(f"  {font.name}_Codepoints,")
+    out.append(f"  {font.name}_Glyphs,")
+    out.append(f"  {font.name}_Bitmap,")
+    out.append(f"  {len(codepoints)}, /* size of table */")
+    out.append(f"  {font.ascii_width}, /* ASCII Width */")
+    out.append(f"  {font.width}, /* Width */")
+    out.append(f"  {font.height}, /* Height */")
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def read_manifest(project_dir):
+    """(name, source, charset or None) for each font, paths relative to fonts/"""
+    entries = []
+    with open(os.path.join(project_dir, MANIFEST), encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            words = line.split("#", 1)[0].split()
+            if not words:
+                continue
+            if len(words) not in (2, 3):
+                raise ValueError(f"{MANIFEST}:{number}: expected 'name source [charset]'")
+            entries.append((words[0], words[1], words[2] if len(words) == 3 else None))
+    return entries
+
+
+def output_path(project_dir, name):
+    # Font24CN -> src/font24CN.cpp, alongside font24.cpp
+    return os.path.join(project_dir, "src", name[0].lower() + name[1:] + ".cpp")
+
+
+def is_stale(output, inputs):
+    if not os.path.exists(output):
+        return True
+    built = os.path.getmtime(output)
+    return any(os.path.getmtime(path) > built for path in inputs)
+
+
+def build_font(project_dir, name, source, charset):
+    fonts_dir = os.path.join(project_dir, "fonts")
+    source_path = os.path.join(fonts_dir, source)
+    if source.lower().endswith(".bdf"):
+        if not charset:
+            raise ValueError(f"{name}: a BDF source needs a charset file")
+        font = load_bdf(source_path, name, load_charset(os.path.join(fonts_dir, charset)))
+    else:
+        font = load_waveshare(source_path, name)
+    return render(font, "fonts/" + source)
+
+
+def build_all(project_dir, force=False, log=print):
+    generated = []
+    for name, source, charset in read_manifest(project_dir):
+        output = output_path(project_dir, name)
+        inputs = [os.path.join(project_dir, MANIFEST),
+                  os.path.join(project_dir, GENERATOR),
+                  os.path.join(project_dir, "fonts", source)]
+        if charset:
+            inputs.append(os.path.join(project_dir, "fonts", charset))
+        if not force and not is_stale(output, inputs):
+            continue
+        text = build_font(project_dir, name, source, charset)
+        with open(output, "w", encoding="utf-8", newline="\n") as f:
+            f.write(text)
+        log(f"gen_font: {os.path.relpath(output, project_dir)}")
+        generated.append(output)
+    return generated
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--force", action="store_true", help="regenerate fonts that are up to date")
+    parser.add_argument("--project-dir", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    args = parser.parse_args()
+    try:
+        build_all(os.path.abspath(args.project_dir), args.force)
+    except (OSError, ValueError) as error:
+        print(f"gen_font: {error}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,21 @@
+"""
+PlatformIO extra script for native (host) environments that use littlefs
+
+The littlefs repository ships test and bench runners with their own main()
+and an extra set of block devices. Only lfs.c and lfs_util.c are needed,
+the simulated flash lives in native/shim/sim_flash.cpp.
+"""
+
+Import("env")
+
+LITTLEFS_SOURCES = ("lfs.c", "lfs_util.c")
+
+
+def skip_littlefs_extras(node):
+    path = node.get_path().replace("\\", "/")
+    if "/littlefs/" in path and not path.endswith(LITTLEFS_SOURCES):
+        return None
+    return node
+
+
+env.AddBuildMiddleware(skip_littlefs_extras)
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+Convert trace spans from the serial log into Chrome trace JSON
+
+The firmware prints spans not yet printed at the end of each wake as
+    TRACE,<wake>,<task>,<depth>,<startUs>,<durationUs>,<name>
+Each wake becomes one process in the viewer (times are since its boot),
+the loop task and background work (radio, panel init) one thread each.
+
+Usage:
+    pio device monitor | tee frame.log
+    python3 trace_to_chrome.py frame.log > trace.json
+    python3 trace_to_chrome.py < frame.log > trace.json
+
+Open trace.json in chrome://tracing or https://ui.perfetto.dev
+"""
+
+import json
+import sys
+
+TASK_NAMES = {0: "loop", 1: "background"}
+
+
+def parse_spans(lines):
+    """
+    Collect spans from log lines, ignoring everything else. A span printed
+    twice (log captured across a reset) is only kept once.
+    """
+    spans = []
+    seen = set()
+    for line in lines:
+        start = line.find("TRACE,")
+        if start < 0:
+            continue
+        fields = line[start:].strip().split(",", 6)
+        if len(fields) != 7:
+            continue
+        try:
+            wake, task, depth, start_us, duration_us = (int(f) for f in fields[1:6])
+        except ValueError:
+            continue
+        span = (wake, task, depth, start_us, duration_us, fields[6])
+        if span not in seen:
+            seen.add(span)
+            spans.append(span)
+    return spans
+
+
+def to_chrome(spans):
+    events = []
+    for wake in sorted({s[0] for s in spans}):
+        events.append({"ph": "M", "name": "process_name", "pid": wake, "tid": 0,
+                       "args": {"name": f"wake {wake}"}})
+        for task, name in TASK_NAMES.items():
+            events.append({"ph": "M", "name": "thread_name", "pid": wake, "tid": task,
+                           "args": {"name": name}})
+    for wake, task, depth, start_us, duration_us, name in spans:
+        events.append({"ph": "X", "name": name, "pid": wake, "tid": task,
+                       "ts": start_us, "dur": duration_us, "args": {"depth": depth}})
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    if len(sys.argv) > 2:
+        print(__doc__)
+        return 1
+    if len(sys.argv) == 2:
+        with open(sys.argv[1], errors="replace") as log:
+            spans = parse_spans(log)
+    else:
+        spans = parse_spans(sys.stdin)
+    if not spans:
+        print("No TRACE lines found", file=sys.stderr)
+        return 1
+    json.dump(to_chrome(spans), sys.stdout, indent=1)
+    print()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
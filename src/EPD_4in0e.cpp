@@ -34,6 +34,46 @@
 #include <esp_sleep.h>
 #include <driver/gpio.h>
 #include <Arduino.h>
+#include "power_profile.h"
+#include "trace.h"
+
+// BUSY waits light sleep by default; polled while the radio is in use
+static bool busyLightSleep = true;
+// millis() when the first image byte of this boot went out, 0 if none yet
+static unsigned long firstFrameByteMs = 0;
+// Time spent in refreshes since boot, panel supply on (energy model)
+static uint32_t refreshMs = 0;
+
+/******************************************************************************
+function :  Select how BUSY waits idle the CPU
+parameter:
+    enable : true  = light sleep with GPIO wake (default, WiFi must be off)
+             false = poll BUSY every few ms, safe while WiFi is associating
+                     or when called from a background task
+******************************************************************************/
+void EPD_4IN0E_SetBusyLightSleep(bool enable)
+{
+    busyLightSleep = enable;
+}
+
+/******************************************************************************
+function :  Time of the first image byte sent to the panel
+parameter:
+returns: millis() when it went out, 0 if no image was sent since boot
+******************************************************************************/
+unsigned long EPD_4IN0E_FirstFrameByteMs(void)
+{
+    return firstFrameByteMs;
+}
+
+/******************************************************************************
+function :  Time spent refreshing the panel since boot, with or without tracing
+parameter:
+******************************************************************************/
+uint32_t EPD_4IN0E_RefreshMs(void)
+{
+    return refreshMs;
+}
 
 /******************************************************************************
 function :  Software reset
@@ -98,6 +138,15 @@ static void EPD_4IN0E_ReadBusyH(void)
     
     unsigned long timeout = millis() + 60000; // 60 second timeout (safety)
     bool displayDone = false;
+
+    // Radio off and only this task running - drop to the idle power profile.
+    // Light sleep is only enabled once the background panel init is done, so
+    // PowerManager is never touched from that task.
+    bool lightSleep = busyLightSleep;
+    PowerProfile previousProfile = PowerManager::getProfile();
+    if (lightSleep) {
+        PowerManager::setProfile(POWER_PROFILE_IDLE);
+    }
     
     while (!displayDone && (millis() < timeout)) {
         // Check current state before entering sleep
@@ -105,6 +154,12 @@ static void EPD_4IN0E_ReadBusyH(void)
             displayDone = true;
             break;
         }
+
+        // Light sleep would stall the radio and every other task
+        if (!lightSleep) {
+            DEV_Delay_ms(5);
+            continue;
+        }
         
         // Configure GPIO wakeup for BUSY pin (HIGH level = display done)
         // ESP32-C3: Use gpio_wakeup_enable for light sleep
@@ -132,6 +187,9 @@ static void EPD_4IN0E_ReadBusyH(void)
             break;
         }
     }
+    if (lightSleep) {
+        PowerManager::setProfile(previousProfile);
+    }
     
     // Small delay to ensure display is fully ready
     DEV_Delay_ms(200);
@@ -144,7 +202,9 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN0E_TurnOnDisplay(void)
 {
-    
+    TRACE_SCOPE("epd.refresh");
+    unsigned long start = millis();
+
     EPD_4IN0E_SendCommand(0x04); // POWER_ON
     EPD_4IN0E_ReadBusyH();
     DEV_Delay_ms(200);
@@ -165,6 +225,7 @@ static void EPD_4IN0E_TurnOnDisplay(void)
     EPD_4IN0E_SendData(0X00);
     EPD_4IN0E_ReadBusyH();
     DEV_Delay_ms(200);
+    refreshMs += millis() - start;
 }
 
 /******************************************************************************
@@ -173,6 +234,7 @@ parameter:
 ******************************************************************************/
 void EPD_4IN0E_Init(void)
 {
+    TRACE_SCOPE("epd.init");
     EPD_4IN0E_Reset();
     EPD_4IN0E_ReadBusyH();
     DEV_Delay_ms(30);
@@ -367,6 +429,7 @@ bool EPD_4IN0E_DisplayFromFile(File &file, size_t imageSize)
         return false;
     }
     
+    TraceSpan upload("epd.upload");
     EPD_4IN0E_SendCommand(0x10);
     
     size_t totalBytesRead = 0;
@@ -380,6 +443,9 @@ bool EPD_4IN0E_DisplayFromFile(File &file, size_t imageSize)
                 if (byteRead == -1) {
                     return false;  // Read error
                 }
+                if (firstFrameByteMs == 0) {
+                    firstFrameByteMs = millis();
+                }
                 EPD_4IN0E_SendData((UBYTE)byteRead);
                 totalBytesRead++;
             } else {
@@ -392,11 +458,49 @@ bool EPD_4IN0E_DisplayFromFile(File &file, size_t imageSize)
     if (totalBytesRead != imageSize) {
         return false;
     }
+    upload.end();
     
     EPD_4IN0E_TurnOnDisplay();
     return true;
 }
 
+/******************************************************************************
+function :  Start streaming an image in pieces (e.g. bands from GUI_Band)
+parameter:
+info:
+    Send the whole image with EPD_4IN0E_WriteFrame(), top row first, then
+    EPD_4IN0E_EndFrame() to refresh
+******************************************************************************/
+void EPD_4IN0E_BeginFrame(void)
+{
+    EPD_4IN0E_SendCommand(0x10);
+}
+
+/******************************************************************************
+function :  Send the next piece of a streamed image
+parameter:
+    Data   : Packed 4bpp pixels, two per byte
+    Length : Bytes in Data
+******************************************************************************/
+void EPD_4IN0E_WriteFrame(const UBYTE *Data, UDOUBLE Length)
+{
+    if (firstFrameByteMs == 0 && Length > 0) {
+        firstFrameByteMs = millis();
+    }
+    for (UDOUBLE i = 0; i < Length; i++) {
+        EPD_4IN0E_SendData(Data[i]);
+    }
+}
+
+/******************************************************************************
+function :  Finish a streamed image and refresh the display
+parameter:
+******************************************************************************/
+void EPD_4IN0E_EndFrame(void)
+{
+    EPD_4IN0E_TurnOnDisplay();
+}
+
 void EPD_4IN0E_DisplayPart(const UBYTE *Image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh)
 {
 	unsigned long i, j;
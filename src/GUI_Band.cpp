@@ -0,0 +1,345 @@
+#include "GUI_Band.h"
+#include <FS.h>
+#include <string.h>
+
+typedef enum {
+    BAND_OP_CLEAR_WINDOWS = 0,
+    BAND_OP_POINT,
+    BAND_OP_LINE,
+    BAND_OP_RECTANGLE,
+    BAND_OP_CIRCLE,
+    BAND_OP_CHAR,
+    BAND_OP_STRING_EN,
+    BAND_OP_BITMAP_PASTE,
+} BAND_OP_TYPE;
+
+/**
+ * One recorded drawing call
+**/
+typedef struct {
+    UBYTE Type;
+    UBYTE Size;         // DOT_PIXEL / line width
+    UBYTE Style;        // DOT_STYLE, LINE_STYLE, DRAW_FILL, flipColor or the character
+    UWORD X0, Y0;
+    UWORD X1, Y1;       // End point, radius, or bitmap size
+    UWORD Color;
+    UWORD Background;
+    const void *Data;   // Font or bitmap
+    UWORD Text;         // Offset of the string in the text pool
+    UWORD RowStart;     // Memory rows the call can touch
+    UWORD RowEnd;
+} BAND_OP;
+
+static BAND_OP Ops[BAND_MAX_OPS];
+static UWORD OpCount = 0;
+static char TextPool[BAND_TEXT_POOL];
+static UWORD TextUsed = 0;
+
+/******************************************************************************
+function: Memory row of a point, as Paint_SetPixel() maps it
+******************************************************************************/
+static int Band_MemoryRow(int X, int Y)
+{
+    int Row;
+    switch(Paint.Rotate) {
+    case ROTATE_90:
+        Row = X;
+        break;
+    case ROTATE_180:
+        Row = Paint.HeightMemory - Y - 1;
+        break;
+    case ROTATE_270:
+        Row = Paint.HeightMemory - X - 1;
+        break;
+    default:
+        Row = Y;
+        break;
+    }
+    if(Paint.Mirror & MIRROR_VERTICAL)
+        Row = Paint.HeightMemory - Row - 1;
+    return Row;
+}
+
+/******************************************************************************
+function: Append a call to the display list
+parameter:
+    Type : BAND_OP_*
+    Xmin, Ymin, Xmax, Ymax : Area the call can draw to (any order, may
+                             exceed the image)
+******************************************************************************/
+static BAND_OP *Band_Add(UBYTE Type, int Xmin, int Ymin, int Xmax, int Ymax)
+{
+    if(OpCount >= BAND_MAX_OPS) {
+        Debug("Band display list full\r\n");
+        return NULL;
+    }
+
+    int RowA = Band_MemoryRow(Xmin, Ymin);
+    int RowB = Band_MemoryRow(Xmax, Ymax);
+    int RowStart = RowA < RowB ? RowA : RowB;
+    int RowEnd = RowA < RowB ? RowB : RowA;
+    if(RowStart < 0)
+        RowStart = 0;
+    if(RowEnd > Paint.HeightMemory - 1)
+        RowEnd = Paint.HeightMemory - 1;
+
+    BAND_OP *Op = &Ops[OpCount++];
+    memset(Op, 0, sizeof(BAND_OP));
+    Op->Type = Type;
+    Op->RowStart = RowStart;
+    Op->RowEnd = RowEnd;
+    return Op;
+}
+
+/******************************************************************************
+function: Start a display list for an image
+parameter:
+    Width, Height, Rotate, Color : As Paint_NewImage()
+******************************************************************************/
+void Band_NewImage(UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
+{
+    Paint_NewImage(NULL, Width, Height, Rotate, Color);
+    Band_Reset();
+}
+
+/******************************************************************************
+function: Drop all recorded calls
+******************************************************************************/
+void Band_Reset(void)
+{
+    OpCount = 0;
+    TextUsed = 0;
+}
+
+UWORD Band_Count(void)
+{
+    return OpCount;
+}
+
+void Band_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    BAND_OP *Op = Band_Add(BAND_OP_CLEAR_WINDOWS, Xstart, Ystart, Xend - 1, Yend - 1);
+    if(Op == NULL)
+        return;
+    Op->X0 = Xstart;
+    Op->Y0 = Ystart;
+    Op->X1 = Xend;
+    Op->Y1 = Yend;
+    Op->Color = Color;
+}
+
+void Band_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
+{
+    BAND_OP *Op = Band_Add(BAND_OP_POINT, Xpoint - Dot_Pixel, Ypoint - Dot_Pixel,
+                           Xpoint + Dot_Pixel, Ypoint + Dot_Pixel);
+    if(Op == NULL)
+        return;
+    Op->X0 = Xpoint;
+    Op->Y0 = Ypoint;
+    Op->Color = Color;
+    Op->Size = Dot_Pixel;
+    Op->Style = Dot_Style;
+}
+
+void Band_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                   UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+{
+    int Xmin = Xstart < Xend ? Xstart : Xend;
+    int Xmax = Xstart < Xend ? Xend : Xstart;
+    int Ymin = Ystart < Yend ? Ystart : Yend;
+    int Ymax = Ystart < Yend ? Yend : Ystart;
+    BAND_OP *Op = Band_Add(BAND_OP_LINE, Xmin - Line_width, Ymin - Line_width,
+                           Xmax + Line_width, Ymax + Line_width);
+    if(Op == NULL)
+        return;
+    Op->X0 = Xstart;
+    Op->Y0 = Ystart;
+    Op->X1 = Xend;
+    Op->Y1 = Yend;
+    Op->Color = Color;
+    Op->Size = Line_width;
+    Op->Style = Line_Style;
+}
+
+void Band_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                        UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    BAND_OP *Op = Band_Add(BAND_OP_RECTANGLE, Xstart - Line_width, Ystart - Line_width,
+                           Xend + Line_width, Yend + Line_width);
+    if(Op == NULL)
+        return;
+    Op->X0 = Xstart;
+    Op->Y0 = Ystart;
+    Op->X1 = Xend;
+    Op->Y1 = Yend;
+    Op->Color = Color;
+    Op->Size = Line_width;
+    Op->Style = Draw_Fill;
+}
+
+void Band_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
+                     UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    int Reach = Radius + Line_width;
+    BAND_OP *Op = Band_Add(BAND_OP_CIRCLE, X_Center - Reach, Y_Center - Reach,
+                           X_Center + Reach, Y_Center + Reach);
+    if(Op == NULL)
+        return;
+    Op->X0 = X_Center;
+    Op->Y0 = Y_Center;
+    Op->X1 = Radius;
+    Op->Color = Color;
+    Op->Size = Line_width;
+    Op->Style = Draw_Fill;
+}
+
+void Band_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                   sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    BAND_OP *Op = Band_Add(BAND_OP_CHAR, Xpoint, Ypoint,
+                           Xpoint + Font->Width - 1, Ypoint + Font->Height - 1);
+    if(Op == NULL)
+        return;
+    Op->X0 = Xpoint;
+    Op->Y0 = Ypoint;
+    Op->Style = Acsii_Char;
+    Op->Data = Font;
+    Op->Color = Color_Foreground;
+    Op->Background = Color_Background;
+}
+
+/******************************************************************************
+function: Record a string
+info:
+    The string is copied, it does not need to outlive the call. A string
+    that wraps can touch any row, so it is replayed in every band.
+******************************************************************************/
+void Band_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
+                        sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD Length = strlen(pString);
+    if(TextUsed + Length + 1 > BAND_TEXT_POOL) {
+        Debug("Band text pool full\r\n");
+        return;
+    }
+
+    BAND_OP *Op;
+    if(Xstart + (UDOUBLE)Length * Font->Width <= Paint.Width)
+        Op = Band_Add(BAND_OP_STRING_EN, Xstart, Ystart,
+                      Xstart + Length * Font->Width - 1, Ystart + Font->Height - 1);
+    else
+        Op = Band_Add(BAND_OP_STRING_EN, 0, 0, Paint.Width - 1, Paint.Height - 1);
+    if(Op == NULL)
+        return;
+    Op->X0 = Xstart;
+    Op->Y0 = Ystart;
+    Op->Data = Font;
+    Op->Color = Color_Foreground;
+    Op->Background = Color_Background;
+    Op->Text = TextUsed;
+    memcpy(&TextPool[TextUsed], pString, Length + 1);
+    TextUsed += Length + 1;
+}
+
+/******************************************************************************
+function: Record a monochrome bitmap paste
+info:
+    Only the pointer is kept - image_buffer must stay valid until
+    Band_Render() (normally a const array in flash).
+******************************************************************************/
+void Band_DrawBitMap_Paste(const unsigned char* image_buffer, UWORD xStart, UWORD yStart,
+                           UWORD imageWidth, UWORD imageHeight, UBYTE flipColor)
+{
+    BAND_OP *Op = Band_Add(BAND_OP_BITMAP_PASTE, xStart, yStart,
+                           xStart + imageWidth - 1, yStart + imageHeight - 1);
+    if(Op == NULL)
+        return;
+    Op->X0 = xStart;
+    Op->Y0 = yStart;
+    Op->X1 = imageWidth;
+    Op->Y1 = imageHeight;
+    Op->Data = image_buffer;
+    Op->Style = flipColor;
+}
+
+/******************************************************************************
+function: Replay one call into the current band
+******************************************************************************/
+static void Band_Replay(const BAND_OP *Op)
+{
+    switch(Op->Type) {
+    case BAND_OP_CLEAR_WINDOWS:
+        Paint_ClearWindows(Op->X0, Op->Y0, Op->X1, Op->Y1, Op->Color);
+        break;
+    case BAND_OP_POINT:
+        Paint_DrawPoint(Op->X0, Op->Y0, Op->Color, (DOT_PIXEL)Op->Size, (DOT_STYLE)Op->Style);
+        break;
+    case BAND_OP_LINE:
+        Paint_DrawLine(Op->X0, Op->Y0, Op->X1, Op->Y1, Op->Color, (DOT_PIXEL)Op->Size, (LINE_STYLE)Op->Style);
+        break;
+    case BAND_OP_RECTANGLE:
+        Paint_DrawRectangle(Op->X0, Op->Y0, Op->X1, Op->Y1, Op->Color, (DOT_PIXEL)Op->Size, (DRAW_FILL)Op->Style);
+        break;
+    case BAND_OP_CIRCLE:
+        Paint_DrawCircle(Op->X0, Op->Y0, Op->X1, Op->Color, (DOT_PIXEL)Op->Size, (DRAW_FILL)Op->Style);
+        break;
+    case BAND_OP_CHAR:
+        Paint_DrawChar(Op->X0, Op->Y0, (char)Op->Style, (sFONT*)Op->Data, Op->Color, Op->Background);
+        break;
+    case BAND_OP_STRING_EN:
+        Paint_DrawString_EN(Op->X0, Op->Y0, &TextPool[Op->Text], (sFONT*)Op->Data, Op->Color, Op->Background);
+        break;
+    case BAND_OP_BITMAP_PASTE:
+        Paint_DrawBitMap_Paste((const unsigned char*)Op->Data, Op->X0, Op->Y0, Op->X1, Op->Y1, Op->Style);
+        break;
+    }
+}
+
+/******************************************************************************
+function: Render the display list band by band
+parameter:
+    Buffer  : Rows * Paint.WidthByte bytes
+    Rows    : Memory rows per band
+    Source  : Fills each band with the background, NULL clears it to Paint.Color
+    Context : Passed to Source
+    Sink    : Receives each finished band, top to bottom
+returns: false if Source failed (the image is then incomplete)
+******************************************************************************/
+bool Band_Render(UBYTE *Buffer, UWORD Rows, BAND_SOURCE Source, void *Context, BAND_SINK Sink)
+{
+    UBYTE *Image = Paint.Image;
+    bool Success = true;
+
+    Paint_SelectImage(Buffer);
+    for(UWORD Start = 0; Start < Paint.HeightMemory; Start += Rows) {
+        UWORD Count = (Paint.HeightMemory - Start < Rows) ? (Paint.HeightMemory - Start) : Rows;
+        UDOUBLE Length = (UDOUBLE)Count * Paint.WidthByte;
+        Paint_SetBand(Start, Count);
+
+        if(Source) {
+            if(!Source(Buffer, Length, Context)) {
+                Success = false;
+                break;
+            }
+        } else {
+            Paint_Clear(Paint.Color);
+        }
+
+        for(UWORD i = 0; i < OpCount; i++) {
+            if(Ops[i].RowEnd < Start || Ops[i].RowStart >= Start + Count)
+                continue;
+            Band_Replay(&Ops[i]);
+        }
+        Sink(Buffer, Length);
+    }
+
+    Paint_SetBand(0, Paint.HeightMemory);
+    Paint_SelectImage(Image);
+    return Success;
+}
+
+bool Band_FillFromFile(UBYTE *Band, UDOUBLE Length, void *Context)
+{
+    File *file = (File *)Context;
+    return file->read(Band, Length) == Length;
+}
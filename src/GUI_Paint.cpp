@@ -76,6 +76,7 @@
 *
 ******************************************************************************/
 #include "GUI_Paint.h"
+#include "GUI_Painter.h"
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h> //memset()
@@ -102,6 +103,8 @@ void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD
     Paint.Scale = 2;
     Paint.WidthByte = (Width % 8 == 0)? (Width / 8 ): (Width / 8 + 1);
     Paint.HeightByte = Height;    
+    Paint.BandStart = 0;
+    Paint.BandRows = Height;
 //    printf("WidthByte = %d, HeightByte = %d\r\n", Paint.WidthByte, Paint.HeightByte);
 //    printf(" EPD_WIDTH / 8 = %d\r\n",  122 / 8);
    
@@ -178,83 +181,147 @@ void Paint_SetScale(UBYTE scale)
         Debug("Scale Only support: 2 4 7\r\n");
     }
 }
+/******************************************************************************
+function: Select the rows of memory the image cache holds
+parameter:
+    Start : First memory row in the cache
+    Rows  : Number of rows in the cache
+info:
+    Pixels outside the band are skipped, so every drawing function can
+    render into a cache of a few rows (see GUI_Band.h). Paint_Clear clears
+    the band only. Paint_NewImage selects the full height.
+******************************************************************************/
+void Paint_SetBand(UWORD Start, UWORD Rows)
+{
+    Paint.BandStart = Start;
+    Paint.BandRows = Rows;
+}
+
 /******************************************************************************
 function: Draw Pixels
 parameter:
     Xpoint : At point X
     Ypoint : At point Y
     Color  : Painted colors
+info:
+    Looks up the Painter for the current rotation, mirror and scale on every
+    call. Loops drawing many pixels use Paint_Dispatch() once instead
+    (see GUI_Painter.h)
 ******************************************************************************/
 void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
 {
-    if(Xpoint > Paint.Width || Ypoint > Paint.Height){
-        Debug("Exceeding display boundaries\r\n");
-        return;
-    }      
-    UWORD X, Y;
-    switch(Paint.Rotate) {
-    case 0:
-        X = Xpoint;
-        Y = Ypoint;  
-        break;
-    case 90:
-        X = Paint.WidthMemory - Ypoint - 1;
-        Y = Xpoint;
-        break;
-    case 180:
-        X = Paint.WidthMemory - Xpoint - 1;
-        Y = Paint.HeightMemory - Ypoint - 1;
-        break;
-    case 270:
-        X = Ypoint;
-        Y = Paint.HeightMemory - Xpoint - 1;
-        break;
-    default:
-        return;
+    Paint_Dispatch([&](auto P) { P.SetPixel(Xpoint, Ypoint, Color); });
+}
+
+/******************************************************************************
+function: Byte holding every pixel of one color, as Paint_SetPixel() writes it
+parameter:
+    Color  : Painted colors
+******************************************************************************/
+static UBYTE Paint_FillPattern(UWORD Color)
+{
+    if(Paint.Scale == 2)
+        return (Color == BLACK) ? 0x00 : 0xFF;
+    if(Paint.Scale == 4)
+        return (Color % 4) * 0x55;
+    return (Color & 0x0F) * 0x11;
+}
+
+/******************************************************************************
+function: Fill memory pixels X0..X1 of one cache row
+parameter:
+    Row     : First byte of the row
+    X0      : First memory column
+    X1      : Last memory column
+    Pattern : Paint_FillPattern() of the color
+info:
+    Pixels sharing a byte with either end of the span are merged with a mask,
+    the whole bytes in between are written with memset
+******************************************************************************/
+static void Paint_FillRow(UBYTE *Row, UWORD X0, UWORD X1, UBYTE Pattern)
+{
+    UBYTE Bits = (Paint.Scale == 2) ? 1 : (Paint.Scale == 4) ? 2 : 4;
+    UBYTE PerByte = 8 / Bits;
+    UBYTE PixelMask = (1 << Bits) - 1;
+    UBYTE Mask;
+
+    //Leading pixels up to the first byte boundary
+    while(X0 <= X1 && X0 % PerByte != 0) {
+        Mask = PixelMask << ((PerByte - 1 - X0 % PerByte) * Bits);
+        Row[X0 / PerByte] = (Row[X0 / PerByte] & ~Mask) | (Pattern & Mask);
+        X0++;
     }
-    
-    switch(Paint.Mirror) {
-    case MIRROR_NONE:
-        break;
-    case MIRROR_HORIZONTAL:
-        X = Paint.WidthMemory - X - 1;
-        break;
-    case MIRROR_VERTICAL:
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    case MIRROR_ORIGIN:
-        X = Paint.WidthMemory - X - 1;
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    default:
+    if(X0 > X1)
         return;
+
+    UWORD Bytes = (X1 - X0 + 1) / PerByte;
+    memset(&Row[X0 / PerByte], Pattern, Bytes);
+    X0 += Bytes * PerByte;
+
+    //Trailing pixels of a partial byte
+    while(X0 <= X1) {
+        Mask = PixelMask << ((PerByte - 1 - X0 % PerByte) * Bits);
+        Row[X0 / PerByte] = (Row[X0 / PerByte] & ~Mask) | (Pattern & Mask);
+        X0++;
     }
+}
 
-    if(X > Paint.WidthMemory || Y > Paint.HeightMemory){
-        Debug("Exceeding display boundaries\r\n");
+/******************************************************************************
+function: Map a point to its position in memory, as Paint_SetPixel() does
+parameter:
+    Xpoint : At point X
+    Ypoint : At point Y
+    X      : Memory column
+    Y      : Memory row, counted from the top of the image (not the band)
+******************************************************************************/
+static bool Paint_MapPoint(UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
+{
+    return Paint_Dispatch([&](auto P) { P.Map(Xpoint, Ypoint, *X, *Y); });
+}
+
+/******************************************************************************
+function: Fill a rectangle of pixels
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Xend   : x end point, inclusive
+    Yend   : y end point, inclusive
+    Color  : Painted colors
+info:
+    The rectangle is clipped to the image. Rotation and mirroring map it to
+    another rectangle in memory, filled one row span at a time, so the cost
+    is per byte rather than per pixel
+******************************************************************************/
+static void Paint_FillArea(int Xstart, int Ystart, int Xend, int Yend, UWORD Color)
+{
+    if(Paint.Scale != 2 && Paint.Scale != 4 && Paint.Scale != 6 &&
+       Paint.Scale != 7 && Paint.Scale != 16)
         return;
-    }
-    
-    if(Paint.Scale == 2){
-        UDOUBLE Addr = X / 8 + Y * Paint.WidthByte;
-        UBYTE Rdata = Paint.Image[Addr];
-        if(Color == BLACK)
-            Paint.Image[Addr] = Rdata & ~(0x80 >> (X % 8));
-        else
-            Paint.Image[Addr] = Rdata | (0x80 >> (X % 8));
-    }else if(Paint.Scale == 4){
-        UDOUBLE Addr = X / 4 + Y * Paint.WidthByte;
-        Color = Color % 4;//Guaranteed color scale is 4  --- 0~3
-        UBYTE Rdata = Paint.Image[Addr];
-        
-        Rdata = Rdata & (~(0xC0 >> ((X % 4)*2)));
-        Paint.Image[Addr] = Rdata | ((Color << 6) >> ((X % 4)*2));
-    }else if(Paint.Scale == 6 || Paint.Scale == 7 || Paint.Scale == 16){
-		UDOUBLE Addr = X / 2  + Y * Paint.WidthByte;
-		UBYTE Rdata = Paint.Image[Addr];
-		Rdata = Rdata & (~(0xF0 >> ((X % 2)*4)));//Clear first, then set value
-		Paint.Image[Addr] = Rdata | ((Color << 4) >> ((X % 2)*4));
-		// printf("Add =  %d ,data = %d\r\n",Addr,Rdata);	
+
+    if(Xstart < 0) Xstart = 0;
+    if(Ystart < 0) Ystart = 0;
+    if(Xend > Paint.Width - 1) Xend = Paint.Width - 1;
+    if(Yend > Paint.Height - 1) Yend = Paint.Height - 1;
+    if(Xstart > Xend || Ystart > Yend)
+        return;
+
+    UWORD X0, Y0, X1, Y1;
+    if(!Paint_MapPoint(Xstart, Ystart, &X0, &Y0) || !Paint_MapPoint(Xend, Yend, &X1, &Y1))
+        return;
+    if(X0 > X1) { UWORD T = X0; X0 = X1; X1 = T; }
+    if(Y0 > Y1) { UWORD T = Y0; Y0 = Y1; Y1 = T; }
+
+    //Only the rows of the band being rendered
+    if(Y0 < Paint.BandStart)
+        Y0 = Paint.BandStart;
+    if(Y1 >= Paint.BandStart + Paint.BandRows)
+        Y1 = Paint.BandStart + Paint.BandRows - 1;
+    if(Paint.BandRows == 0 || Y0 > Y1)
+        return;
+
+    UBYTE Pattern = Paint_FillPattern(Color);
+    for(UWORD Y = Y0; Y <= Y1; Y++) {
+        Paint_FillRow(Paint.Image + (UDOUBLE)(Y - Paint.BandStart) * Paint.WidthByte, X0, X1, Pattern);
     }
 }
 
@@ -265,28 +332,17 @@ parameter:
 ******************************************************************************/
 void Paint_Clear(UWORD Color)
 {
+    UBYTE Pattern;
     if(Paint.Scale == 2) {
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {//8 pixel =  1 byte
-				UDOUBLE Addr = X + Y*Paint.WidthByte;
-				Paint.Image[Addr] = Color;
-			}
-		}
+        Pattern = Color;
     }else if(Paint.Scale == 4) {
-        for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-            for (UWORD X = 0; X < Paint.WidthByte; X++ ) {
-                UDOUBLE Addr = X + Y*Paint.WidthByte;
-                Paint.Image[Addr] = (Color<<6)|(Color<<4)|(Color<<2)|Color;
-            }
-        }
+        Pattern = (Color<<6)|(Color<<4)|(Color<<2)|Color;
     }else if(Paint.Scale == 6 || Paint.Scale == 7 || Paint.Scale == 16) {
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {
-				UDOUBLE Addr = X + Y*Paint.WidthByte;
-				Paint.Image[Addr] = (Color<<4)|Color;
-			}
-		}		
-	}
+        Pattern = (Color<<4)|Color;
+    }else {
+        return;
+    }
+    memset(Paint.Image, Pattern, (UDOUBLE)Paint.WidthByte * Paint.BandRows);
 }
 
 /******************************************************************************
@@ -300,12 +356,9 @@ parameter:
 ******************************************************************************/
 void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
 {
-    UWORD X, Y;
-    for (Y = Ystart; Y < Yend; Y++) {
-        for (X = Xstart; X < Xend; X++) {//8 pixel =  1 byte
-            Paint_SetPixel(X, Y, Color);
-        }
-    }
+    if (Xstart >= Xend || Ystart >= Yend)
+        return;
+    Paint_FillArea(Xstart, Ystart, Xend - 1, Yend - 1, Color);
 }
 
 /******************************************************************************
@@ -317,8 +370,9 @@ parameter:
     Dot_Pixel	: point size
     Dot_Style	: point Style
 ******************************************************************************/
-void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
-                     DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
+template <class P>
+static void Paint_DrawPointWith(P Painter, UWORD Xpoint, UWORD Ypoint, UWORD Color,
+                                DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
 {
     if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
         Debug("Paint_DrawPoint Input exceeds the normal display range\r\n");
@@ -332,18 +386,24 @@ void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
                 if(Xpoint + XDir_Num - Dot_Pixel < 0 || Ypoint + YDir_Num - Dot_Pixel < 0)
                     break;
                 // printf("x = %d, y = %d\r\n", Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel);
-                Paint_SetPixel(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
+                Painter.SetPixel(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
             }
         }
     } else {
         for (XDir_Num = 0; XDir_Num <  Dot_Pixel; XDir_Num++) {
             for (YDir_Num = 0; YDir_Num <  Dot_Pixel; YDir_Num++) {
-                Paint_SetPixel(Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
+                Painter.SetPixel(Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
             }
         }
     }
 }
 
+void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
+                     DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
+{
+    Paint_Dispatch([&](auto P) { Paint_DrawPointWith(P, Xpoint, Ypoint, Color, Dot_Pixel, Dot_Style); });
+}
+
 /******************************************************************************
 function: Draw a line of arbitrary slope
 parameter:
@@ -355,8 +415,9 @@ parameter:
     Line_width : Line width
     Line_Style: Solid and dotted lines
 ******************************************************************************/
-void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
-                    UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+template <class P>
+static void Paint_DrawLineWith(P Painter, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                               UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
 {
     if (Xstart > Paint.Width || Ystart > Paint.Height ||
         Xend > Paint.Width || Yend > Paint.Height) {
@@ -382,10 +443,10 @@ void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
         //Painted dotted line, 2 point is really virtual
         if (Line_Style == LINE_STYLE_DOTTED && Dotted_Len % 3 == 0) {
             //Debug("LINE_DOTTED\r\n");
-            Paint_DrawPoint(Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
+            Paint_DrawPointWith(Painter, Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
             Dotted_Len = 0;
         } else {
-            Paint_DrawPoint(Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
+            Paint_DrawPointWith(Painter, Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
         }
         if (2 * Esp >= dy) {
             if (Xpoint == Xend)
@@ -402,6 +463,14 @@ void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
     }
 }
 
+void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                    UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+{
+    Paint_Dispatch([&](auto P) {
+        Paint_DrawLineWith(P, Xstart, Ystart, Xend, Yend, Color, Line_width, Line_Style);
+    });
+}
+
 /******************************************************************************
 function: Draw a rectangle
 parameter:
@@ -423,10 +492,14 @@ void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
     }
 
     if (Draw_Fill) {
-        UWORD Ypoint;
-        for(Ypoint = Ystart; Ypoint < Yend; Ypoint++) {
-            Paint_DrawLine(Xstart, Ypoint, Xend, Ypoint, Color , Line_width, LINE_STYLE_SOLID);
-        }
+        //The pixels a solid Line_width line per row would cover: each row
+        //Ystart..Yend-1 stamps points reaching Line_width up and left of it and
+        //Line_width - 2 down and right, and rows whose points would start
+        //above the image are skipped whole (see Paint_DrawPoint)
+        int First = Ystart > (int)Line_width ? Ystart : (int)Line_width;
+        if (First < Yend)
+            Paint_FillArea((int)Xstart - Line_width, First - Line_width,
+                           (int)Xend + Line_width - 2, (int)Yend + Line_width - 3, Color);
     } else {
         Paint_DrawLine(Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
         Paint_DrawLine(Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
@@ -435,6 +508,29 @@ void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
     }
 }
 
+/******************************************************************************
+function: Fill one span of a filled circle
+parameter:
+    X_Center : Center X coordinate
+    Y_Center : Center Y coordinate
+    Offset   : Row of the span, relative to the center
+    Reach    : Half width of the span
+    Color    : Painted color
+info:
+    Spans sit one pixel up and left of the center, where Paint_DrawPoint puts
+    a 1x1 dot. The circle is symmetric, so with 90/270 rotation it is filled
+    by columns instead, which are rows in memory
+******************************************************************************/
+static void Paint_FillCircleSpan(int X_Center, int Y_Center, int Offset, int Reach, UWORD Color)
+{
+    if (Paint.Rotate == ROTATE_90 || Paint.Rotate == ROTATE_270)
+        Paint_FillArea(X_Center + Offset - 1, Y_Center - Reach - 1,
+                       X_Center + Offset - 1, Y_Center + Reach - 1, Color);
+    else
+        Paint_FillArea(X_Center - Reach - 1, Y_Center + Offset - 1,
+                       X_Center + Reach - 1, Y_Center + Offset - 1, Color);
+}
+
 /******************************************************************************
 function: Use the 8-point method to draw a circle of the
             specified size at the specified position->
@@ -462,18 +558,17 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     //Cumulative error,judge the next point of the logo
     int16_t Esp = 3 - (Radius << 1 );
 
-    int16_t sCountY;
     if (Draw_Fill == DRAW_FILL_FULL) {
+        //Every step of the 8-point walk covers rows +-XCurrent out to
+        //+-YCurrent and rows +-YCurrent out to +-XCurrent. Each row is filled
+        //once with its widest reach: rows +-YCurrent on the last step before
+        //YCurrent moves
         while (XCurrent <= YCurrent ) { //Realistic circles
-            for (sCountY = XCurrent; sCountY <= YCurrent; sCountY ++ ) {
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//1
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//2
-                Paint_DrawPoint(X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//3
-                Paint_DrawPoint(X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//4
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//5
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//6
-                Paint_DrawPoint(X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//7
-                Paint_DrawPoint(X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+            Paint_FillCircleSpan(X_Center, Y_Center, XCurrent, YCurrent, Color);
+            Paint_FillCircleSpan(X_Center, Y_Center, -XCurrent, YCurrent, Color);
+            if (Esp >= 0 || XCurrent == YCurrent) {
+                Paint_FillCircleSpan(X_Center, Y_Center, YCurrent, XCurrent, Color);
+                Paint_FillCircleSpan(X_Center, Y_Center, -YCurrent, XCurrent, Color);
             }
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
@@ -505,55 +600,338 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     }
 }
 
+/**
+ * Tables for the glyph blitter: Mask4 and Mask2 expand a font byte to 4-bit
+ * and 2-bit pixels (each set bit becomes an all-ones field, first pixel at
+ * the top), Reverse mirrors the bit order of a byte
+**/
+#define GLYPH_MAX_SPAN 64   // Largest glyph width and height the blitter takes
+
+struct GLYPH_LUT {
+    uint32_t Mask4[256];
+    uint16_t Mask2[256];
+    UBYTE Reverse[256];
+    constexpr GLYPH_LUT() : Mask4(), Mask2(), Reverse() {
+        for (int Byte = 0; Byte < 256; Byte++) {
+            for (int Bit = 0; Bit < 8; Bit++) {
+                if (Byte & (0x80 >> Bit)) {
+                    Mask4[Byte] |= 0xF0000000u >> (Bit * 4);
+                    Mask2[Byte] |= 0xC000 >> (Bit * 2);
+                    Reverse[Byte] |= 0x01 << Bit;
+                }
+            }
+        }
+    }
+};
+static constexpr GLYPH_LUT Glyph_Lut;
+
+// Pixel mask of eight glyph pixels at Bpp bits each, in the top 8 * Bpp bits
+template <UBYTE Bpp>
+static inline uint32_t Paint_GlyphMask(UBYTE Bits)
+{
+    if (Bpp == 4)
+        return Glyph_Lut.Mask4[Bits];
+    if (Bpp == 2)
+        return (uint32_t)Glyph_Lut.Mask2[Bits] << 16;
+    return (uint32_t)Bits << 24;
+}
+
+// The top Count bits of a word
+static inline uint32_t Paint_TopBits(UBYTE Count)
+{
+    return Count ? 0xFFFFFFFFu << (32 - Count) : 0;
+}
+
+// A color in every pixel of a word, packed as Paint_SetPixel() packs it
+template <UBYTE Bpp>
+static inline uint32_t Paint_ColorWord(UWORD Color)
+{
+    if (Bpp == 4)
+        return (Color & 0x0F) * 0x11111111u;
+    if (Bpp == 2)
+        return (Color % 4) * 0x55555555u;
+    return (Color == BLACK) ? 0 : 0xFFFFFFFFu;
+}
+
 /******************************************************************************
-function: Show English characters
+function: Merge up to four bytes of pixels into a cache row
 parameter:
-    Xpoint           ：X coordinate
-    Ypoint           ：Y coordinate
-    Acsii_Char       ：To display the English characters
-    Font             ：A structure pointer that displays a character size
+    Dst   : First byte
+    Value : Pixels, first byte in the top 8 bits
+    Write : Bits of Value to write
+    Limit : Bytes that may be touched (1 - 4)
+******************************************************************************/
+static inline void Paint_PutWord(UBYTE *Dst, uint32_t Value, uint32_t Write, UWORD Limit)
+{
+    if (Write == 0)
+        return;
+    if (Limit >= 4) {
+        if (Write != 0xFFFFFFFFu) {
+            uint32_t Old = ((uint32_t)Dst[0] << 24) | ((uint32_t)Dst[1] << 16) |
+                           ((uint32_t)Dst[2] << 8) | Dst[3];
+            Value = (Old & ~Write) | (Value & Write);
+        }
+        Dst[0] = Value >> 24;
+        Dst[1] = Value >> 16;
+        Dst[2] = Value >> 8;
+        Dst[3] = Value;
+        return;
+    }
+    for (UBYTE n = 0; n < Limit; n++) {
+        UBYTE W = Write >> (24 - 8 * n);
+        if (W == 0xFF)
+            Dst[n] = Value >> (24 - 8 * n);
+        else if (W)
+            Dst[n] = (Dst[n] & ~W) | ((Value >> (24 - 8 * n)) & W);
+    }
+}
+
+/******************************************************************************
+function: Write a run of 1-bit glyph pixels into one cache row
+parameter:
+    Bpp    : Bits per pixel of the image
+    Opaque : Write clear bits with Bg, otherwise leave them as they are
+    Dst    : Byte holding the first pixel
+    Shift  : Bit position of the first pixel in that byte, from the top
+    Bits   : Pixels, MSB first, padded to whole bytes
+    Count  : Number of pixels
+    FgWord : Color of set bits, in every pixel of the word
+    BgWord : Color of clear bits, in every pixel of the word
+info:
+    Eight pixels per source byte, which land on Bpp bytes of the row: the
+    byte's pixel mask selects between the foreground and background words,
+    and the result goes out as whole bytes. A start inside a byte moves the
+    words down by Shift bits, carrying into the next word.
+******************************************************************************/
+template <UBYTE Bpp, bool Opaque>
+static void Paint_BlitRow(UBYTE *Dst, UBYTE Shift, const UBYTE *Bits, UWORD Count,
+                          uint32_t FgWord, uint32_t BgWord)
+{
+    const UBYTE Chunk = Bpp;    // Row bytes per source byte
+    const uint32_t Full = Paint_TopBits(8 * Chunk);
+    UWORD Bytes = (Shift + Count * Bpp + 7) / 8;
+    UWORD Sources = (Count + 7) / 8;
+    uint32_t CarryValue = 0, CarryWrite = 0;
+
+    for (UWORD j = 0; j * Chunk < Bytes; j++) {
+        uint32_t Mask = 0, Keep = 0;
+        if (j < Sources) {
+            UWORD Left = Count - j * 8;
+            Mask = Paint_GlyphMask<Bpp>(Bits[j]);
+            Keep = (Left >= 8) ? Full : Paint_TopBits(Left * Bpp);
+        }
+        uint32_t Value = ((FgWord & Mask) | (BgWord & ~Mask)) & Full;
+        uint32_t Write = Opaque ? Keep : (Mask & Keep);
+        if (Shift) {
+            uint32_t NextValue = Value << (8 * Chunk - Shift);
+            uint32_t NextWrite = Write << (8 * Chunk - Shift);
+            Value = (Value >> Shift) | CarryValue;
+            Write = (Write >> Shift) | CarryWrite;
+            CarryValue = NextValue;
+            CarryWrite = NextWrite;
+        }
+        Paint_PutWord(Dst + j * Chunk, Value, Write, (Bytes - j * Chunk < Chunk) ? Bytes - j * Chunk : Chunk);
+    }
+}
+
+/******************************************************************************
+function: Transpose a glyph so its columns become rows
+parameter:
+    ptr    : First byte of the glyph, rows of RowBytes bytes
+    Width  : Glyph width
+    Height : Glyph height
+    Out    : Width rows of (Height + 7) / 8 bytes, MSB first from the top
+info:
+    8x8 blocks at a time, with the three-step bit matrix transpose from
+    Hacker's Delight (7-8)
+******************************************************************************/
+static void Paint_TransposeGlyph(const unsigned char *ptr, UWORD Width, UWORD Height, UBYTE *Out)
+{
+    UWORD RowBytes = Width / 8 + (Width % 8 ? 1 : 0);
+    UWORD OutBytes = (Height + 7) / 8;
+
+    for (UWORD Page = 0; Page < Height; Page += 8) {
+        for (UWORD Block = 0; Block < RowBytes; Block++) {
+            uint64_t x = 0;
+            for (UWORD i = 0; i < 8; i++) {
+                x <<= 8;
+                if (Page + i < Height)
+                    x |= ptr[(Page + i) * RowBytes + Block];
+            }
+            uint64_t t;
+            t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+            x = x ^ t ^ (t << 7);
+            t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+            x = x ^ t ^ (t << 14);
+            t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+            x = x ^ t ^ (t << 28);
+            for (UWORD i = 0; i < 8 && Block * 8 + i < Width; i++)
+                Out[(Block * 8 + i) * OutBytes + Page / 8] = x >> (56 - 8 * i);
+        }
+    }
+}
+
+/******************************************************************************
+function: Blit a 1-bit glyph into a 1, 2 or 4-bit image
+parameter:
+    Painter          : Painter for the current rotation and mirror
+    Xpoint           : X coordinate
+    Ypoint           : Y coordinate
+    ptr              : First byte of the glyph
+    Width            : Glyph width
+    Height           : Glyph height
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
+info:
+    Each glyph row lands on one memory row, or each glyph column with 90/270
+    rotation (the glyph is transposed first). Runs that go right to left in
+    memory are bit-reversed. Colors are packed the way Paint_SetPixel()
+    packs them. Returns false, drawing nothing, when the glyph touches the
+    image edge or, at 4 bits, a color does not fit a nibble, so that
+    Paint_SetPixel()'s clipping and packing still apply there.
 ******************************************************************************/
-void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
-                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+template <class P>
+static bool Paint_BlitGlyph(P Painter, UWORD Xpoint, UWORD Ypoint, const unsigned char *ptr,
+                            UWORD Width, UWORD Height, UWORD Color_Foreground, UWORD Color_Background)
 {
-    UWORD Page, Column;
+    bool Opaque = (FONT_BACKGROUND != Color_Background);
+    if (P::Depth == 4 && (Color_Foreground > 0x0F || (Opaque && Color_Background > 0x0F)))
+        return false;
+    if (Width == 0 || Height == 0 || Width > GLYPH_MAX_SPAN || Height > GLYPH_MAX_SPAN ||
+        (UDOUBLE)Xpoint + Width > Paint.Width || (UDOUBLE)Ypoint + Height > Paint.Height)
+        return false;
 
-    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
-        Debug("Paint_DrawChar Input exceeds the normal display range\r\n");
-        return;
+    //Runs of pixels sharing a memory row
+    UWORD Runs = P::Transposed ? Width : Height;
+    UWORD Length = P::Transposed ? Height : Width;
+    UWORD Stride = (Length + 7) / 8;
+    UBYTE Columns[P::Transposed ? GLYPH_MAX_SPAN * GLYPH_MAX_SPAN / 8 : 1];
+    const UBYTE *Source = ptr;
+    if (P::Transposed) {
+        Paint_TransposeGlyph(ptr, Width, Height, Columns);
+        Source = Columns;
     }
 
-    uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
-    const unsigned char *ptr = &Font->table[Char_Offset];
+    //Every run covers the same memory columns; the memory row moves by
+    //one per run, up or down
+    UWORD XFirst, YFirst, XLast, YLast, XNext, YNext;
+    Painter.Map(Xpoint, Ypoint, XFirst, YFirst);
+    if (P::Transposed) {
+        Painter.Map(Xpoint, Ypoint + Length - 1, XLast, YLast);
+        Painter.Map(Xpoint + 1, Ypoint, XNext, YNext);
+    } else {
+        Painter.Map(Xpoint + Length - 1, Ypoint, XLast, YLast);
+        Painter.Map(Xpoint, Ypoint + 1, XNext, YNext);
+    }
+    bool Reversed = (XFirst > XLast);
+    UWORD XStart = Reversed ? XLast : XFirst;
+    int Step = (YNext == YFirst + 1) ? 1 : -1;
+
+    UBYTE Shift = (XStart % P::PerByte) * P::Depth;
+    uint32_t FgWord = Paint_ColorWord<P::Depth>(Color_Foreground);
+    uint32_t BgWord = Paint_ColorWord<P::Depth>(Color_Background);
+
+    UBYTE Line[GLYPH_MAX_SPAN / 8];
+    UBYTE Pad = Stride * 8 - Length;
+    int Y = YFirst;
+    for (UWORD Run = 0; Run < Runs; Run++, Y += Step) {
+        //Outside the band being rendered
+        if (Y < Paint.BandStart || Y >= Paint.BandStart + Paint.BandRows)
+            continue;
+
+        const UBYTE *Bits = Source + Run * Stride;
+        if (Reversed) {
+            //Right to left in memory: reverse the bytes and their bits, then
+            //drop the padding that is now in front
+            for (UWORD j = 0; j < Stride; j++) {
+                UBYTE Current = Glyph_Lut.Reverse[Bits[Stride - 1 - j]];
+                UBYTE Next = (j + 1 < Stride) ? Glyph_Lut.Reverse[Bits[Stride - 2 - j]] : 0;
+                Line[j] = Pad ? (Current << Pad) | (Next >> (8 - Pad)) : Current;
+            }
+            Bits = Line;
+        }
+        UBYTE *Dst = Paint.Image + (UDOUBLE)(Y - Paint.BandStart) * Paint.WidthByte + XStart / P::PerByte;
+        if (Opaque)
+            Paint_BlitRow<P::Depth, true>(Dst, Shift, Bits, Length, FgWord, BgWord);
+        else
+            Paint_BlitRow<P::Depth, false>(Dst, Shift, Bits, Length, FgWord, BgWord);
+    }
+    return true;
+}
+
+/******************************************************************************
+function: Draw a 1-bit glyph, rows padded to whole bytes, MSB first
+parameter:
+    Painter          : Painter for the current rotation, mirror and scale
+    Xpoint           : X coordinate
+    Ypoint           : Y coordinate
+    ptr              : First byte of the glyph
+    Width            : Glyph width
+    Height           : Glyph height
+    Color_Foreground : Select the foreground color
+    Color_Background : Select the background color
+info:
+    Glyphs take the blitter above; the pixel loop handles glyphs on the
+    image edge
+******************************************************************************/
+template <class P>
+static void Paint_DrawGlyph(P Painter, UWORD Xpoint, UWORD Ypoint, const unsigned char *ptr,
+                            UWORD Width, UWORD Height, UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD Page, Column;
+
+    if (Paint_BlitGlyph(Painter, Xpoint, Ypoint, ptr, Width, Height, Color_Foreground, Color_Background))
+        return;
 
-    for (Page = 0; Page < Font->Height; Page ++ ) {
-        for (Column = 0; Column < Font->Width; Column ++ ) {
+    for (Page = 0; Page < Height; Page ++ ) {
+        for (Column = 0; Column < Width; Column ++ ) {
 
             //To determine whether the font background color and screen background color is consistent
             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
                 if (*ptr & (0x80 >> (Column % 8)))
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                    Painter.SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
             } else {
                 if (*ptr & (0x80 >> (Column % 8))) {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                    Painter.SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
                 } else {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                    Painter.SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
                 }
             }
             //One pixel is 8 bits
             if (Column % 8 == 7)
                 ptr++;
         }// Write a line
-        if (Font->Width % 8 != 0)
+        if (Width % 8 != 0)
             ptr++;
     }// Write all
 }
 
+/******************************************************************************
+function: Show English characters
+parameter:
+    Xpoint           ：X coordinate
+    Ypoint           ：Y coordinate
+    Acsii_Char       ：To display the English characters
+    Font             ：A structure pointer that displays a character size
+    Color_Foreground : Select the foreground color
+    Color_Background : Select the background color
+******************************************************************************/
+void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+        Debug("Paint_DrawChar Input exceeds the normal display range\r\n");
+        return;
+    }
+
+    uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
+    const unsigned char *ptr = &Font->table[Char_Offset];
+
+    Paint_Dispatch([&](auto P) {
+        Paint_DrawGlyph(P, Xpoint, Ypoint, ptr, Font->Width, Font->Height, Color_Foreground, Color_Background);
+    });
+}
+
 /******************************************************************************
 function:	Display the string
 parameter:
@@ -598,114 +976,119 @@ void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
 }
 
 
+/******************************************************************************
+function: Decode one UTF-8 character
+parameter:
+    pString   : First byte of the character
+    Codepoint : Receives the Unicode codepoint, U+FFFD for a malformed byte
+return:
+    Number of bytes used, at least 1
+info:
+    Continuation bytes are checked before being used, so a truncated
+    sequence never reads past the terminating 0
+******************************************************************************/
+static UBYTE Paint_DecodeUTF8(const char *pString, UDOUBLE *Codepoint)
+{
+    UBYTE Lead = *pString;
+    UBYTE Length;
+
+    if (Lead < 0x80) {
+        *Codepoint = Lead;
+        return 1;
+    } else if ((Lead & 0xE0) == 0xC0) {
+        *Codepoint = Lead & 0x1F;
+        Length = 2;
+    } else if ((Lead & 0xF0) == 0xE0) {
+        *Codepoint = Lead & 0x0F;
+        Length = 3;
+    } else if ((Lead & 0xF8) == 0xF0) {
+        *Codepoint = Lead & 0x07;
+        Length = 4;
+    } else {
+        *Codepoint = 0xFFFD;
+        return 1;
+    }
+
+    for (UBYTE i = 1; i < Length; i++) {
+        UBYTE Next = pString[i];
+        if ((Next & 0xC0) != 0x80) {
+            *Codepoint = 0xFFFD;
+            return i;
+        }
+        *Codepoint = (*Codepoint << 6) | (Next & 0x3F);
+    }
+    return Length;
+}
+
+/******************************************************************************
+function: Find the glyph of a codepoint
+parameter:
+    font      : Font to search
+    Codepoint : Unicode codepoint
+return:
+    The glyph, or NULL when the font does not have it
+info:
+    font->codepoints is sorted by scripts/gen_font.py, so this is a binary
+    search: about 13 probes for a 7000-glyph GB2312 font
+******************************************************************************/
+static const CH_GLYPH *Paint_FindGlyph(const cFONT *font, UDOUBLE Codepoint)
+{
+    UWORD Low = 0, High = font->size;
+
+    while (Low < High) {
+        UWORD Mid = Low + (High - Low) / 2;
+        if (font->codepoints[Mid] < Codepoint)
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+    if (Low < font->size && font->codepoints[Low] == Codepoint)
+        return &font->glyphs[Low];
+    return NULL;
+}
+
 /******************************************************************************
 function: Display the string
 parameter:
     Xstart  ：X coordinate
     Ystart  ：Y coordinate
-    pString ：The first address of the Chinese string and English
-              string to be displayed
+    pString ：The first address of the UTF-8 string to be displayed
     Font    ：A structure pointer that displays a character size
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
+info:
+    ASCII characters advance by font->ASCII_Width, others by font->Width.
+    Characters missing from the font leave their cell untouched. Glyphs
+    are stored trimmed to their ink box, the rest of the cell is filled
+    with the background
 ******************************************************************************/
 void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
                         UWORD Color_Foreground, UWORD Color_Background)
 {
     const char* p_text = pString;
     int x = Xstart, y = Ystart;
-    int i, j,Num;
-    // for (size_t i = 0; p_text[i] != 0; i++)
-    // {
-    //     Serial.println(*(p_text+i)&0xff, HEX);
-    //     Serial.println(i);
-    //      if((*(p_text+i)&0xff) <= 0x7F)
-    //      {
-    //         Serial.println("111111");
-    //      }
-    //      else{
-    //         Serial.println("222222");
-    //      }
-    // }
-    
 
     /* Send the string character by character on EPD */
     while (*p_text != 0) {
-        if((*p_text&0xff) <= 0x7F) {  //ASCII < 126
-            for(Num = 0; Num < font->size; Num++) {
-                if(*p_text== font->table[Num].index[0]) {
-                    const unsigned char* ptr = &font->table[Num].matrix[0];
-
-                    for (j = 0; j < font->Height; j++) {
-                        for (i = 0; i < font->Width; i++) {
-                            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            } else {
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            }
-                            if (i % 8 == 7) {
-                                ptr++;
-                            }
-                        }
-                        if (font->Width % 8 != 0) {
-                            ptr++;
-                        }
-                    }
-                    break;
-                }
-            }
-            /* Point on the next character */
-            p_text += 1;
-            /* Decrement the column position by 16 */
-            x += font->ASCII_Width;
-        } else {        //Chinese
-            for(Num = 0; Num < font->size; Num++) {
-                if ((((*p_text)&0xFF) == font->table[Num].index[0]) && \
-                    (((*(p_text + 1))&0xFF) == font->table[Num].index[1]) && \
-                    (((*(p_text + 2))&0xFF) == font->table[Num].index[2])) {
-                    const unsigned char* ptr = &font->table[Num].matrix[0];
-
-                    for (j = 0; j < font->Height; j++) {
-                        for (i = 0; i < font->Width; i++) {
-                            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            } else {
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            }
-                            if (i % 8 == 7) {
-                                ptr++;
-                            }
-                        }
-                        if (font->Width % 8 != 0) {
-                            ptr++;
-                        }
-                    }
-                    break;
-                }
+        UDOUBLE Codepoint;
+        p_text += Paint_DecodeUTF8(p_text, &Codepoint);
+
+        const CH_GLYPH *Glyph = Paint_FindGlyph(font, Codepoint);
+        if (Glyph != NULL) {
+            if (Color_Background != FONT_BACKGROUND)
+                Paint_FillArea(x, y, x + font->Width - 1, y + font->Height - 1, Color_Background);
+
+            if (Glyph->width != 0) {
+                const unsigned char* ptr = &font->bitmap[Glyph->offset];
+                Paint_Dispatch([&](auto P) {
+                    Paint_DrawGlyph(P, x + Glyph->left, y + Glyph->top, ptr, Glyph->width, Glyph->height,
+                                    Color_Foreground, FONT_BACKGROUND);
+                });
             }
-            /* Point on the next character */
-            p_text += 3;
-            /* Decrement the column position by 16 */
-            x += font->Width;
         }
+
+        /* Point on the next character */
+        x += Codepoint < 0x80 ? font->ASCII_Width : font->Width;
     }
 }
 
@@ -814,20 +1197,22 @@ info:
 ******************************************************************************/
 void Paint_DrawBitMap_Paste(const unsigned char* image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor)
 {
-    UBYTE color, srcImage;
-    UWORD x, y;
     UWORD width = (imageWidth%8==0 ? imageWidth/8 : imageWidth/8+1);
-    
-    for (y = 0; y < imageHeight; y++) {
-        for (x = 0; x < imageWidth; x++) {
-            srcImage = image_buffer[y*width + x/8];
-            if(flipColor)
-                color = (((srcImage<<(x%8) & 0x80) == 0) ? 1 : 0);
-            else
-                color = (((srcImage<<(x%8) & 0x80) == 0) ? 0 : 1);
-            Paint_SetPixel(x+xStart, y+yStart, color);
+
+    Paint_Dispatch([&](auto P) {
+        UBYTE color, srcImage;
+        UWORD x, y;
+        for (y = 0; y < imageHeight; y++) {
+            for (x = 0; x < imageWidth; x++) {
+                srcImage = image_buffer[y*width + x/8];
+                if(flipColor)
+                    color = (((srcImage<<(x%8) & 0x80) == 0) ? 1 : 0);
+                else
+                    color = (((srcImage<<(x%8) & 0x80) == 0) ? 0 : 1);
+                P.SetPixel(x+xStart, y+yStart, color);
+            }
         }
-    }
+    });
 }
 
 /******************************************************************************
@@ -6,212 +6,421 @@
 #include "wifi_config.h"
 #include <mbedtls/sha256.h>
 #include <Stream.h>
+#include "trace.h"
+#include "image_format.h"
 
-String APIClient::parseUrl(const String& url, String& host, String& path) {
-  String urlStr = url;
-  if (urlStr.startsWith("https://")) {
-    urlStr = urlStr.substring(8);
-  }
-  
-  int slashIndex = urlStr.indexOf('/');
-  if (slashIndex > 0) {
-    host = urlStr.substring(0, slashIndex);
-    path = urlStr.substring(slashIndex);
-  } else {
-    host = urlStr;
+#define URL_HOST_MAX_LEN 128
+#define URL_PATH_MAX_LEN 384  // Room for outbox parameters on the version check
+#define RETRY_AFTER_MAX_LEN 10  // Delay-seconds of a Retry-After header (uint32)
+
+// Scratch memory for parsed JSON documents, reset before every request
+static uint8_t jsonArenaBuffer[JSON_ARENA_SIZE];
+static BumpArena jsonArena(jsonArenaBuffer, sizeof(jsonArenaBuffer));
+
+// ArduinoJson allocator backed by jsonArena - documents never touch the heap
+class JsonArenaAllocator : public ArduinoJson::Allocator {
+public:
+  void* allocate(size_t size) override { return jsonArena.allocate(size); }
+  void deallocate(void*) override {}
+  void* reallocate(void* ptr, size_t newSize) override { return jsonArena.reallocate(ptr, newSize); }
+};
+static JsonArenaAllocator jsonAllocator;
+
+int APIClient::lastHttpCode = 0;
+uint32_t APIClient::lastRetryAfter = 0;
+
+// Request bodies are serialized into this buffer instead of a String
+static char requestBuffer[256 + SIGNED_URL_BATCH_SIZE * (IMAGE_ID_MAX_LEN + 3)];
+
+bool APIClient::parseUrl(const char* url, char* host, size_t hostSize, const char*& path) {
+  if (strncmp(url, "https://", 8) == 0) {
+    url += 8;
+  }
+
+  const char* slash = strchr(url, '/');
+  size_t hostLength = slash ? (size_t)(slash - url) : strlen(url);
+  if (hostLength >= hostSize) {
+    host[0] = '\0';
     path = "/";
+    return false;
+  }
+
+  memcpy(host, url, hostLength);
+  host[hostLength] = '\0';
+  path = slash ? slash : "/";
+  return true;
+}
+
+// Build "<path of baseUrl>?device_id=..&device_key=..<extra>" into a fixed buffer
+static bool buildDeviceQuery(const char* baseUrl, const char* deviceId, const char* deviceKey,
+                             char* host, char* path, const char* extra = "") {
+  const char* basePath;
+  if (!APIClient::parseUrl(baseUrl, host, URL_HOST_MAX_LEN, basePath)) {
+    return false;
   }
-  
-  return host;
+  int written = snprintf(path, URL_PATH_MAX_LEN, "%s?device_id=%s&device_key=%s%s",
+                         basePath, deviceId, deviceKey, extra);
+  return written > 0 && written < URL_PATH_MAX_LEN;
 }
 
-String APIClient::calculateSHA256(const uint8_t* data, size_t length) {
-  uint8_t hash[32];
+void APIClient::beginRequest(HTTPClient& http) {
+  static const char* headerKeys[] = {"Retry-After"};
+  http.collectHeaders(headerKeys, 1);
+  lastHttpCode = 0;
+  lastRetryAfter = 0;
+}
+
+void APIClient::endRequest(HTTPClient& http, int httpCode) {
+  lastHttpCode = httpCode;
+  if (!http.hasHeader("Retry-After")) {
+    return;
+  }
+  // Only the delay-seconds form; an HTTP-date falls back to the client's
+  // backoff. HTTPClient hands headers out as String - a value this short
+  // stays in its inline buffer and is copied out at once.
+  char retryAfter[RETRY_AFTER_MAX_LEN + 1];
+  if (!copyFixedString(retryAfter, sizeof(retryAfter), http.header("Retry-After").c_str())) {
+    return;
+  }
+  char* end;
+  unsigned long seconds = strtoul(retryAfter, &end, 10);
+  if (isDigit(retryAfter[0]) && *end == '\0') {
+    lastRetryAfter = (seconds > UINT32_MAX) ? UINT32_MAX : (uint32_t)seconds;
+  }
+}
+
+void APIClient::calculateSHA256(const uint8_t* data, size_t length, uint8_t hash[IMAGE_HASH_BYTES]) {
   mbedtls_sha256_context ctx;
   mbedtls_sha256_init(&ctx);
   mbedtls_sha256_starts(&ctx, 0);
   mbedtls_sha256_update(&ctx, data, length);
   mbedtls_sha256_finish(&ctx, hash);
   mbedtls_sha256_free(&ctx);
-  
-  String result = "";
-  for (int i = 0; i < 32; i++) {
-    if (hash[i] < 0x10) result += "0";
-    result += String(hash[i], HEX);
-  }
-  return result;
 }
 
-bool APIClient::getSlideshowVersion(const String& deviceId, const String& deviceKey, SlideshowVersionResponse& response) {
+bool APIClient::getSlideshowVersion(const char* deviceId, const char* deviceKey, SlideshowVersionResponse& response,
+                                    const char* extraQuery) {
+  TRACE_SCOPE("api.version");
   WiFiClientSecure client;
   HTTPClient http;
   client.setInsecure();
-  
-  String host, path;
-  parseUrl(String(GET_SLIDESHOW_VERSION_URL), host, path);
-  path += "?device_id=" + deviceId + "&device_key=" + deviceKey;
-  
-  http.begin(client, host.c_str(), 443, path.c_str());
+
+  char host[URL_HOST_MAX_LEN];
+  char path[URL_PATH_MAX_LEN];
+  if (!buildDeviceQuery(GET_SLIDESHOW_VERSION_URL, deviceId, deviceKey, host, path, extraQuery)) {
+    return false;
+  }
+
+  http.begin(client, host, 443, path);
+  beginRequest(http);
   http.setTimeout(10000);
-  
+  http.useHTTP10(true);  // No chunked encoding, so JSON can be parsed straight from the stream
+
   int httpCode = http.GET();
+  endRequest(http, httpCode);
   bool success = false;
-  
+
   if (httpCode == 200) {
-    String payload = http.getString();
-    StaticJsonDocument<200> doc;
-    DeserializationError error = deserializeJson(doc, payload);
-    
+    jsonArena.reset();
+    JsonDocument doc(&jsonAllocator);
+    DeserializationError error = deserializeJson(doc, http.getStream());
+
     if (!error) {
       response.slideshowVersion = doc["slideshowVersion"] | 0;
-      response.status = doc["status"] | "NO_CHANGE";
+      copyFixedString(response.status, sizeof(response.status), doc["status"] | "NO_CHANGE");
+      response.nextCheckSeconds = doc["nextCheckSeconds"] | 0UL;
+      response.checkSpreadSeconds = doc["checkSpreadSeconds"] | 0UL;
+      response.serverTime = doc["serverTime"] | (int64_t)0;
+      response.hasUtcOffset = !doc["utcOffsetSeconds"].isNull();
+      response.utcOffsetSeconds = doc["utcOffsetSeconds"] | 0;
+      response.outboxAccepted = doc["outboxAccepted"] | false;
       response.success = true;
       success = true;
     }
   }
-  
+
   http.end();
   return success;
 }
 
-bool APIClient::getSlideshowManifest(const String& deviceId, const String& deviceKey, SlideshowManifestResponse& response) {
+// "nearest" (default) or "dither", how an image smaller than it is shown is enlarged
+static uint8_t parseFilter(JsonVariantConst json) {
+  const char* filter = json | "nearest";
+  return strcmp(filter, "dither") == 0 ? IMAGE_FILTER_DITHER : IMAGE_FILTER_NEAREST;
+}
+
+// A composed view of the manifest ("imageViews"), e.g.
+//   {"background": 1, "hidden": false, "tiles": [
+//     {"image": 0, "x": 0, "y": 0, "w": 200, "h": 300, "sx": 100, "sy": 0},
+//     {"image": 2, "x": 200, "y": 0, "w": 200, "h": 300, "scale": 2, "filter": "dither"},
+//     {"fill": 1, "x": 200, "y": 300, "w": 200, "h": 300}]}
+// Tiles without "scale" enlarge their image by its own scale.
+// Returns its 1-based index in response.views, 0 if there is none or no room.
+static uint8_t parseView(JsonVariantConst json, SlideshowManifestResponse& response) {
+  if (!json.is<JsonObjectConst>() || response.viewCount >= COMPOSE_MAX_VIEWS) {
+    return 0;
+  }
+  ImageView& view = response.views[response.viewCount];
+  view.flags = (json["hidden"] | false) ? VIEW_HIDDEN : 0;
+  view.background = json["background"] | 1;  // White
+  view.tileCount = 0;
+  for (JsonObjectConst item : json["tiles"].as<JsonArrayConst>()) {
+    if (view.tileCount == COMPOSE_MAX_TILES) {
+      break;
+    }
+    ViewTile& tile = view.tiles[view.tileCount];
+    if (!item["fill"].isNull()) {
+      tile.type = VIEW_TILE_FILL;
+      tile.color = item["fill"] | 0;
+      tile.image = 0;
+    } else if (!item["image"].isNull()) {
+      tile.type = VIEW_TILE_IMAGE;
+      tile.color = 0;
+      tile.image = item["image"] | 0;
+    } else {
+      continue;
+    }
+    tile.x = item["x"] | 0;
+    tile.y = item["y"] | 0;
+    tile.width = item["w"] | 0;
+    tile.height = item["h"] | 0;
+    tile.sourceX = item["sx"] | 0;
+    tile.sourceY = item["sy"] | 0;
+    int scale = item["scale"] | 0;
+    tile.scale = scale;
+    tile.filter = parseFilter(item["filter"]);
+    // Tiles have to start and end on a byte of the panel, and of the
+    // source when it is copied as is
+    if ((tile.x | tile.width) & 1 || (scale <= 1 && tile.sourceX & 1) || scale < 0 || scale > COMPOSE_MAX_SCALE) {
+      continue;
+    }
+    view.tileCount++;
+  }
+  return ++response.viewCount;
+}
+
+bool APIClient::getSlideshowManifest(const char* deviceId, const char* deviceKey, int offset, int limit,
+                                     SlideshowManifestResponse& response) {
+  TRACE_SCOPE("api.manifest");
   WiFiClientSecure client;
   HTTPClient http;
   client.setInsecure();
-  
-  String host, path;
-  parseUrl(String(GET_SLIDESHOW_MANIFEST_URL), host, path);
-  path += "?device_id=" + deviceId + "&device_key=" + deviceKey;
-  
-  http.begin(client, host.c_str(), 443, path.c_str());
+
+  if (offset < 0 || offset >= SlideshowManifestResponse::capacity) {
+    return false;
+  }
+  if (limit > SlideshowManifestResponse::capacity - offset) {
+    limit = SlideshowManifestResponse::capacity - offset;
+  }
+
+  char host[URL_HOST_MAX_LEN];
+  char path[URL_PATH_MAX_LEN];
+  // Paging, and the image containers and codecs this firmware reads so
+  // the server only links formats it can show (older servers send raw)
+  char codecs[32];
+  char query[96];
+  ImageFormat::codecList(codecs, sizeof(codecs));
+  snprintf(query, sizeof(query), "&offset=%d&limit=%d&container=%d&codecs=%s", offset, limit, IMAGE_FORMAT_VERSION,
+           codecs);
+  if (!buildDeviceQuery(GET_SLIDESHOW_MANIFEST_URL, deviceId, deviceKey, host, path, query)) {
+    return false;
+  }
+
+  http.begin(client, host, 443, path);
+  beginRequest(http);
   http.setTimeout(10000);
-  
+  http.useHTTP10(true);
+
   int httpCode = http.GET();
+  endRequest(http, httpCode);
   bool success = false;
-  
+
   if (httpCode == 200) {
-    String payload = http.getString();
-    StaticJsonDocument<2048> doc;
-    DeserializationError error = deserializeJson(doc, payload);
-    
+    jsonArena.reset();
+    JsonDocument doc(&jsonAllocator);
+    DeserializationError error = deserializeJson(doc, http.getStream());
+
     if (!error) {
       response.slideshowVersion = doc["slideshowVersion"] | 0;
-      
+
       JsonArray imageIds = doc["imageIds"];
       JsonArray imageHashes = doc["imageHashes"];
-      
-      response.imageCount = 0;
-      int maxCount = (imageIds.size() < 12) ? imageIds.size() : 12;
-      
+      JsonArray imageDwell = doc["imageDwellSeconds"];
+      // Optional: [width, height] of images that are not panel-size, how
+      // many panel pixels a stored pixel covers (2 for a 200x300 image
+      // shown full screen), and views composing the panel from several images
+      JsonArray imageSizes = doc["imageSizes"];
+      JsonArray imageScales = doc["imageScales"];
+      JsonArray imageFilters = doc["imageFilters"];
+      JsonArray imageViews = doc["imageViews"];
+      if (offset == 0) {
+        response.viewCount = 0;
+      }
+      // Per-image dwell overrides the slideshow default, both in seconds
+      uint32_t defaultDwell = doc["dwellSeconds"] | 0UL;
+
+      // Servers without paging ignore offset/limit, return the whole list
+      // and no totalImages - take as much of it as fits
+      int received = (int)imageIds.size();
+      bool paged = !doc["totalImages"].isNull();
+      int room = paged ? limit : SlideshowManifestResponse::capacity - offset;
+      response.totalCount = paged ? (doc["totalImages"] | 0) : offset + received;
+      response.imageCount = offset;
+      int maxCount = (received < room) ? received : room;
+
       for (int i = 0; i < maxCount; i++) {
-        response.imageIds[i] = imageIds[i].as<String>();
-        response.imageHashes[i] = imageHashes[i].as<String>();
+        int index = offset + i;
+        copyFixedString(response.imageIds[index], sizeof(response.imageIds[index]), imageIds[i] | "");
+        if (!hexToBytes(imageHashes[i] | "", response.imageHashes[index], IMAGE_HASH_BYTES)) {
+          memset(response.imageHashes[index], 0, IMAGE_HASH_BYTES);
+        }
+        uint32_t dwell = imageDwell[i] | defaultDwell;
+        uint32_t minutes = (dwell + 59) / 60;
+        response.dwellMinutes[index] = (minutes > UINT16_MAX) ? UINT16_MAX : (uint16_t)minutes;
+        ImageLayout& layout = response.layouts[index];
+        layout.width = imageSizes[i][0] | DISPLAY_WIDTH;
+        layout.height = imageSizes[i][1] | DISPLAY_HEIGHT;
+        int scale = imageScales[i] | 1;
+        layout.scale = (scale >= 1 && scale <= COMPOSE_MAX_SCALE) ? scale : 1;
+        layout.filter = parseFilter(imageFilters[i]);
+        // No image id (a view of other entries) or too large to store:
+        // nothing is downloaded for this entry
+        if (response.imageIds[index][0] == '\0' || imageStoredBytes(layout) > IMAGE_MAX_BYTES) {
+          layout.width = 0;
+          layout.height = 0;
+        }
+        layout.view = parseView(imageViews[i], response);
         response.imageCount++;
       }
-      
+
       response.success = true;
       success = true;
     }
   }
-  
+
   http.end();
   return success;
 }
 
-bool APIClient::getSignedUrls(const String& deviceId, const String& deviceKey, const String* imageIds, int count, SignedUrlsResponse& response) {
+bool APIClient::getSignedUrls(const char* deviceId, const char* deviceKey, const ImageId* imageIds, int count,
+                              BumpArena& urlArena, SignedUrlsResponse& response) {
+  TRACE_SCOPE("api.signedUrls");
   WiFiClientSecure client;
   HTTPClient http;
   client.setInsecure();
-  
-  String host, path;
-  parseUrl(String(GET_SIGNED_URLS_URL), host, path);
-  
+
+  char host[URL_HOST_MAX_LEN];
+  const char* path;
+  if (!parseUrl(GET_SIGNED_URLS_URL, host, sizeof(host), path)) {
+    return false;
+  }
+  if (count > SignedUrlsResponse::capacity) {
+    count = SignedUrlsResponse::capacity;
+  }
+
   // Build JSON request
-  StaticJsonDocument<2048> doc;
-  doc["device_id"] = deviceId;
-  doc["device_key"] = deviceKey;
-  JsonArray imageIdsArray = doc.createNestedArray("imageIds");
-  for (int i = 0; i < count; i++) {
-    imageIdsArray.add(imageIds[i]);
-  }
-  
-  String requestBody;
-  serializeJson(doc, requestBody);
-  
-  http.begin(client, host.c_str(), 443, path.c_str());
+  jsonArena.reset();
+  size_t requestLength;
+  {
+    JsonDocument doc(&jsonAllocator);
+    doc["device_id"] = deviceId;
+    doc["device_key"] = deviceKey;
+    JsonArray imageIdsArray = doc["imageIds"].to<JsonArray>();
+    for (int i = 0; i < count; i++) {
+      imageIdsArray.add((const char*)imageIds[i]);
+    }
+    requestLength = serializeJson(doc, requestBuffer, sizeof(requestBuffer));
+  }
+  if (requestLength == 0 || requestLength >= sizeof(requestBuffer) - 1) {
+    return false;
+  }
+
+  http.begin(client, host, 443, path);
+  beginRequest(http);
   http.addHeader("Content-Type", "application/json");
   http.setTimeout(30000);
-  
-  int httpCode = http.POST(requestBody);
+  http.useHTTP10(true);
+
+  int httpCode = http.POST((uint8_t*)requestBuffer, requestLength);
+  endRequest(http, httpCode);
   bool success = false;
-  
+
   if (httpCode == 200) {
-    String payload = http.getString();
-    StaticJsonDocument<2048> responseDoc;
-    DeserializationError error = deserializeJson(responseDoc, payload);
-    
+    jsonArena.reset();
+    JsonDocument responseDoc(&jsonAllocator);
+    DeserializationError error = deserializeJson(responseDoc, http.getStream());
+
     if (!error) {
       response.count = 0;
       // The response is a JSON object mapping imageId -> signedUrl
       // We need to match the order of imageIds we sent
-      for (int i = 0; i < count && i < 12; i++) {
-        if (responseDoc.containsKey(imageIds[i])) {
-          response.urls[i] = responseDoc[imageIds[i]].as<String>();
+      for (int i = 0; i < count; i++) {
+        const char* url = responseDoc[(const char*)imageIds[i]] | (const char*)nullptr;
+        response.urls[i] = url ? urlArena.copyString(url, strlen(url)) : nullptr;
+        if (response.urls[i]) {
           response.count++;
-        } else {
-          // Missing URL for this imageId
-          response.urls[i] = "";
         }
       }
       response.success = (response.count == count);
       success = true;
     }
   }
-  
+
   http.end();
   return success;
 }
 
-bool APIClient::ackDisplayed(const String& deviceId, const String& deviceKey, int slideshowVersion) {
+bool APIClient::ackDisplayed(const char* deviceId, const char* deviceKey, int slideshowVersion) {
+  TRACE_SCOPE("api.ack");
   WiFiClientSecure client;
   HTTPClient http;
   client.setInsecure();
-  
-  String host, path;
-  parseUrl(String(ACK_DISPLAYED_URL), host, path);
-  
-  StaticJsonDocument<200> doc;
-  doc["device_id"] = deviceId;
-  doc["device_key"] = deviceKey;
-  doc["slideshow_version"] = slideshowVersion;
-  
-  String requestBody;
-  serializeJson(doc, requestBody);
-  
-  http.begin(client, host.c_str(), 443, path.c_str());
+
+  char host[URL_HOST_MAX_LEN];
+  const char* path;
+  if (!parseUrl(ACK_DISPLAYED_URL, host, sizeof(host), path)) {
+    return false;
+  }
+
+  int requestLength = snprintf(requestBuffer, sizeof(requestBuffer),
+                               "{\"device_id\":\"%s\",\"device_key\":\"%s\",\"slideshow_version\":%d}",
+                               deviceId, deviceKey, slideshowVersion);
+  if (requestLength <= 0 || requestLength >= (int)sizeof(requestBuffer)) {
+    return false;
+  }
+
+  http.begin(client, host, 443, path);
+  beginRequest(http);
   http.addHeader("Content-Type", "application/json");
   http.setTimeout(10000);
-  
-  int httpCode = http.POST(requestBody);
+
+  int httpCode = http.POST((uint8_t*)requestBuffer, requestLength);
+  endRequest(http, httpCode);
   http.end();
-  
+
   return httpCode == 200;
 }
 
-bool APIClient::downloadImage(const String& signedUrl, uint8_t* buffer, size_t bufferSize, size_t& bytesDownloaded) {
+bool APIClient::downloadImage(const char* signedUrl, uint8_t* buffer, size_t bufferSize, size_t& bytesDownloaded) {
+  TRACE_SCOPE("api.download");
   WiFiClientSecure client;
   HTTPClient http;
   client.setInsecure();
-  
-  String host, path;
-  parseUrl(signedUrl, host, path);
-  
-  http.begin(client, host.c_str(), 443, path.c_str());
+
+  char host[URL_HOST_MAX_LEN];
+  const char* path;
+  if (!parseUrl(signedUrl, host, sizeof(host), path)) {
+    return false;
+  }
+
+  http.begin(client, host, 443, path);
+  beginRequest(http);
   http.setTimeout(60000);  // 60 second timeout for image download
-  
+
   int httpCode = http.GET();
+  endRequest(http, httpCode);
   bytesDownloaded = 0;
-  
+
   if (httpCode == 200) {
     int contentLength = http.getSize();
     if (contentLength > 0 && contentLength <= (int)bufferSize) {
@@ -223,11 +432,18 @@ bool APIClient::downloadImage(const String& signedUrl, uint8_t* buffer, size_t b
       }
     }
   }
-  
+
   http.end();
   return httpCode == 200 && bytesDownloaded > 0;
 }
 
+int APIClient::getLastHttpCode() {
+  return lastHttpCode;
+}
+
+uint32_t APIClient::getLastRetryAfter() {
+  return lastRetryAfter;
+}
+
 // Note: This function returns a stream, but the caller must keep the HTTPClient alive
 // For proper streaming, we'll do it inline in the download function instead
-
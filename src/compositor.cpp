@@ -0,0 +1,351 @@
+#include "compositor.h"
+#include "flash_storage.h"
+#include "trace.h"
+
+#define LAYOUT_PATH "/layout.bin"
+#define LAYOUT_MAGIC 0x50504C31  // "PPL1"
+#define PANEL_ROW_BYTES (DISPLAY_WIDTH / 2)
+#define PANEL_WHITE 0x1
+
+// layout.bin: header, one ImageLayout per slideshow entry, then the views
+struct LayoutHeader {
+  uint32_t magic;
+  uint16_t count;
+  uint16_t viewCount;
+};
+
+static uint8_t fillPattern(uint8_t color) {
+  return (color & 0x0F) * 0x11;
+}
+
+// 4x4 Bayer matrix, thresholds 0-15
+static const uint8_t bayer4[4][4] = {
+  {0, 8, 2, 10},
+  {12, 4, 14, 6},
+  {3, 11, 1, 9},
+  {15, 7, 13, 5},
+};
+
+bool Compositor::saveLayouts(const ImageLayout* layouts, int count, const ImageView* views, int viewCount) {
+  if (count < 0 || count > UINT16_MAX || viewCount < 0 || viewCount > COMPOSE_MAX_VIEWS) return false;
+
+  size_t size = sizeof(LayoutHeader) + count * sizeof(ImageLayout) + viewCount * sizeof(ImageView);
+  uint8_t* buffer = (uint8_t*)malloc(size);
+  if (!buffer) return false;
+
+  LayoutHeader header = {LAYOUT_MAGIC, (uint16_t)count, (uint16_t)viewCount};
+  memcpy(buffer, &header, sizeof(header));
+  memcpy(buffer + sizeof(header), layouts, count * sizeof(ImageLayout));
+  memcpy(buffer + sizeof(header) + count * sizeof(ImageLayout), views, viewCount * sizeof(ImageView));
+  bool success = FlashStorage::writeFile(LAYOUT_PATH, buffer, size);
+  free(buffer);
+  return success;
+}
+
+bool Compositor::loadLayout(int index, ImageLayout& layout, ImageView* view) {
+  layout.width = DISPLAY_WIDTH;
+  layout.height = DISPLAY_HEIGHT;
+  layout.view = 0;
+  layout.scale = 1;
+  layout.filter = IMAGE_FILTER_NEAREST;
+
+  File file = FlashStorage::openFile(LAYOUT_PATH);
+  if (!file) {
+    return true;  // Slideshow stored before layouts existed
+  }
+
+  LayoutHeader header;
+  bool success = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && header.magic == LAYOUT_MAGIC;
+  if (success && index >= 0 && index < header.count) {
+    success = file.seek(sizeof(header) + index * sizeof(ImageLayout)) &&
+              file.read((uint8_t*)&layout, sizeof(layout)) == sizeof(layout) &&
+              layout.view <= header.viewCount && layout.scale >= 1 && layout.scale <= COMPOSE_MAX_SCALE;
+    if (success && view && layout.view > 0) {
+      size_t offset = sizeof(header) + header.count * sizeof(ImageLayout) + (layout.view - 1) * sizeof(ImageView);
+      success = file.seek(offset) && file.read((uint8_t*)view, sizeof(*view)) == sizeof(*view) &&
+                view->tileCount <= COMPOSE_MAX_TILES;
+    }
+  }
+  file.close();
+  return success;
+}
+
+bool Compositor::isHidden(int index) {
+  ImageLayout layout;
+  ImageView view;
+  return loadLayout(index, layout, &view) && layout.view > 0 && (view.flags & VIEW_HIDDEN);
+}
+
+// The whole image, enlarged by its scale, centered and cropped to the panel
+static void centerView(int index, const ImageLayout& layout, ImageView& view) {
+  ViewTile& tile = view.tiles[0];
+  uint32_t width = (uint32_t)layout.width * layout.scale;
+  uint32_t height = (uint32_t)layout.height * layout.scale;
+  tile.type = VIEW_TILE_IMAGE;
+  tile.color = 0;
+  tile.scale = layout.scale;
+  tile.filter = layout.filter;
+  tile.image = index;
+  if (width <= DISPLAY_WIDTH) {
+    // Odd widths take the padding nibble at the end of each row along
+    tile.width = (width + 1) & ~1;
+    tile.x = ((DISPLAY_WIDTH - tile.width) / 2) & ~1;
+    tile.sourceX = 0;
+  } else {
+    tile.x = 0;
+    tile.width = DISPLAY_WIDTH;
+    tile.sourceX = (width - DISPLAY_WIDTH) / 2 / layout.scale;
+  }
+  if (height <= DISPLAY_HEIGHT) {
+    tile.y = (DISPLAY_HEIGHT - height) / 2;
+    tile.height = height;
+    tile.sourceY = 0;
+  } else {
+    tile.y = 0;
+    tile.height = DISPLAY_HEIGHT;
+    tile.sourceY = (height - DISPLAY_HEIGHT) / 2 / layout.scale;
+  }
+  view.flags = 0;
+  view.background = PANEL_WHITE;
+  view.tileCount = 1;
+}
+
+// Clip a tile to the panel and to its source, so fillBand() only reads
+// rows and bytes that exist
+static void clipTile(ViewTile& tile, const ImageSource* source) {
+  tile.x &= ~1;
+  tile.width &= ~1;
+  if (tile.scale <= 1) {
+    tile.sourceX &= ~1;  // Copied byte for byte
+  }
+  if (tile.x >= DISPLAY_WIDTH || tile.y >= DISPLAY_HEIGHT) {
+    tile.height = 0;
+    return;
+  }
+  if (tile.width > DISPLAY_WIDTH - tile.x) tile.width = DISPLAY_WIDTH - tile.x;
+  if (tile.height > DISPLAY_HEIGHT - tile.y) tile.height = DISPLAY_HEIGHT - tile.y;
+  if (!source) return;
+
+  if (tile.sourceX >= source->width || tile.sourceY >= source->height) {
+    tile.height = 0;
+    return;
+  }
+  // Rows of odd-width images end on a padding nibble, a whole byte is written
+  uint32_t available = ((uint32_t)(source->width - tile.sourceX) * tile.scale + 1) & ~1;
+  uint32_t availableRows = (uint32_t)(source->height - tile.sourceY) * tile.scale;
+  if (tile.width > available) tile.width = available;
+  if (tile.height > availableRows) tile.height = availableRows;
+}
+
+ComposeResult Compositor::begin(int index, ComposeFrame& frame) {
+  TRACE_SCOPE("compose.open");
+  ImageLayout layout;
+  frame.sourceCount = 0;
+  frame.nextRow = 0;
+  if (!loadLayout(index, layout, &frame.view)) {
+    return COMPOSE_FAILED;
+  }
+  if (layout.view == 0) {
+    // The image says how it is shown, or the layout does for headerless ones
+    ImageSource& image = frame.sources[0];
+    if (layout.width == 0 || !ImageFormat::open(index, layout, image)) {
+      return COMPOSE_FAILED;
+    }
+    if (image.headerless && image.width == DISPLAY_WIDTH && image.height == DISPLAY_HEIGHT && image.scale == 1) {
+      image.file.close();
+      return COMPOSE_PLAIN;
+    }
+    frame.sourceImage[0] = index;
+    frame.sourceCount = 1;
+    ImageLayout shown = {image.width, image.height, 0, image.scale, image.filter};
+    centerView(index, shown, frame.view);
+  }
+
+  for (int i = 0; i < frame.view.tileCount; i++) {
+    ViewTile& tile = frame.view.tiles[i];
+    if (tile.type == VIEW_TILE_FILL) {
+      clipTile(tile, nullptr);
+      continue;
+    }
+    if (tile.type != VIEW_TILE_IMAGE) {
+      tile.height = 0;  // Unknown to this firmware, left out
+      continue;
+    }
+
+    int source = 0;
+    while (source < frame.sourceCount && frame.sourceImage[source] != tile.image) {
+      source++;
+    }
+    if (source == frame.sourceCount) {
+      ImageLayout sourceLayout = layout;
+      if ((tile.image != index && !loadLayout(tile.image, sourceLayout, nullptr)) ||
+          !ImageFormat::open(tile.image, sourceLayout, frame.sources[source])) {
+        end(frame);
+        return COMPOSE_FAILED;
+      }
+      frame.sourceImage[source] = tile.image;
+      frame.sourceCount++;
+    }
+    const ImageSource& image = frame.sources[source];
+    if (tile.scale == 0) {
+      tile.scale = image.scale;
+      tile.filter = image.filter;
+    } else if (tile.scale > COMPOSE_MAX_SCALE) {
+      tile.height = 0;
+      continue;
+    }
+    frame.tileSource[i] = source;
+    clipTile(tile, &image);
+  }
+  return COMPOSE_READY;
+}
+
+static inline uint8_t pixelAt(const uint8_t* row, int index) {
+  return (index & 1) ? (row[index >> 1] & 0x0F) : (row[index >> 1] >> 4);
+}
+
+// Which neighbour (-1, 0 or 1) the ordered dither picks for pixel `offset`
+// of a block of `scale` pixels, so that across many pixels the blocks
+// blend linearly into the next ones: position + threshold, rounded down,
+// in 1/32 pixels
+static inline int ditherStep(int offset, int scale, int threshold) {
+  int position = (2 * offset + 1 - scale) * 16 + (2 * threshold + 1) * scale;
+  return (position < 0) ? -1 : (position >= 32 * scale) ? 1 : 0;
+}
+
+// Source row `row` of a scaled tile, columns first to last, from the rows
+// already read for this band or from flash
+static const uint8_t* scaledRow(ComposeFrame& frame, int source, int row, int first, int last) {
+  int slot = 0;
+  for (int i = 0; i < 3; i++) {
+    if (frame.scaleRow[i] == row) {
+      return frame.scaleRows[i];
+    }
+    if (frame.scaleRow[i] < frame.scaleRow[slot]) {
+      slot = i;  // Rows are read top to bottom, replace the topmost
+    }
+  }
+  uint16_t bytes = last / 2 - first / 2 + 1;
+  if (!ImageFormat::readRows(frame.sources[source], row, 1, first / 2, bytes, frame.scaleRows[slot], bytes)) {
+    return nullptr;
+  }
+  frame.scaleRow[slot] = row;
+  return frame.scaleRows[slot];
+}
+
+// Rows top to bottom of a tile enlarged by its scale. Nearest repeats each
+// source pixel and row; dither picks each pixel from the source pixel or
+// its neighbour with a Bayer threshold.
+static bool fillScaled(ComposeFrame& frame, const ViewTile& tile, int source, uint16_t top, uint16_t bottom,
+                       uint8_t* dest) {
+  int scale = tile.scale;
+  int width = frame.sources[source].width;
+  int height = frame.sources[source].height;
+  // Columns read: the tile's and one either side, from a whole byte
+  int first = (tile.sourceX > 0 ? tile.sourceX - 1 : 0) & ~1;
+  int last = tile.sourceX + (tile.width - 1) / scale + 1;
+  if (last > width - 1) last = width - 1;
+  frame.scaleRow[0] = frame.scaleRow[1] = frame.scaleRow[2] = -1;
+
+  for (uint16_t y = top; y < bottom; y++, dest += PANEL_ROW_BYTES) {
+    int ty = y - tile.y;
+    int row = tile.sourceY + ty / scale;
+
+    if (tile.filter != IMAGE_FILTER_DITHER) {
+      if (y > top && ty % scale != 0) {
+        memcpy(dest, dest - PANEL_ROW_BYTES, tile.width / 2);  // Same source row
+        continue;
+      }
+      const uint8_t* pixels = scaledRow(frame, source, row, first, last);
+      if (!pixels) return false;
+      if (scale % 2 == 0) {
+        // Each source pixel is scale / 2 whole bytes
+        for (int x = 0, column = tile.sourceX; x < tile.width; x += scale, column++) {
+          int run = (tile.width - x < scale) ? tile.width - x : scale;
+          memset(dest + x / 2, fillPattern(pixelAt(pixels, column - first)), run / 2);
+        }
+      } else {
+        for (int x = 0; x < tile.width; x += 2) {
+          int left = tile.sourceX + x / scale;
+          int right = tile.sourceX + (x + 1) / scale;
+          if (left > last) left = last;
+          if (right > last) right = last;
+          dest[x / 2] = (pixelAt(pixels, left - first) << 4) | pixelAt(pixels, right - first);
+        }
+      }
+      continue;
+    }
+
+    const uint8_t* rows[3];
+    for (int i = 0; i < 3; i++) {
+      int sourceRow = row + i - 1;
+      sourceRow = (sourceRow < 0) ? 0 : (sourceRow >= height) ? height - 1 : sourceRow;
+      rows[i] = scaledRow(frame, source, sourceRow, first, last);
+      if (!rows[i]) return false;
+    }
+    int offsetY = ty % scale;
+    for (int x = 0; x < tile.width; x++) {
+      int panelX = tile.x + x;
+      int column = tile.sourceX + x / scale +
+                   ditherStep(x % scale, scale, bayer4[y & 3][panelX & 3]);
+      column = (column < 0) ? 0 : (column > last) ? last : column;
+      const uint8_t* pixels = rows[1 + ditherStep(offsetY, scale, bayer4[panelX & 3][y & 3])];
+      uint8_t pixel = pixelAt(pixels, column - first);
+      if (x & 1) {
+        dest[x / 2] = (dest[x / 2] & 0xF0) | pixel;
+      } else {
+        dest[x / 2] = pixel << 4;
+      }
+    }
+  }
+  return true;
+}
+
+bool Compositor::fillBand(uint8_t* band, uint32_t length, void* context) {
+  ComposeFrame& frame = *(ComposeFrame*)context;
+  uint16_t first = frame.nextRow;
+  uint16_t rows = length / PANEL_ROW_BYTES;
+  frame.nextRow += rows;
+
+  memset(band, fillPattern(frame.view.background), length);
+
+  // Tile by tile, in order, so later tiles cover earlier ones
+  for (int i = 0; i < frame.view.tileCount; i++) {
+    const ViewTile& tile = frame.view.tiles[i];
+    uint16_t top = (tile.y > first) ? tile.y : first;
+    uint16_t bottom = (tile.y + tile.height < first + rows) ? tile.y + tile.height : first + rows;
+    if (top >= bottom || tile.width == 0) {
+      continue;
+    }
+    uint8_t* dest = band + (uint32_t)(top - first) * PANEL_ROW_BYTES + tile.x / 2;
+    uint16_t bytes = tile.width / 2;
+
+    if (tile.type == VIEW_TILE_FILL) {
+      for (uint16_t y = top; y < bottom; y++, dest += PANEL_ROW_BYTES) {
+        memset(dest, fillPattern(tile.color), bytes);
+      }
+      continue;
+    }
+
+    int source = frame.tileSource[i];
+    if (tile.scale > 1) {
+      if (!fillScaled(frame, tile, source, top, bottom, dest)) {
+        return false;
+      }
+      continue;
+    }
+    // Full rows on both sides are contiguous and read in one go
+    if (!ImageFormat::readRows(frame.sources[source], tile.sourceY + top - tile.y, bottom - top, tile.sourceX / 2,
+                               bytes, dest, PANEL_ROW_BYTES)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Compositor::end(ComposeFrame& frame) {
+  for (int i = 0; i < frame.sourceCount; i++) {
+    frame.sources[i].file.close();
+  }
+  frame.sourceCount = 0;
+}
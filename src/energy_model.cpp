@@ -0,0 +1,128 @@
+#include "energy_model.h"
+#include <Arduino.h>
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include "config.h"
+#include "power_profile.h"
+#include "EPD_4in0e.h"
+
+#define ENERGY_MODEL_MAGIC 0x50504531 // "PPE1"
+
+struct RTCEnergyRecord {
+  uint32_t magic;
+  EnergyTotals totals;
+  uint32_t checksum;
+};
+
+RTC_DATA_ATTR static RTCEnergyRecord rtcEnergy;
+
+static WakeCharge wake;
+static bool wakeEnded = false;
+
+static uint32_t checksum() {
+  return esp_rom_crc32_le(0, (const uint8_t*)&rtcEnergy, offsetof(RTCEnergyRecord, checksum));
+}
+
+static float cpuMilliamps(PowerProfile profile) {
+  uint16_t mhz = PowerManager::getTypicalMhz(profile);
+  if (mhz == 0) return ENERGY_MA_LIGHT_SLEEP;
+  if (mhz >= POWER_MAX_CPU_MHZ) return ENERGY_MA_CPU_MAX;
+  if (mhz >= 80) return ENERGY_MA_CPU_80MHZ;
+  return ENERGY_MA_CPU_XTAL;
+}
+
+void EnergyModel::store() {
+  rtcEnergy.magic = ENERGY_MODEL_MAGIC;
+  rtcEnergy.checksum = checksum();
+}
+
+void EnergyModel::begin() {
+  memset(&wake, 0, sizeof(wake));
+  if (rtcEnergy.magic != ENERGY_MODEL_MAGIC || rtcEnergy.checksum != checksum()) {
+    // Cold boot - new battery or a reset, start over
+    memset(&rtcEnergy, 0, sizeof(rtcEnergy));
+    store();
+    return;
+  }
+
+  wake.sleepMs = PowerManager::getSleptMs();
+  if (wake.sleepMs > 0) {
+    wake.sleep = ENERGY_UA_DEEP_SLEEP / 1000.0f * wake.sleepMs / 1000.0f;
+    rtcEnergy.totals.sleepMs += wake.sleepMs;
+    rtcEnergy.totals.sleepMicroampSeconds += (uint64_t)ENERGY_UA_DEEP_SLEEP * wake.sleepMs / 1000;
+    store();
+  }
+}
+
+void EnergyModel::endWake() {
+  if (wakeEnded) {
+    return;
+  }
+  wakeEnded = true;
+
+  uint32_t radioMs = 0;
+  for (int i = 0; i < POWER_PROFILE_COUNT; i++) {
+    PowerProfile profile = (PowerProfile)i;
+    uint32_t ms = PowerManager::getResidencyMs(profile);
+    wake.activeMs += ms;
+    wake.cpu += cpuMilliamps(profile) * ms / 1000.0f;
+    if (profile == POWER_PROFILE_CRYPTO || profile == POWER_PROFILE_IO) {
+      radioMs += ms;
+    }
+  }
+  float radioMilliamps = ENERGY_MA_RADIO_RX +
+                         (ENERGY_MA_RADIO_TX - ENERGY_MA_RADIO_RX) * ENERGY_RADIO_TX_PERCENT / 100.0f;
+  wake.radio = radioMilliamps * radioMs / 1000.0f;
+  wake.panel = ENERGY_MA_PANEL_REFRESH * EPD_4IN0E_RefreshMs() / 1000.0f;
+
+  rtcEnergy.totals.activeMs += wake.activeMs;
+  rtcEnergy.totals.activeMicroampSeconds += (uint64_t)((wake.cpu + wake.radio + wake.panel) * 1000.0f);
+  rtcEnergy.totals.wakes++;
+  store();
+}
+
+const WakeCharge& EnergyModel::getWake() {
+  return wake;
+}
+
+const EnergyTotals& EnergyModel::getTotals() {
+  return rtcEnergy.totals;
+}
+
+float EnergyModel::getAverageMilliamps() {
+  const EnergyTotals& totals = rtcEnergy.totals;
+  if (totals.sleepMs == 0) {
+    return -1.0f;
+  }
+  double microampSeconds = (double)totals.activeMicroampSeconds + totals.sleepMicroampSeconds;
+  double seconds = (totals.activeMs + totals.sleepMs) / 1000.0;
+  return (float)(microampSeconds / 1000.0 / seconds);
+}
+
+float EnergyModel::getBatteryLifeDays() {
+  float milliamps = getAverageMilliamps();
+  if (milliamps <= 0) {
+    return -1.0f;
+  }
+  return ENERGY_BATTERY_MAH / milliamps / 24.0f;
+}
+
+void EnergyModel::printDiagnostics() {
+  float active = wake.cpu + wake.radio + wake.panel;
+  Serial.printf("Charge (wake):           %8.1f mAs (CPU %.1f, radio %.1f, panel %.1f), %.1f mJ\n",
+                active, wake.cpu, wake.radio, wake.panel, active * POWER_SUPPLY_VOLTS);
+  Serial.printf("Charge (sleep before):   %8.3f mAs over %lu s\n", wake.sleep,
+                (unsigned long)(wake.sleepMs / 1000));
+
+  const EnergyTotals& totals = rtcEnergy.totals;
+  float milliamps = getAverageMilliamps();
+  if (milliamps < 0) {
+    Serial.printf("Average current:         - (needs a full sleep, %lu wakes so far)\n",
+                  (unsigned long)totals.wakes);
+    return;
+  }
+  Serial.printf("Average current:         %8.3f mA over %lu wakes (%.1f%% asleep)\n", milliamps,
+                (unsigned long)totals.wakes, 100.0 * totals.sleepMs / (totals.activeMs + totals.sleepMs));
+  Serial.printf("Battery use / life:      %8.2f mAh/day, %.0f days on %d mAh\n", milliamps * 24.0f,
+                getBatteryLifeDays(), ENERGY_BATTERY_MAH);
+}
@@ -1,10 +1,36 @@
 #include "flash_storage.h"
 #include <LittleFS.h>
+#include "trace.h"
 
 bool FlashStorage::initialized = false;
+WriteCounters FlashStorage::writeCounters = {0, 0};
+
+// Account one mutation: file data plus the metadata commit LittleFS makes
+// for every create, remove and rename
+void FlashStorage::countWrite(size_t dataBytes) {
+  writeCounters.bytes += dataBytes + STORAGE_METADATA_COMMIT_BYTES;
+  writeCounters.operations++;
+}
+
+bool FlashStorage::removeFile(const char* path) {
+  if (!LittleFS.remove(path)) return false;
+  countWrite(0);
+  return true;
+}
+
+bool FlashStorage::renameFile(const char* pathFrom, const char* pathTo) {
+  if (!LittleFS.rename(pathFrom, pathTo)) return false;
+  countWrite(0);
+  return true;
+}
+
+const WriteCounters& FlashStorage::getWriteCounters() {
+  return writeCounters;
+}
 
 bool FlashStorage::begin() {
   if (initialized) return true;
+  TRACE_SCOPE("flash.mount");
   
   // Initialize LittleFS with the partition label "storage"
   // begin(formatOnFail, basePath, maxOpenFiles, partitionLabel)
@@ -24,15 +50,20 @@ void FlashStorage::end() {
   }
 }
 
-String FlashStorage::getImagePath(int index) {
-  return "/image_" + String(index) + ".bin";
+void FlashStorage::getImagePath(int index, char* path, size_t pathSize) {
+  snprintf(path, pathSize, "/image_%d.bin", index);
+}
+
+static void getStagedPath(int index, char* path, size_t pathSize) {
+  snprintf(path, pathSize, "/staged_%d.bin", index);
 }
 
 bool FlashStorage::saveImage(int index, const uint8_t* imageData, size_t imageSize) {
   if (!begin()) return false;
   if (imageSize != IMAGE_SIZE_BYTES) return false;
   
-  String path = getImagePath(index);
+  char path[IMAGE_PATH_MAX_LEN];
+  getImagePath(index, path, sizeof(path));
   File file = LittleFS.open(path, "w");
   if (!file) {
     return false;
@@ -40,24 +71,36 @@ bool FlashStorage::saveImage(int index, const uint8_t* imageData, size_t imageSi
   
   size_t written = file.write(imageData, imageSize);
   file.close();
+  countWrite(written);
   
   return written == imageSize;
 }
 
 bool FlashStorage::saveImageFromStream(int index, Stream* stream, size_t expectedSize) {
   if (!begin()) return false;
-  if (expectedSize != IMAGE_SIZE_BYTES) return false;
+  TRACE_SCOPE("flash.write");
+  // Panel-size images, or other sizes the slideshow layout crops from
+  if (expectedSize == 0 || expectedSize > IMAGE_MAX_BYTES) return false;
   if (!stream) return false;
   
-  String path = getImagePath(index);
+  char path[IMAGE_PATH_MAX_LEN];
+  getImagePath(index, path, sizeof(path));
+
+  // Remove the old file first. Truncating with "w" keeps the old blocks
+  // allocated until close, so an overwrite would need a spare image worth
+  // of free space and a full partition could not be rewritten.
+  if (LittleFS.exists(path)) {
+    removeFile(path);
+  }
+
   File file = LittleFS.open(path, "w");
   if (!file) {
     return false;
   }
   
   // OPTIMIZATION: Use larger chunk size for faster writes (8KB instead of 4KB)
-  // This reduces the number of write operations
-  const size_t chunkSize = 8192;  // 8KB chunks
+  // This reduces the number of write operations (tune with native_bench_storage)
+  const size_t chunkSize = FLASH_WRITE_CHUNK_SIZE;
   uint8_t* chunkBuffer = (uint8_t*)malloc(chunkSize);
   if (!chunkBuffer) {
     file.close();
@@ -116,10 +159,11 @@ bool FlashStorage::saveImageFromStream(int index, Stream* stream, size_t expecte
   
   free(chunkBuffer);
   file.close();
+  countWrite(totalWritten);
   
   if (totalWritten != expectedSize) {
     // Clean up partial file
-    LittleFS.remove(path);
+    removeFile(path);
     return false;
   }
   
@@ -130,7 +174,8 @@ bool FlashStorage::loadImage(int index, uint8_t* imageData, size_t imageSize) {
   if (!begin()) return false;
   if (imageSize != IMAGE_SIZE_BYTES) return false;
   
-  String path = getImagePath(index);
+  char path[IMAGE_PATH_MAX_LEN];
+  getImagePath(index, path, sizeof(path));
   if (!LittleFS.exists(path)) {
     return false;
   }
@@ -156,7 +201,8 @@ File FlashStorage::openImageFile(int index) {
     return File();
   }
   
-  String path = getImagePath(index);
+  char path[IMAGE_PATH_MAX_LEN];
+  getImagePath(index, path, sizeof(path));
   if (!LittleFS.exists(path)) {
     return File();
   }
@@ -166,7 +212,7 @@ File FlashStorage::openImageFile(int index) {
     return File();
   }
   
-  if (file.size() != IMAGE_SIZE_BYTES) {
+  if (file.size() == 0 || file.size() > IMAGE_MAX_BYTES) {
     file.close();
     return File();
   }
@@ -174,49 +220,108 @@ File FlashStorage::openImageFile(int index) {
   return file;
 }
 
+bool FlashStorage::writeFile(const char* path, const uint8_t* data, size_t size) {
+  if (!begin()) return false;
+  if (LittleFS.exists(path)) {
+    removeFile(path);
+  }
+  File file = LittleFS.open(path, "w");
+  if (!file) {
+    return false;
+  }
+  size_t written = file.write(data, size);
+  file.close();
+  countWrite(written);
+  if (written != size) {
+    removeFile(path);
+    return false;
+  }
+  return true;
+}
+
+File FlashStorage::openFile(const char* path) {
+  if (!begin() || !LittleFS.exists(path)) {
+    return File();
+  }
+  return LittleFS.open(path, "r");
+}
+
 bool FlashStorage::hasImage(int index) {
   if (!begin()) return false;
-  String path = getImagePath(index);
+  char path[IMAGE_PATH_MAX_LEN];
+  getImagePath(index, path, sizeof(path));
   return LittleFS.exists(path);
 }
 
 bool FlashStorage::deleteImage(int index) {
   if (!begin()) return false;
-  String path = getImagePath(index);
-  return LittleFS.remove(path);
+  char path[IMAGE_PATH_MAX_LEN];
+  getImagePath(index, path, sizeof(path));
+  return removeFile(path);
 }
 
 bool FlashStorage::clearAllImages() {
   if (!begin()) return false;
   
   // Delete all image files
-  for (int i = 0; i < MAX_IMAGES; i++) {
-    deleteImage(i);
-  }
+  deleteImagesFrom(0);
+  clearStagedImages();
   
   return true;
 }
 
-size_t FlashStorage::getFreeSpace() {
-  if (!begin()) return 0;
-  // LittleFS doesn't have info() method, calculate by iterating files
-  // For simplicity, return a fixed value based on partition size
-  // Partition is 0x170000 = 1,507,328 bytes
-  size_t total = 0x170000;
-  size_t used = 0;
-  
-  // Calculate used space by summing file sizes
-  File root = LittleFS.open("/");
-  if (root) {
-    File file = root.openNextFile();
-    while (file) {
-      used += file.size();
-      file = root.openNextFile();
+void FlashStorage::deleteImagesFrom(int firstIndex) {
+  if (!begin()) return;
+  for (int i = firstIndex; i < MAX_IMAGES; i++) {
+    if (hasImage(i)) {
+      deleteImage(i);
     }
-    root.close();
   }
-  
-  return total - used;
+}
+
+bool FlashStorage::stageImage(int fromIndex, int toIndex) {
+  if (!begin()) return false;
+  char fromPath[IMAGE_PATH_MAX_LEN];
+  char stagedPath[IMAGE_PATH_MAX_LEN];
+  getImagePath(fromIndex, fromPath, sizeof(fromPath));
+  getStagedPath(toIndex, stagedPath, sizeof(stagedPath));
+  return renameFile(fromPath, stagedPath);
+}
+
+bool FlashStorage::hasStagedImage(int toIndex) {
+  if (!begin()) return false;
+  char stagedPath[IMAGE_PATH_MAX_LEN];
+  getStagedPath(toIndex, stagedPath, sizeof(stagedPath));
+  return LittleFS.exists(stagedPath);
+}
+
+bool FlashStorage::commitStagedImage(int toIndex) {
+  if (!begin()) return false;
+  char stagedPath[IMAGE_PATH_MAX_LEN];
+  char path[IMAGE_PATH_MAX_LEN];
+  getStagedPath(toIndex, stagedPath, sizeof(stagedPath));
+  getImagePath(toIndex, path, sizeof(path));
+  if (LittleFS.exists(path)) {
+    removeFile(path);
+  }
+  return renameFile(stagedPath, path);
+}
+
+void FlashStorage::clearStagedImages() {
+  if (!begin()) return;
+  char stagedPath[IMAGE_PATH_MAX_LEN];
+  for (int i = 0; i < MAX_IMAGES; i++) {
+    getStagedPath(i, stagedPath, sizeof(stagedPath));
+    if (LittleFS.exists(stagedPath)) {
+      removeFile(stagedPath);
+    }
+  }
+}
+
+size_t FlashStorage::getFreeSpace() {
+  if (!begin()) return 0;
+  // Block-level usage from LittleFS, includes metadata and partial blocks
+  return LittleFS.totalBytes() - LittleFS.usedBytes();
 }
 
 size_t FlashStorage::getUsedSpace() {
@@ -239,7 +344,39 @@ size_t FlashStorage::getUsedSpace() {
 
 size_t FlashStorage::getTotalSpace() {
   if (!begin()) return 0;
-  // Partition size: 0x170000 = 1,507,328 bytes
-  return 0x170000;
+  // Size of the mounted "storage" partition (differs per flash size variant)
+  return LittleFS.totalBytes();
+}
+
+// Each file occupies whole blocks. Keep a few blocks for the superblock
+// pair, the root directory and metadata commits.
+#define STORAGE_BLOCK_SIZE 4096
+#define STORAGE_RESERVED_BLOCKS 4
+
+size_t FlashStorage::getImageBlocks() {
+  size_t totalBlocks = getTotalSpace() / STORAGE_BLOCK_SIZE;
+  return (totalBlocks > STORAGE_RESERVED_BLOCKS) ? totalBlocks - STORAGE_RESERVED_BLOCKS : 0;
+}
+
+int FlashStorage::getImageCapacity(size_t imageBytes) {
+  if (!begin() || imageBytes == 0) return 0;
+
+  size_t blocksPerImage = (imageBytes + STORAGE_BLOCK_SIZE - 1) / STORAGE_BLOCK_SIZE;
+  size_t capacity = getImageBlocks() / blocksPerImage;
+  return (capacity < (size_t)MAX_IMAGES) ? (int)capacity : MAX_IMAGES;
 }
 
+int FlashStorage::getImageCapacity(const ImageLayout* layouts, int count) {
+  if (!begin()) return 0;
+
+  size_t freeBlocks = getImageBlocks();
+  int capacity = 0;
+  while (capacity < count && capacity < MAX_IMAGES) {
+    // Views store nothing
+    size_t blocks = (imageStoredBytes(layouts[capacity]) + STORAGE_BLOCK_SIZE - 1) / STORAGE_BLOCK_SIZE;
+    if (blocks > freeBlocks) break;
+    freeBlocks -= blocks;
+    capacity++;
+  }
+  return capacity;
+}
@@ -0,0 +1,304 @@
+#include "image_format.h"
+#include "flash_storage.h"
+
+static bool readRaw(ImageSource& source, uint32_t offset, uint8_t* dest, size_t bytes) {
+  if (offset + bytes > source.payloadSize) return false;
+  File& file = source.file;
+  return file.seek(source.payloadOffset + offset) && file.read(dest, bytes) == bytes;
+}
+
+static void savePoint(const ImageSource& source, ImageSeekPoint& point) {
+  point.codePosition = source.codePosition;
+  point.run = source.run;
+  point.literal = source.literal;
+  point.runValue = source.runValue;
+}
+
+static bool restorePoint(ImageSource& source, const ImageSeekPoint& point, uint32_t decoded) {
+  source.codePosition = point.codePosition;
+  source.decoded = decoded;
+  source.run = point.run;
+  source.literal = point.literal;
+  source.runValue = point.runValue;
+  return source.file.seek(source.codePosition);
+}
+
+// PackBits: a control byte n of 0-127 is followed by n + 1 literal bytes,
+// -1 to -127 by one byte repeated 1 - n times, -128 is padding. Runs are
+// decoded forward from where the last read stopped; literals that are
+// skipped are seeked over, not read. A read behind the decoder (the next
+// tile or crop of the same rows) resumes from the nearest restart point:
+// the start of the row last read, or one of the points recorded every
+// seekSpan bytes on the way down.
+static bool readPackBits(ImageSource& source, uint32_t offset, uint8_t* dest, size_t bytes) {
+  File& file = source.file;
+  uint32_t rowBytes = (source.width + 1) / 2;
+  uint32_t rowStart = offset - offset % rowBytes;
+
+  // Resume from the nearest restart point at or before offset when the
+  // decoder is past it, or further behind it than the point
+  uint32_t index = offset / source.seekSpan;
+  if (index >= source.seekPoints) index = source.seekPoints - 1;
+  const ImageSeekPoint* point = &source.seek[index];
+  uint32_t pointDecoded = index * source.seekSpan;
+  if (source.rowMarkDecoded <= offset && source.rowMarkDecoded > pointDecoded) {
+    point = &source.rowMark;
+    pointDecoded = source.rowMarkDecoded;
+  }
+  if ((offset < source.decoded || pointDecoded > source.decoded) && !restorePoint(source, *point, pointDecoded)) {
+    return false;
+  }
+  uint32_t end = source.payloadOffset + source.payloadSize;
+
+  while (bytes > 0) {
+    if (source.decoded == rowStart) {
+      savePoint(source, source.rowMark);
+      source.rowMarkDecoded = rowStart;
+    }
+    uint32_t nextPoint = source.seekPoints * source.seekSpan;
+    if (source.seekPoints < IMAGE_SEEK_POINTS && source.decoded == nextPoint) {
+      savePoint(source, source.seek[source.seekPoints++]);
+      nextPoint += source.seekSpan;
+    }
+
+    if (source.run == 0) {
+      uint8_t control;
+      if (source.codePosition >= end || file.read(&control, 1) != 1) return false;
+      source.codePosition++;
+      if (control < 0x80) {
+        source.literal = true;
+        source.run = control + 1;
+      } else if (control != 0x80) {
+        if (source.codePosition >= end || file.read(&source.runValue, 1) != 1) return false;
+        source.codePosition++;
+        source.literal = false;
+        source.run = 1 - (int8_t)control;
+      }
+      continue;
+    }
+
+    // Stop at the row start and the next restart point to record them
+    uint32_t count = source.run;
+    if (rowStart > source.decoded && count > rowStart - source.decoded) count = rowStart - source.decoded;
+    if (source.seekPoints < IMAGE_SEEK_POINTS && count > nextPoint - source.decoded) {
+      count = nextPoint - source.decoded;
+    }
+    if (offset > source.decoded) {
+      // Before the bytes asked for: skip the run, or its start
+      if (count > offset - source.decoded) count = offset - source.decoded;
+      if (source.literal) {
+        source.codePosition += count;
+        if (!file.seek(source.codePosition)) return false;
+      }
+    } else {
+      if (count > bytes) count = bytes;
+      if (source.literal) {
+        if (source.codePosition + count > end || file.read(dest, count) != count) return false;
+        source.codePosition += count;
+      } else {
+        memset(dest, source.runValue, count);
+      }
+      dest += count;
+      bytes -= count;
+      offset += count;
+    }
+    source.decoded += count;
+    source.run -= count;
+  }
+  return true;
+}
+
+// Decoders by codec; a new codec is a read function and an entry here
+static const struct {
+  uint8_t codec;
+  const char* name;
+  IMAGE_DECODER decode;
+} decoders[] = {
+  {IMAGE_CODEC_RAW, "raw", readRaw},
+  {IMAGE_CODEC_PACKBITS, "packbits", readPackBits},
+};
+
+static IMAGE_DECODER findDecoder(uint8_t codec) {
+  for (const auto& decoder : decoders) {
+    if (decoder.codec == codec) return decoder.decode;
+  }
+  return nullptr;
+}
+
+// A header this firmware can decode, for a container of totalSize bytes
+static bool validHeader(const ImageHeader& header, size_t totalSize) {
+  size_t rawSize = (size_t)((header.width + 1) / 2) * header.height;
+  return header.version == IMAGE_FORMAT_VERSION && header.headerSize >= sizeof(ImageHeader) &&
+         (size_t)header.headerSize + header.payloadSize == totalSize && totalSize <= IMAGE_MAX_BYTES &&
+         header.bpp == 4 && header.width > 0 && header.height > 0 &&
+         header.rawSize == rawSize && rawSize <= IMAGE_MAX_BYTES && header.scale <= COMPOSE_MAX_SCALE &&
+         findDecoder(header.codec) && (header.codec != IMAGE_CODEC_RAW || header.payloadSize == rawSize);
+}
+
+bool ImageFormat::open(int index, const ImageLayout& layout, ImageSource& source) {
+  File file = FlashStorage::openImageFile(index);
+  if (!file) return false;
+
+  ImageHeader header;
+  size_t headBytes = file.read((uint8_t*)&header, sizeof(header));
+  if (headBytes >= sizeof(header.magic) && header.magic == IMAGE_MAGIC) {
+    if (headBytes != sizeof(header) || !validHeader(header, file.size())) {
+      file.close();
+      return false;
+    }
+    source.headerless = false;
+    source.codec = header.codec;
+    source.width = header.width;
+    source.height = header.height;
+    source.scale = header.scale ? header.scale : layout.scale;
+    source.filter = header.scale ? header.filter : layout.filter;
+    source.payloadOffset = header.headerSize;
+    source.payloadSize = header.payloadSize;
+    source.remap = false;
+    for (int i = 0; i < 16; i++) {
+      source.palette[i] = (i & 1) ? (header.palette[i / 2] & 0x0F) : (header.palette[i / 2] >> 4);
+      source.remap = source.remap || source.palette[i] != i;
+    }
+  } else {
+    // Raw rows as every image was stored before the header
+    if (layout.width == 0 || file.size() != imageStoredBytes(layout)) {
+      file.close();
+      return false;
+    }
+    source.headerless = true;
+    source.codec = IMAGE_CODEC_RAW;
+    source.width = layout.width;
+    source.height = layout.height;
+    source.scale = layout.scale;
+    source.filter = layout.filter;
+    source.payloadOffset = 0;
+    source.payloadSize = file.size();
+    source.remap = false;
+  }
+
+  source.codePosition = source.payloadOffset;
+  source.decoded = 0;
+  source.run = 0;
+  uint32_t rowBytes = (source.width + 1) / 2;
+  source.seekSpan = rowBytes * ((source.height + IMAGE_SEEK_POINTS - 1) / IMAGE_SEEK_POINTS);
+  source.seekPoints = 1;
+  savePoint(source, source.seek[0]);
+  source.rowMarkDecoded = 0;
+  source.rowMark = source.seek[0];
+  if (!file.seek(source.payloadOffset)) {
+    file.close();
+    return false;
+  }
+  source.file = file;
+  return true;
+}
+
+bool ImageFormat::readRows(ImageSource& source, uint16_t row, uint16_t rows, uint16_t firstByte, uint16_t bytes,
+                           uint8_t* dest, uint16_t stride) {
+  IMAGE_DECODER decode = findDecoder(source.codec);
+  uint16_t rowBytes = (source.width + 1) / 2;
+  if (!decode || row + rows > source.height || firstByte + bytes > rowBytes) return false;
+
+  uint32_t offset = (uint32_t)row * rowBytes + firstByte;
+  size_t runBytes = bytes;
+  if (bytes == rowBytes && stride == rowBytes) {
+    runBytes = (size_t)rows * rowBytes;  // Whole rows are contiguous - one read for all of them
+    rows = 1;
+  }
+  for (uint16_t i = 0; i < rows; i++, offset += rowBytes, dest += stride) {
+    if (!decode(source, offset, dest, runBytes)) return false;
+    if (source.remap) {
+      for (size_t b = 0; b < runBytes; b++) {
+        dest[b] = (source.palette[dest[b] >> 4] << 4) | source.palette[dest[b] & 0x0F];
+      }
+    }
+  }
+  return true;
+}
+
+ImageDownloadKind ImageFormat::checkDownload(const uint8_t* head, size_t headBytes, int contentLength,
+                                             size_t rawSize, ImageHeader& header) {
+  if (contentLength <= 0) return IMAGE_DOWNLOAD_INVALID;
+
+  uint32_t magic = 0;
+  if (headBytes >= sizeof(magic)) memcpy(&magic, head, sizeof(magic));
+  if (magic == IMAGE_MAGIC) {
+    if (headBytes < sizeof(header)) return IMAGE_DOWNLOAD_INVALID;
+    memcpy(&header, head, sizeof(header));
+    return validHeader(header, contentLength) ? IMAGE_DOWNLOAD_CONTAINER : IMAGE_DOWNLOAD_INVALID;
+  }
+  return ((size_t)contentLength == rawSize) ? IMAGE_DOWNLOAD_RAW : IMAGE_DOWNLOAD_INVALID;
+}
+
+bool ImageFormat::storedFits(int index, const ImageLayout& layout) {
+  ImageSource source;
+  if (!open(index, layout, source)) return false;
+  source.file.close();
+  return true;
+}
+
+void ImageFormat::codecList(char* out, size_t size) {
+  size_t length = 0;
+  if (size > 0) out[0] = '\0';
+  for (const auto& decoder : decoders) {
+    int written = snprintf(out + length, size - length, "%s%s", length ? "," : "", decoder.name);
+    if (written < 0 || (size_t)written >= size - length) return;
+    length += written;
+  }
+}
+
+ImageDownloadStream::ImageDownloadStream(Stream* stream, const uint8_t* head, size_t headBytes,
+                                         const ImageHeader* header)
+    : stream(stream), head(head), headBytes(headBytes), position(0), header(header) {
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+}
+
+ImageDownloadStream::~ImageDownloadStream() {
+  mbedtls_sha256_free(&sha);
+}
+
+int ImageDownloadStream::available() {
+  return (int)(headBytes - (position < headBytes ? position : headBytes)) + stream->available();
+}
+
+int ImageDownloadStream::read() {
+  int c = (position < headBytes) ? head[position] : stream->read();
+  if (c < 0) return -1;
+  uint8_t byte = c;
+  hash(&byte, 1);
+  position++;
+  return c;
+}
+
+int ImageDownloadStream::peek() {
+  return (position < headBytes) ? head[position] : stream->peek();
+}
+
+size_t ImageDownloadStream::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+  if (position < headBytes) {
+    count = (length < headBytes - position) ? length : headBytes - position;
+    memcpy(buffer, head + position, count);
+  }
+  if (count < length) {
+    count += stream->readBytes(buffer + count, length - count);
+  }
+  hash((const uint8_t*)buffer, count);
+  position += count;
+  return count;
+}
+
+// Bytes at `position` of the download, only the payload is hashed
+void ImageDownloadStream::hash(const uint8_t* data, size_t length) {
+  if (!header || position + length <= header->headerSize) return;
+  size_t skip = (position < header->headerSize) ? header->headerSize - position : 0;
+  mbedtls_sha256_update(&sha, data + skip, length - skip);
+}
+
+bool ImageDownloadStream::hashMatches() {
+  if (!header) return true;
+  uint8_t digest[IMAGE_HASH_BYTES];
+  mbedtls_sha256_finish(&sha, digest);
+  return memcmp(digest, header->hash, IMAGE_HASH_BYTES) == 0;
+}
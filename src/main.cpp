@@ -8,27 +8,47 @@
 #include "wifi_config.h"
 #include "config.h"
 #include "nvs_storage.h"
+#include "state_cache.h"
+#include "wear_stats.h"
+#include "wifi_connector.h"
+#include "wake_orchestrator.h"
+#include "wake_scheduler.h"
+#include "outbox.h"
+#include "power_profile.h"
+#include "energy_model.h"
+#include "trace.h"
 #include "flash_storage.h"
 #include "api_client.h"
+#include "compositor.h"
+#include "image_format.h"
 #include "EPD_4in0e.h"
+#include "GUI_Band.h"
 #include "DEV_Config.h"
+#if __has_include(<soc/soc_caps.h>)
+#include <soc/soc_caps.h>
+#endif
+
+// A button that cannot wake the chip from deep sleep never reaches the
+// button fast path
+#ifdef SOC_GPIO_DEEP_SLEEP_WAKE_VALID_GPIO_MASK
+static_assert(SOC_GPIO_DEEP_SLEEP_WAKE_VALID_GPIO_MASK & (1ULL << BUTTON_PIN),
+              "BUTTON_PIN cannot wake the chip from deep sleep");
+#endif
 
 // TEMPORARY: Hardcoded device key for testing
 // TODO: Remove this and use NVS storage once upload/NVS preservation is fixed
 // Replace with your actual 64-character hex device key
 #define HARDCODED_DEVICE_KEY "9ecc9ddc6e0329b045f97928d0bf406fddcc2df90f1cba83eab9616aa8447350"
 
-String getDeviceId()
+void getDeviceId(char *deviceId, size_t size)
 {
   uint8_t mac[6];
   // WiFi.macAddress() works even if WiFi is not connected
   // Just need to set mode first
   WiFi.mode(WIFI_STA);
   WiFi.macAddress(mac);
-  char deviceId[32];
-  snprintf(deviceId, sizeof(deviceId), "%02X%02X%02X%02X%02X%02X",
+  snprintf(deviceId, size, "%02X%02X%02X%02X%02X%02X",
            mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-  return String(deviceId);
 }
 
 // Store WiFi info in RTC memory to speed up reconnection after deep sleep
@@ -48,69 +68,145 @@ RTC_DATA_ATTR bool has_saved_ip = false;
 // Global state
 DeviceState deviceState;
 bool displayInitialized = false;
-String globalDeviceKey = ""; // Device key loaded in setup(), used throughout
+char globalDeviceKey[DEVICE_KEY_LEN + 1] = ""; // Device key loaded in setup(), used throughout
+char globalDeviceId[DEVICE_ID_LEN + 1] = "";   // Device ID from MAC address, set in setup()
+
+// Per-wake static memory for signed URLs (reset before each download pass)
+static uint8_t urlArenaBuffer[URL_ARENA_SIZE];
+BumpArena urlArena(urlArenaBuffer, sizeof(urlArenaBuffer));
 
 // Function declarations
-bool connectWiFi();
-bool quickReconnectWiFi(); // Helper to quickly reconnect WiFi after display update
-void updateSlideshow();
+void startWiFi();
+bool finishWiFi();
+bool updateSlideshow();
 bool displayCurrentImage();
 void advanceToNextImage();
 bool downloadAndStoreImages(const SlideshowManifestResponse &manifest);
 void goToDeepSleep();
 
-// Helper function to quickly reconnect WiFi after display update
-// Uses saved IP/channel for fast reconnection
-bool quickReconnectWiFi()
+// Start association. WiFi.persistent(true) makes the driver rewrite its NVS
+// config whenever SSID, password, channel or BSSID change, so count that.
+static void beginWiFi(uint8_t channel, const uint8_t *bssid)
 {
-  WiFi.mode(WIFI_STA);
-  esp_wifi_set_ps(WIFI_PS_NONE);
-  WiFi.setAutoReconnect(false);
-  WiFi.persistent(true);
+  WearStats::noteWifiConfig(WIFI_SSID, WIFI_PASSWORD, channel, bssid);
+  WiFiConnector::begin(WIFI_SSID, WIFI_PASSWORD, channel, bssid);
+}
 
-  // Try to use saved IP/channel for fast reconnection
-  if (has_saved_ip && saved_ip != 0)
+// Backoff class for a failed connect, from the last attempt's disconnect reason
+static CheckFailure wifiCheckFailure()
+{
+  switch (WiFiConnector::getLastAttempt().failure)
   {
-    IPAddress ip(saved_ip);
-    IPAddress gateway(saved_gateway);
-    IPAddress subnet(saved_subnet);
-    IPAddress dns1(saved_dns1);
-    IPAddress dns2(saved_dns2);
-    WiFi.config(ip, gateway, subnet, dns1, dns2);
+  case WIFI_FAILURE_NO_AP:
+    return CHECK_FAILURE_NO_AP;
+  case WIFI_FAILURE_AUTH:
+    return CHECK_FAILURE_CREDENTIALS;
+  default:
+    return CHECK_FAILURE_WIFI;
   }
+}
 
-  if (has_saved_info && saved_channel > 0)
+// Backoff class for a failed request (negative codes are HTTPClient errors)
+static CheckFailure httpCheckFailure(int httpCode)
+{
+  if (httpCode <= 0)
+    return CHECK_FAILURE_NETWORK;
+  if (httpCode == 429 || (httpCode == 503 && APIClient::getLastRetryAfter() > 0))
+    return CHECK_FAILURE_THROTTLED;
+  if (httpCode >= 400 && httpCode < 500)
+    return CHECK_FAILURE_REJECTED;
+  return CHECK_FAILURE_SERVER; // 5xx, or 200 with a body we could not use
+}
+
+// Button presses since boot, counted by onButtonEdge()
+static volatile uint8_t buttonPresses = 0;
+static volatile uint32_t buttonLastEdgeMs = 0;
+
+// A falling edge counts as a press only if the line was quiet for the
+// debounce time before it, so contact bounce on press and release is ignored
+static void IRAM_ATTR onButtonEdge()
+{
+  uint32_t now = millis();
+  if (gpio_get_level((gpio_num_t)BUTTON_PIN) == 0 && now - buttonLastEdgeMs >= BUTTON_DEBOUNCE_MS)
   {
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD, saved_channel, saved_bssid);
+    buttonPresses++;
   }
-  else
+  buttonLastEdgeMs = now;
+}
+
+// Button wake: show the next image as fast as possible. Only RTC state and
+// the flash mount are needed - no WiFi, no device key, and NVS is left
+// alone (RTC state is committed by the next scheduled wake if needed).
+// Presses during the ~37 s refresh are coalesced: the frame skips ahead by
+// that many images with a single further refresh.
+static void handleButtonWake(unsigned long totalStartTime)
+{
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  buttonLastEdgeMs = millis();
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButtonEdge, CHANGE);
+
+  if (!StateCache::load(deviceState) || deviceState.imageCount == 0)
   {
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    goToDeepSleep();
+    return;
   }
-
-  // Wait for reconnection with short timeout
-  unsigned long reconnectStart = millis();
-  while (WiFi.status() != WL_CONNECTED && (millis() - reconnectStart) < 5000)
+  WakeScheduler::setImageCount(deviceState.imageCount);
+
+  // Panel reset/init runs in the background while LittleFS mounts
+  WakeOrchestrator::startPanelInit();
+  // Poll BUSY instead of light sleeping so the button interrupt keeps counting
+  EPD_4IN0E_SetBusyLightSleep(false);
+  bool mounted = FlashStorage::begin();
+
+  int refreshes = 0;
+  int coalesced = 0;
+  int steps = 1;
+  while (mounted && steps > 0 && refreshes < BUTTON_MAX_REFRESHES)
   {
-    delay(10);
+    for (int i = 0; i < steps % deviceState.imageCount; i++)
+    {
+      advanceToNextImage();
+    }
+    buttonPresses = 0;
+    TraceSpan displaySpan("display");
+    displayCurrentImage();
+    displaySpan.end();
+    refreshes++;
+    steps = buttonPresses;
+    coalesced += (steps > 1) ? steps - 1 : 0;
   }
+  detachInterrupt(digitalPinToInterrupt(BUTTON_PIN));
 
-  return (WiFi.status() == WL_CONNECTED);
+  // The new image gets a full dwell; the next update check stays as scheduled
+  deviceState.wakeCounter = 0;
+  WakeScheduler::noteAdvanced(deviceState.currentImageIndex);
+  StateCache::save(deviceState);
+  WearStats::endWake();
+  EnergyModel::endWake();
+
+  Serial.println("\n========================================");
+  Serial.println("TIMING DIAGNOSTICS (button)");
+  Serial.println("========================================");
+  Serial.printf("Total wake time:        %6lu ms\n", millis() - totalStartTime);
+  Trace::printWake();
+  unsigned long firstSpiMs = EPD_4IN0E_FirstFrameByteMs();
+  Serial.printf("Wake to first SPI byte:  %6lu ms (target %d ms%s)\n", firstSpiMs, BUTTON_FIRST_SPI_TARGET_MS,
+                (firstSpiMs > 0 && firstSpiMs <= BUTTON_FIRST_SPI_TARGET_MS) ? "" : ", MISSED");
+  Serial.printf("Refreshes / coalesced:   %6d / %d presses\n", refreshes, coalesced);
+  PowerManager::printDiagnostics();
+  EnergyModel::printDiagnostics();
+  WakeOrchestrator::printDiagnostics();
+  WakeScheduler::printDiagnostics();
+  Serial.println("========================================");
+  Trace::dump();
+
+  goToDeepSleep();
 }
 
 void setup()
 {
   // Timing diagnostics
   unsigned long totalStartTime = millis();
-  unsigned long stateLoadTime = 0;
-  unsigned long keyLoadTime = 0;
-  unsigned long wifiConnectTime = 0;
-  unsigned long versionCheckTime = 0;
-  unsigned long flashInitTime = 0;
-  unsigned long slideshowUpdateTime = 0;
-  unsigned long displayTime = 0;
-  unsigned long ackTime = 0;
-  unsigned long stateSaveTime = 0;
 
   // turn LED on after wake
   // pinMode(LED_PIN, OUTPUT);
@@ -118,23 +214,49 @@ void setup()
 
   // Check wake reason
   esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
-  bool buttonWake = false;
+  bool buttonWake = (wakeup_reason == ESP_SLEEP_WAKEUP_GPIO) &&
+                    (esp_sleep_get_gpio_wakeup_status() & (1ULL << BUTTON_PIN));
 
-  if (wakeup_reason == ESP_SLEEP_WAKEUP_GPIO)
+  Serial.begin(115200);
+  if (!buttonWake)
   {
-    // digitalWrite(LED_PIN, LOW);
-    // buttonWake = false;
+    delay(100); // Allow Serial to initialize
   }
 
-  Serial.begin(115200);
-  delay(100); // Allow Serial to initialize
-
   cycle_count++;
+  Trace::begin();
+  PowerManager::begin();
+  WearStats::begin();
+  EnergyModel::begin();
 
-  // Load device state (loadState handles its own begin()/end())
-  unsigned long stateLoadStart = millis();
+  // Decide what this wake is for - only update checks need the radio
+  WakeScheduler::begin();
+  Outbox::begin();
+
+  if (buttonWake)
+  {
+    handleButtonWake(totalStartTime);
+    return;
+  }
+  uint8_t dueActions = WakeScheduler::getDueActions();
+  bool checkDue = (dueActions & WAKE_ACTION_CHECK) != 0;
+
+  // Start WiFi association first - state load, key load, flash mount and
+  // panel init below all run while the radio associates
+  int64_t wifiStartUs = Trace::now();
+  bool wifiStarted = false;
+  if (checkDue)
+  {
+    WakeOrchestrator::beginPhase(WAKE_PHASE_WIFI);
+    startWiFi();
+    wifiStarted = true;
+  }
+
+  // Load device state from RTC memory (NVS is only read on cold boot)
+  TraceSpan stateLoadSpan("state.load");
+  WakeOrchestrator::beginPhase(WAKE_PHASE_STATE);
   // // Serial.println("\n--- Loading device state ---");
-  if (!NVSStorage::loadState(deviceState))
+  if (!StateCache::load(deviceState))
   {
     // First boot - initialize state
     // // Serial.println("First boot - initializing default state");
@@ -143,32 +265,67 @@ void setup()
     deviceState.slideshowVersion = 0;
     deviceState.imageCount = 0;
   }
-  stateLoadTime = millis() - stateLoadStart;
-
-  // Handle button wake - advance image immediately (before WiFi connection)
-  // This allows manual image advance without waiting for network operations
-  if (buttonWake)
+  WakeScheduler::setImageCount(deviceState.imageCount);
+  // After power loss the first check is splayed per device, unless there is
+  // no slideshow yet (frame being set up) - only known now, so ask again
+  dueActions = WakeScheduler::getDueActions();
+  checkDue = (dueActions & WAKE_ACTION_CHECK) != 0;
+  stateLoadSpan.end();
+
+  // Advance-only wake - no radio, no device key, no server round trip
+  if (!checkDue)
   {
-    if (deviceState.imageCount > 0)
+    WakeOrchestrator::endPhase(WAKE_PHASE_STATE);
+    if (wifiStarted)
     {
-      int oldImageIndex = deviceState.currentImageIndex;
-      advanceToNextImage();
-      bool displaySuccess = displayCurrentImage();
-      if (displaySuccess)
-      {
-        // Save state after successful display
-        NVSStorage::saveState(deviceState);
-      }
+      // The check turned out not to be due after the state load - stop
+      // associating now instead of through the advance and its refresh
+      WiFi.disconnect(true);
+      WiFi.mode(WIFI_OFF);
+      WakeOrchestrator::endPhase(WAKE_PHASE_WIFI);
     }
-    else
+    bool advance = (dueActions & WAKE_ACTION_ADVANCE) && deviceState.imageCount > 1 && FlashStorage::begin();
+    if (advance)
     {
-      // // Serial.println("No images available to display");
+      WakeOrchestrator::startPanelInit();
+      advanceToNextImage();
+      deviceState.wakeCounter = 0;
+      WakeScheduler::noteAdvanced(deviceState.currentImageIndex);
+      TRACE_SCOPE("display");
+      displayCurrentImage();
     }
+    StateCache::save(deviceState);
+    WearStats::endWake();
+    EnergyModel::endWake();
+
+    unsigned long totalTime = millis() - totalStartTime;
+    Serial.println("\n========================================");
+    Serial.println("TIMING DIAGNOSTICS (advance only)");
+    Serial.println("========================================");
+    Serial.printf("Total wake time:        %6lu ms\n", totalTime);
+    Trace::printWake();
+    WearStats::printDiagnostics();
+    PowerManager::printDiagnostics();
+    EnergyModel::printDiagnostics();
+    WakeOrchestrator::printDiagnostics();
+    WakeScheduler::printDiagnostics();
+    Serial.println("========================================");
+    Trace::dump();
+
+    goToDeepSleep();
+    return;
+  }
+
+  if (!wifiStarted)
+  {
+    wifiStartUs = Trace::now();
+    WakeOrchestrator::beginPhase(WAKE_PHASE_WIFI);
+    startWiFi();
   }
 
   // TEMPORARY: Try NVS first, fallback to hardcoded key
-  unsigned long keyLoadStart = millis();
-  String deviceKey = "";
+  TraceSpan keyLoadSpan("key.load");
+  char deviceKey[DEVICE_KEY_LEN + 1] = "";
   bool usingHardcodedKey = false;
 
   // Try to load from NVS first
@@ -177,54 +334,77 @@ void setup()
 
   if (keyExists)
   {
-    deviceKey = NVSStorage::loadDeviceKey();
-    // // Serial.printf("Key loaded from NVS, length: %d\n", deviceKey.length());
+    NVSStorage::loadDeviceKey(deviceKey, sizeof(deviceKey));
+    // // Serial.printf("Key loaded from NVS, length: %d\n", strlen(deviceKey));
   }
 
   // Fallback to hardcoded key if NVS doesn't have one
-  if (deviceKey.length() == 0)
+  if (deviceKey[0] == '\0')
   {
     // Serial.println("WARNING: No key in NVS, using hardcoded key (TEMPORARY)");
     // Serial.println("TODO: Fix NVS preservation during upload");
-    deviceKey = String(HARDCODED_DEVICE_KEY);
+    copyFixedString(deviceKey, sizeof(deviceKey), HARDCODED_DEVICE_KEY);
     usingHardcodedKey = true;
   }
 
   // Verify key format (should be 64 hex characters)
-  if (deviceKey.length() != 64)
+  if (strlen(deviceKey) != DEVICE_KEY_LEN)
   {
-    // Serial.printf("ERROR: Device key length is %d, expected 64\n", deviceKey.length());
+    // Serial.printf("ERROR: Device key length is %d, expected 64\n", strlen(deviceKey));
     // Serial.println("Going to sleep...");
+    WakeScheduler::noteChecked(nullptr, false, CHECK_FAILURE_REJECTED);
     goToDeepSleep();
     return;
   }
 
-  // Serial.printf("✓ Device key loaded successfully (length: %d)\n", deviceKey.length());
+  // Serial.printf("✓ Device key loaded successfully (length: %d)\n", strlen(deviceKey));
   // Serial.printf("Source: %s\n", usingHardcodedKey ? "HARDCODED (temporary)" : "NVS");
-  // Serial.printf("Key preview (first 10 chars): ");
-  for (int i = 0; i < 10 && i < deviceKey.length(); i++)
-  {
-    // Serial.print(deviceKey.charAt(i));
-  }
-  // Serial.println();
+  // Serial.printf("Key preview (first 10 chars): %.10s\n", deviceKey);
 
   // Store device key globally for use in other functions
-  globalDeviceKey = deviceKey;
-  keyLoadTime = millis() - keyLoadStart;
+  copyFixedString(globalDeviceKey, sizeof(globalDeviceKey), deviceKey);
+  keyLoadSpan.end();
 
   // Get device ID from chip MAC address
-  String deviceId = getDeviceId();
+  getDeviceId(globalDeviceId, sizeof(globalDeviceId));
+  const char *deviceId = globalDeviceId;
+  WakeOrchestrator::endPhase(WAKE_PHASE_STATE);
+
+  // Mount flash while associating - almost every wake with images needs it
+  if (deviceState.imageCount > 0)
+  {
+    WakeOrchestrator::beginPhase(WAKE_PHASE_FLASH_MOUNT);
+    FlashStorage::begin();
+    WakeOrchestrator::endPhase(WAKE_PHASE_FLASH_MOUNT);
+  }
+
+  // Reset and init the panel in the background if this wake will likely
+  // display (image advance due). A new slideshow is only known after the
+  // version check, the panel is then initialized on demand.
+  if (deviceState.imageCount > 1 && (dueActions & WAKE_ACTION_ADVANCE))
+  {
+    WakeOrchestrator::startPanelInit();
+  }
 
-  // Connect to WiFi
-  unsigned long wifiStart = millis();
+  // Finish connecting to WiFi
   // Serial.println("\n--- Connecting to WiFi ---");
-  if (!connectWiFi())
+  bool wifiConnected = finishWiFi();
+  WakeOrchestrator::endPhase(WAKE_PHASE_WIFI);
+  // Association overlaps the spans above - recorded as background work
+  Trace::record("wifi.connect", wifiStartUs, Trace::now(), TRACE_DEPTH_BACKGROUND);
+  if (!wifiConnected)
   {
     // Serial.println("ERROR: WiFi connection failed!");
-    // WiFi connection failed - display current image if available and go to sleep
-    if (deviceState.imageCount > 0)
+    // WiFi connection failed - show the next image if an advance is due and
+    // go to sleep. The panel keeps the current image without a refresh.
+    WakeScheduler::noteChecked(nullptr, false, wifiCheckFailure());
+    Outbox::push(OUTBOX_CHECK_FAILED, wifiCheckFailure());
+    if ((dueActions & WAKE_ACTION_ADVANCE) && deviceState.imageCount > 1)
     {
-      // Serial.println("Displaying current image before sleep...");
+      advanceToNextImage();
+      deviceState.wakeCounter = 0;
+      WakeScheduler::noteAdvanced(deviceState.currentImageIndex);
+      StateCache::save(deviceState);
       // Need flash storage for display
       if (FlashStorage::begin())
       {
@@ -235,21 +415,45 @@ void setup()
     goToDeepSleep();
     return;
   }
-  wifiConnectTime = millis() - wifiStart;
   // Serial.printf("✓ WiFi connected! IP: %s\n", WiFi.localIP().toString().c_str());
 
   // OPTIMIZATION: Check for new slideshow FIRST (before initializing flash storage)
   // This allows us to skip expensive operations if there's no new slideshow
-  unsigned long versionCheckStart = millis();
+  TraceSpan versionCheckSpan("version.check");
   // Serial.println("\n--- Checking for new slideshow ---");
   // Serial.printf("Current slideshow version: %d\n", deviceState.slideshowVersion);
-  SlideshowVersionResponse versionResponse;
+  SlideshowVersionResponse versionResponse = {};
   bool slideshowUpdated = false;
   bool newSlideshowDownloaded = false;
   bool needToDownload = false;
 
-  if (APIClient::getSlideshowVersion(deviceId, globalDeviceKey, versionResponse))
+  // Short request dominated by the TLS handshake - run it at full clock
+  PowerManager::setProfile(POWER_PROFILE_CRYPTO);
+
+  // Pending ACKs and events ride along on the check
+  char outboxQuery[160];
+  Outbox::formatQuery(outboxQuery, sizeof(outboxQuery));
+  bool versionChecked = APIClient::getSlideshowVersion(deviceId, globalDeviceKey, versionResponse, outboxQuery);
+  if (versionChecked)
   {
+    // A server without outbox support ignores the parameters - ACK the old
+    // way while the radio is up, events are dropped
+    int32_t pendingAck = Outbox::pendingAck();
+    bool ackedLate = false;
+    bool delivered = versionResponse.outboxAccepted || pendingAck < 0;
+    if (!delivered)
+    {
+      delivered = APIClient::ackDisplayed(deviceId, globalDeviceKey, pendingAck);
+      ackedLate = delivered;
+    }
+    if (delivered)
+    {
+      Outbox::clear();
+    }
+    // That server answered before it saw the ACK, so its NEW for the version
+    // on the panel is stale
+    bool staleNew = ackedLate && pendingAck == deviceState.slideshowVersion;
+
     // Serial.printf("Server slideshow version: %d, Status: %s\n",
     // versionResponse.slideshowVersion, versionResponse.status.c_str());
 
@@ -259,7 +463,8 @@ void setup()
       // Serial.println("NEW slideshow available! Downloading...");
       needToDownload = true;
     }
-    else if (versionResponse.status == "NEW" && versionResponse.slideshowVersion == deviceState.slideshowVersion)
+    else if (strcmp(versionResponse.status, "NEW") == 0 && versionResponse.slideshowVersion == deviceState.slideshowVersion &&
+             !staleNew)
     {
       // Status says NEW but versions match - might be a state sync issue, download anyway
       // Serial.println("Status is NEW but versions match - re-downloading to sync state...");
@@ -274,13 +479,15 @@ void setup()
   {
     // Serial.println("ERROR: Failed to check slideshow version");
   }
-  versionCheckTime = millis() - versionCheckStart;
+  versionCheckSpan.end();
+  // Downloads mostly wait on the network and flash
+  PowerManager::setProfile(POWER_PROFILE_IO);
 
   // Track if we need to display (only when image changes)
   bool needToDisplay = false;
 
   // Only initialize flash storage if we need to download or display
-  unsigned long flashInitStart = millis();
+  // (usually already mounted while WiFi was associating)
   if (needToDownload || deviceState.imageCount > 0)
   {
     // Serial.println("\n--- Initializing flash storage ---");
@@ -288,32 +495,47 @@ void setup()
     {
       // Serial.println("ERROR: Failed to initialize flash storage!");
       // Serial.println("Going to sleep...");
+      WakeScheduler::noteChecked(versionChecked ? &versionResponse : nullptr, false);
       goToDeepSleep();
       return;
     }
     // Serial.printf("✓ Flash storage initialized (Free: %d bytes, Used: %d bytes)\n",
     // FlashStorage::getFreeSpace(), FlashStorage::getUsedSpace());
   }
-  flashInitTime = millis() - flashInitStart;
 
   // Download new slideshow if needed
   if (needToDownload)
   {
-    unsigned long slideshowUpdateStart = millis();
-    updateSlideshow();
-    slideshowUpdateTime = millis() - slideshowUpdateStart;
-    slideshowUpdated = true;
-    newSlideshowDownloaded = true;
-    needToDisplay = true; // New slideshow - must display
+    TRACE_SCOPE("slideshow.update");
+    if (updateSlideshow())
+    {
+      slideshowUpdated = true;
+      newSlideshowDownloaded = true;
+      needToDisplay = true; // New slideshow - must display
+    }
+  }
+
+  // Schedule the next check - also steps the clock to server time and picks
+  // up the server's hints. A failed version check or download backs off.
+  CheckFailure checkFailure = CHECK_FAILURE_NONE;
+  if (!versionChecked || (needToDownload && !slideshowUpdated))
+  {
+    checkFailure = httpCheckFailure(APIClient::getLastHttpCode());
+  }
+  WakeScheduler::noteChecked(versionChecked ? &versionResponse : nullptr, slideshowUpdated,
+                             checkFailure, APIClient::getLastRetryAfter());
+  if (checkFailure != CHECK_FAILURE_NONE)
+  {
+    Outbox::push(OUTBOX_CHECK_FAILED, checkFailure);
   }
 
   // Save state immediately after slideshow update to ensure slideshowVersion is persisted
   if (slideshowUpdated)
   {
-    unsigned long stateSaveStart = millis();
+    TRACE_SCOPE("state.save");
     // Serial.println("\n--- Saving state after slideshow update ---");
-    NVSStorage::end();
-    if (NVSStorage::saveState(deviceState))
+    // Always commit - the image table changed even if version and count did not
+    if (StateCache::commit(deviceState))
     {
       // Serial.println("✓ State saved after slideshow update");
     }
@@ -321,21 +543,19 @@ void setup()
     {
       // Serial.println("ERROR: Failed to save state after slideshow update");
     }
-    stateSaveTime += millis() - stateSaveStart;
   }
 
-  // Increment wake counter
+  // Count wakes since the last advance
   int oldWakeCounter = deviceState.wakeCounter;
   deviceState.wakeCounter++;
-  bool stateChanged = false;
 
-  // Advance to next image every 6 wakes (24 hours)
+  // Advance to next image once its dwell time is up (a new slideshow
+  // starts over at its first image instead)
   bool imageAdvanced = false;
-  if (deviceState.wakeCounter >= WAKES_PER_DAY)
+  if ((dueActions & WAKE_ACTION_ADVANCE) && !slideshowUpdated)
   {
-    // Serial.println("24 hours passed - advancing to next image");
+    // Serial.println("Dwell time passed - advancing to next image");
     deviceState.wakeCounter = 0;
-    stateChanged = true;
     if (deviceState.imageCount > 0)
     {
       // Need flash storage for display
@@ -347,6 +567,7 @@ void setup()
       {
         int oldImageIndex = deviceState.currentImageIndex;
         advanceToNextImage();
+        WakeScheduler::noteAdvanced(deviceState.currentImageIndex);
         imageAdvanced = true;
         needToDisplay = true; // Image changed - need to display
                               // Serial.printf("Image advanced from %d to %d (of %d total)\n",
@@ -365,6 +586,7 @@ void setup()
     {
       // Serial.println("State shows no images, checking flash storage...");
       int imagesInFlash = 0;
+      // Smaller encodings fit more images than panel-size ones, look at every slot
       for (int i = 0; i < MAX_IMAGES; i++)
       {
         if (FlashStorage::hasImage(i))
@@ -377,8 +599,9 @@ void setup()
         // Serial.printf("Found %d images in flash! Updating state to match...\n", imagesInFlash);
         deviceState.imageCount = imagesInFlash;
         deviceState.currentImageIndex = 0;
+        WakeScheduler::setImageCount(imagesInFlash);
+        WakeScheduler::noteAdvanced(0);
         needToDisplay = true; // Found images - need to display
-        stateChanged = true;
       }
     }
   }
@@ -390,58 +613,41 @@ void setup()
 
     if (deviceState.imageCount > 0)
     {
-      unsigned long displayStart = millis();
+      TraceSpan displaySpan("display");
       // Serial.printf("Displaying image %d of %d\n", deviceState.currentImageIndex + 1, deviceState.imageCount);
       bool displaySuccess = displayCurrentImage();
-      displayTime = millis() - displayStart;
+      displaySpan.end();
 
-      // Only acknowledge display if:
-      // 1. Display was successful
-      // 2. A new slideshow was downloaded (not just advancing through existing slideshow)
-      // 3. WiFi is still connected
-      if (displaySuccess && newSlideshowDownloaded && WiFi.status() == WL_CONNECTED)
+      // Acknowledge a newly downloaded slideshow once it is on the panel.
+      // The radio is already off - the ACK goes out with the next version check.
+      if (displaySuccess && newSlideshowDownloaded)
       {
-        unsigned long ackStart = millis();
-        // Serial.printf("Acknowledging display of new slideshow version %d\n", deviceState.slideshowVersion);
-        if (APIClient::ackDisplayed(deviceId, globalDeviceKey, deviceState.slideshowVersion))
-        {
-          // Serial.println("✓ Display acknowledged");
-        }
-        else
-        {
-          // Serial.println("ERROR: Failed to acknowledge display");
-        }
-        ackTime = millis() - ackStart;
+        Outbox::push(OUTBOX_ACK_DISPLAYED, deviceState.slideshowVersion);
       }
     }
-    stateChanged = true; // Display happened, state may have changed
   }
   else
   {
     // Serial.println("\n--- No display needed (image unchanged) ---");
   }
 
-  // OPTIMIZATION: Only save state if something actually changed
-  // This avoids unnecessary NVS writes when there's no new slideshow
-  if (stateChanged || slideshowUpdated || imageAdvanced)
+  // Save state every wake - the wake counter always changes. StateCache keeps
+  // it in RTC memory and only writes NVS if the slideshow itself changed.
+  TraceSpan stateSaveSpan("state.save");
+  // Serial.println("\n--- Saving state ---");
+  if (StateCache::save(deviceState))
   {
-    unsigned long stateSaveStart = millis();
-    // Serial.println("\n--- Saving state ---");
-    NVSStorage::end();
-    if (NVSStorage::saveState(deviceState))
-    {
-      // Serial.println("✓ State saved");
-    }
-    else
-    {
-      // Serial.println("ERROR: Failed to save state");
-    }
-    stateSaveTime += millis() - stateSaveStart;
+    // Serial.println("✓ State saved");
   }
   else
   {
-    // Serial.println("\n--- No state changes - skipping save ---");
+    // Serial.println("ERROR: Failed to save state");
   }
+  stateSaveSpan.end();
+
+  // Fold this wake's flash/NVS writes and charge into the running totals
+  WearStats::endWake();
+  EnergyModel::endWake();
 
   // Print timing diagnostics
   unsigned long totalTime = millis() - totalStartTime;
@@ -449,16 +655,23 @@ void setup()
   Serial.println("TIMING DIAGNOSTICS");
   Serial.println("========================================");
   Serial.printf("Total wake time:        %6lu ms\n", totalTime);
-  Serial.printf("State load:              %6lu ms\n", stateLoadTime);
-  Serial.printf("Device key load:         %6lu ms\n", keyLoadTime);
-  Serial.printf("WiFi connection:         %6lu ms\n", wifiConnectTime);
-  Serial.printf("Version check API:       %6lu ms\n", versionCheckTime);
-  Serial.printf("Flash storage init:      %6lu ms\n", flashInitTime);
-  Serial.printf("Slideshow update:         %6lu ms\n", slideshowUpdateTime);
-  Serial.printf("Display:                 %6lu ms\n", displayTime);
-  Serial.printf("ACK:                     %6lu ms\n", ackTime);
-  Serial.printf("State save:              %6lu ms\n", stateSaveTime);
+  Trace::printWake();
+  Serial.printf("WiFi link / DHCP:        %6lu / %lu ms (%s)\n",
+                (unsigned long)WiFiConnector::getLastAttempt().linkMs,
+                (unsigned long)WiFiConnector::getLastAttempt().dhcpMs,
+                WiFiConnector::failureName(WiFiConnector::getLastAttempt().failure));
+  Serial.printf("Outbox pending:          %6d\n", Outbox::count());
+  Serial.printf("State source:            %s\n", StateCache::isWarm() ? "RTC" : "NVS");
+  Serial.printf("NVS writes / avoided:    %6lu / %lu\n",
+                (unsigned long)StateCache::getStats().nvsWrites,
+                (unsigned long)StateCache::getStats().nvsWritesAvoided);
+  WearStats::printDiagnostics();
+  PowerManager::printDiagnostics();
+  EnergyModel::printDiagnostics();
+  WakeOrchestrator::printDiagnostics();
+  WakeScheduler::printDiagnostics();
   Serial.println("========================================");
+  Trace::dump();
 
   // Go to deep sleep
   goToDeepSleep();
@@ -469,7 +682,12 @@ void loop()
   // This should never be reached due to deep sleep
 }
 
-bool connectWiFi()
+// Which method startWiFi() began with, finishWiFi() continues from there
+static bool wifiStartedWithSavedIP = false;
+static unsigned long wifiConnectStart = 0;
+
+// Configure the station and start association without waiting for it
+void startWiFi()
 {
   // Serial.println("Initializing WiFi...");
   WiFi.mode(WIFI_STA);
@@ -481,8 +699,12 @@ bool connectWiFi()
   WiFi.setAutoReconnect(false);
   WiFi.persistent(true); // Store credentials in flash
 
-  unsigned long connect_start = millis();
-  bool connection_success = false;
+  // Radio is on from here - panel BUSY waits must not light sleep
+  EPD_4IN0E_SetBusyLightSleep(false);
+  PowerManager::setProfile(POWER_PROFILE_IO);
+
+  wifiConnectStart = millis();
+  wifiStartedWithSavedIP = false;
 
   // Try to use saved IP configuration first (fastest method)
   if (has_saved_ip && saved_ip != 0)
@@ -502,71 +724,89 @@ bool connectWiFi()
     // Configure static IP
     if (WiFi.config(ip, gateway, subnet, dns1, dns2))
     {
-      // Try connection with saved channel/BSSID if available
-      if (has_saved_info && saved_channel > 0)
-      {
-        // Serial.printf("Connecting with saved IP, channel %d and BSSID...\n", saved_channel);
-        WiFi.begin(WIFI_SSID, WIFI_PASSWORD, saved_channel, saved_bssid);
-      }
-      else
-      {
-        // Serial.println("Connecting with saved IP...");
-        WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-      }
+      wifiStartedWithSavedIP = true;
+    }
+  }
 
-      // Wait for connection with shorter timeout for static IP
-      unsigned long start_time = millis();
-      unsigned long static_timeout = 5000; // 5 second timeout for static IP
+  // Try connection with saved channel/BSSID if available
+  if (has_saved_info && saved_channel > 0)
+  {
+    // Serial.printf("Connecting with saved channel %d and BSSID...\n", saved_channel);
+    beginWiFi(saved_channel, saved_bssid);
+  }
+  else
+  {
+    // Serial.println("First connection - scanning for network...");
+    beginWiFi(0, nullptr);
+  }
+}
 
-      while (WiFi.status() != WL_CONNECTED && (millis() - start_time) < static_timeout)
-      {
-        delay(1); // Reduced delay - check more frequently
-      }
+// Wait for the association started by startWiFi(), falling back to DHCP
+bool finishWiFi()
+{
+  unsigned long connect_start = wifiConnectStart;
+  bool connection_success = false;
+  bool credentials_rejected = false;
+  bool fallback_started = !wifiStartedWithSavedIP;
 
-      if (WiFi.status() == WL_CONNECTED)
-      {
-        connection_success = true;
-        // Serial.printf("Connected in %lu ms (saved IP method)\n", millis() - start_time);
-      }
-      else
-      {
-        // Serial.println("Saved IP method failed, trying fallback...");
-      }
+  if (wifiStartedWithSavedIP)
+  {
+    // Wait for connection with shorter timeout for static IP
+    WiFiAttempt attempt = WiFiConnector::wait(WiFiConnector::timeoutMs());
+    if (attempt.connected)
+    {
+      connection_success = true;
+      // Serial.printf("Connected in %lu ms (saved IP method)\n", attempt.totalMs);
+    }
+    else if (attempt.failure == WIFI_FAILURE_NO_AP)
+    {
+      // AP is not on the saved channel/BSSID any more - fall back to a full scan
+      has_saved_info = false;
+    }
+    else if (attempt.failure == WIFI_FAILURE_AUTH)
+    {
+      // Credentials rejected - a second attempt would fail the same way
+      credentials_rejected = true;
     }
   }
 
   // Fallback: Try saved channel/BSSID method if static IP failed or not available
-  if (!connection_success)
+  if (!connection_success && !credentials_rejected)
   {
-    // Serial.println("Trying fallback connection method...");
-    // Reset to DHCP if static IP was attempted
-    if (has_saved_ip && saved_ip != 0)
+    if (!fallback_started)
     {
+      // Serial.println("Trying fallback connection method...");
+      // Reset to DHCP after the static IP attempt
       IPAddress zero(0, 0, 0, 0);
-      WiFi.config(zero, zero, zero, zero, zero); // Reset to DHCP
-    }
+      WiFi.config(zero, zero, zero, zero, zero);
 
-    if (has_saved_info && saved_channel > 0)
-    {
-      // Serial.printf("Connecting with saved channel %d and BSSID...\n", saved_channel);
-      WiFi.begin(WIFI_SSID, WIFI_PASSWORD, saved_channel, saved_bssid);
-    }
-    else
-    {
-      // Serial.println("First connection - scanning for network...");
-      WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+      if (has_saved_info && saved_channel > 0)
+      {
+        // Serial.printf("Connecting with saved channel %d and BSSID...\n", saved_channel);
+        beginWiFi(saved_channel, saved_bssid);
+      }
+      else
+      {
+        // Serial.println("First connection - scanning for network...");
+        beginWiFi(0, nullptr);
+      }
     }
 
-    // Wait for connection with timeout
-    unsigned long timeout = 30000; // 30 second timeout
+    // Wait for connection with timeout. Returns as soon as the driver
+    // reports a disconnect; transient failures get one more attempt.
+    // The timeout follows recent connect history (short in a dead zone)
+    unsigned long timeout = WiFiConnector::timeoutMs();
     unsigned long start_time = millis();
-
-    while (WiFi.status() != WL_CONNECTED && (millis() - start_time) < timeout)
+    WiFiAttempt attempt = WiFiConnector::wait(timeout);
+    if (!attempt.connected &&
+        (attempt.failure == WIFI_FAILURE_ASSOC || attempt.failure == WIFI_FAILURE_LINK_LOST) &&
+        (millis() - start_time) < timeout)
     {
-      delay(1); // Reduced delay - check more frequently
+      beginWiFi(0, nullptr);
+      attempt = WiFiConnector::wait(timeout - (millis() - start_time));
     }
 
-    if (WiFi.status() == WL_CONNECTED)
+    if (attempt.connected)
     {
       connection_success = true;
       // Serial.printf("Connected in %lu ms (fallback method)\n", millis() - start_time);
@@ -627,71 +867,299 @@ bool connectWiFi()
   return connection_success;
 }
 
-void updateSlideshow()
+// First entry from `index` on, wrapping around, that is shown by the
+// slideshow - entries that are only sources of composed views are skipped
+static int shownImageFrom(int index)
+{
+  for (int n = 0; n < deviceState.imageCount; n++)
+  {
+    int candidate = (index + n) % deviceState.imageCount;
+    if (!Compositor::isHidden(candidate))
+    {
+      return candidate;
+    }
+  }
+  return index;
+}
+
+bool updateSlideshow()
 {
   // Serial.println("\n--- Updating slideshow ---");
   // Use global device key (loaded in setup with fallback to hardcoded)
-  String deviceKey = globalDeviceKey;
-  String deviceId = getDeviceId();
+  const char *deviceKey = globalDeviceKey;
+  const char *deviceId = globalDeviceId;
 
-  // Get slideshow manifest
-  unsigned long manifestStart = millis();
+  // Get slideshow manifest, one page at a time
+  // Static so the fixed-capacity ID/hash table does not sit on the loop task stack
   // Serial.println("Fetching slideshow manifest...");
-  SlideshowManifestResponse manifest;
-  if (!APIClient::getSlideshowManifest(deviceId, deviceKey, manifest))
+  static SlideshowManifestResponse manifest;
+  int offset = 0;
+  int firstVersion = 0;
+  do
   {
-    // Serial.println("ERROR: Failed to get slideshow manifest");
-    return;
+    if (!APIClient::getSlideshowManifest(deviceId, deviceKey, offset, MANIFEST_PAGE_SIZE, manifest))
+    {
+      // Serial.println("ERROR: Failed to get slideshow manifest");
+      return false;
+    }
+    if (offset == 0)
+    {
+      firstVersion = manifest.slideshowVersion;
+    }
+    else if (manifest.slideshowVersion != firstVersion)
+    {
+      // Slideshow changed between pages - pages don't belong together, retry next wake
+      // Serial.println("ERROR: Slideshow changed while paging manifest");
+      return false;
+    }
+    if (manifest.imageCount == offset)
+    {
+      break; // Empty page - server has nothing more
+    }
+    offset = manifest.imageCount;
+  } while (offset < manifest.totalCount && offset < MAX_IMAGES);
+
+  // Slideshows larger than the storage partition are truncated. Each image
+  // counts at the size it is stored at, so scaled-down images fit more.
+  int capacity = FlashStorage::getImageCapacity(manifest.layouts, manifest.imageCount);
+  if (manifest.imageCount > capacity)
+  {
+    manifest.imageCount = capacity;
   }
-  unsigned long manifestTime = millis() - manifestStart;
   // Serial.printf("✓ Manifest received: %d images\n", manifest.imageCount);
 
   // Download and store images
-  unsigned long downloadStart = millis();
   // Serial.println("Downloading images...");
   if (!downloadAndStoreImages(manifest))
   {
     // Serial.println("ERROR: Failed to download/store images");
     // Serial.println("Slideshow update incomplete - not updating device state");
-    return;
+    return false;
   }
-  unsigned long downloadTime = millis() - downloadStart;
   // Serial.println("✓ All images downloaded and stored");
   // Serial.println("✓ Slideshow update complete");
-  Serial.printf("  Manifest API: %lu ms, Downloads: %lu ms\n", manifestTime, downloadTime);
 
   // Update device state
   deviceState.slideshowVersion = manifest.slideshowVersion;
   deviceState.imageCount = manifest.imageCount;
-  for (int i = 0; i < manifest.imageCount && i < 12; i++)
+  memcpy(deviceState.imageIds, manifest.imageIds, manifest.imageCount * sizeof(ImageId));
+  memcpy(deviceState.imageHashes, manifest.imageHashes, manifest.imageCount * sizeof(ImageHash));
+  deviceState.currentImageIndex = shownImageFrom(0); // Reset to first image
+  deviceState.wakeCounter = 0;                        // Reset wake counter
+  WakeScheduler::setImageDwell(manifest.dwellMinutes, manifest.imageCount);
+  WakeScheduler::noteAdvanced(deviceState.currentImageIndex);
+  return true;
+}
+
+// Stream one image from a signed URL straight into flash slot `index`:
+// a container this firmware decodes (its payload hash is checked on the
+// way), or raw rows of `rawSize` bytes
+static bool downloadImageToFlash(HTTPClient &http, WiFiClientSecure &client, const char *url, int index,
+                                 size_t rawSize)
+{
+  char host[128];
+  const char *path;
+  if (!APIClient::parseUrl(url, host, sizeof(host), path))
+  {
+    return false;
+  }
+
+  // OPTIMIZATION: Reuse HTTPClient - don't call end() until we're done
+  // This keeps the underlying connection alive if possible
+  http.begin(client, host, 443, path);
+  http.setTimeout(30000); // Reduced timeout - 30 seconds should be plenty
+  http.setReuse(true);    // Reuse connection if possible
+
+  TraceSpan httpSpan("image.http");
+  int httpCode = http.GET();
+  httpSpan.end();
+
+  bool success = false;
+  int length = http.getSize();
+  Stream *stream = http.getStreamPtr();
+  if (httpCode == 200 && length > 0 && stream)
+  {
+    // The first bytes tell a container from raw rows
+    uint8_t head[sizeof(ImageHeader)];
+    size_t headBytes = ((size_t)length < sizeof(head)) ? (size_t)length : sizeof(head);
+    ImageHeader header;
+    ImageDownloadKind kind = IMAGE_DOWNLOAD_INVALID;
+    if (stream->readBytes(head, headBytes) == headBytes)
+    {
+      kind = ImageFormat::checkDownload(head, headBytes, length, rawSize, header);
+    }
+    if (kind != IMAGE_DOWNLOAD_INVALID)
+    {
+      ImageDownloadStream download(stream, head, headBytes, (kind == IMAGE_DOWNLOAD_CONTAINER) ? &header : nullptr);
+      success = FlashStorage::saveImageFromStream(index, &download, length);
+      if (success && !download.hashMatches())
+      {
+        FlashStorage::deleteImage(index);
+        success = false;
+      }
+    }
+  }
+
+  // Only disconnect the stream, the TLS connection is reused for the next http.begin()
+  http.end();
+  return success;
+}
+
+static bool isZeroHash(const ImageHash hash)
+{
+  for (int i = 0; i < IMAGE_HASH_BYTES; i++)
+  {
+    if (hash[i] != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Record in NVS what each flash slot holds while an update is under way:
+// the new slideshow's entry where that image is in place, the old entry
+// beyond the new slideshow where the old image was left alone, nothing
+// elsewhere. A retry after a failed or interrupted update then only reuses
+// what is really there.
+static void saveSlotTable(const SlideshowManifestResponse &manifest, const DeviceState &previous,
+                          const bool *inPlace, const bool *sourceUsed)
+{
+  static DeviceState slots;
+  slots.imageCount = (manifest.imageCount > previous.imageCount) ? manifest.imageCount : previous.imageCount;
+  memset(slots.imageIds, 0, sizeof(slots.imageIds));
+  memset(slots.imageHashes, 0, sizeof(slots.imageHashes));
+  for (int i = 0; i < slots.imageCount; i++)
   {
-    deviceState.imageIds[i] = manifest.imageIds[i];
-    deviceState.imageHashes[i] = manifest.imageHashes[i];
+    if (i < manifest.imageCount && inPlace[i])
+    {
+      memcpy(slots.imageIds[i], manifest.imageIds[i], sizeof(ImageId));
+      memcpy(slots.imageHashes[i], manifest.imageHashes[i], sizeof(ImageHash));
+    }
+    else if (i >= manifest.imageCount && !sourceUsed[i] && FlashStorage::hasImage(i))
+    {
+      memcpy(slots.imageIds[i], previous.imageIds[i], sizeof(ImageId));
+      memcpy(slots.imageHashes[i], previous.imageHashes[i], sizeof(ImageHash));
+    }
   }
-  deviceState.currentImageIndex = 0; // Reset to first image
-  deviceState.wakeCounter = 0;       // Reset wake counter
+  NVSStorage::saveImageTable(slots);
 }
 
 bool downloadAndStoreImages(const SlideshowManifestResponse &manifest)
 {
   // Use global device key (loaded in setup with fallback to hardcoded)
-  String deviceKey = globalDeviceKey;
-  String deviceId = getDeviceId();
+  const char *deviceKey = globalDeviceKey;
+  const char *deviceId = globalDeviceId;
+  TRACE_SCOPE("download");
+
+  // Image table of the slideshow currently on flash. Read from NVS because
+  // StateCache does not keep the table in RTC memory.
+  static DeviceState previous;
+  previous.imageCount = 0;
+  NVSStorage::loadImageTable(previous);
+
+  // Work out which images can be reused. An image whose hash is unchanged at
+  // the same index stays in place, one that only moved is renamed to its new
+  // index, everything else has to be downloaded. The table's hashes are
+  // trusted without reading the files: each was recorded only after its file
+  // was written or moved, and slots are cleared from it before they change.
+  // Opening the file still catches one that is missing or the wrong size.
+  static bool sourceUsed[MAX_IMAGES];
+  static bool inPlace[MAX_IMAGES];
+  static int moveFrom[MAX_IMAGES];
+  static int pending[MAX_IMAGES];
+  int pendingCount = 0;
+  int reusedCount = 0;
+  int movedCount = 0;
+  memset(sourceUsed, 0, sizeof(sourceUsed));
+  memset(inPlace, 0, sizeof(inPlace));
+
+  for (int i = 0; i < manifest.imageCount && i < previous.imageCount; i++)
+  {
+    if (!isZeroHash(manifest.imageHashes[i]) &&
+        memcmp(manifest.imageHashes[i], previous.imageHashes[i], IMAGE_HASH_BYTES) == 0 &&
+        ImageFormat::storedFits(i, manifest.layouts[i]))
+    {
+      inPlace[i] = true;
+      sourceUsed[i] = true;
+      reusedCount++;
+    }
+  }
 
-  // Get signed URLs
-  unsigned long urlsStart = millis();
-  SignedUrlsResponse urlsResponse;
-  if (!APIClient::getSignedUrls(deviceId, deviceKey, manifest.imageIds, manifest.imageCount, urlsResponse))
+  for (int i = 0; i < manifest.imageCount; i++)
   {
-    return false;
+    moveFrom[i] = -1;
+    if (inPlace[i] || manifest.layouts[i].width == 0)
+    {
+      continue; // In place, or a view of other entries with nothing to download
+    }
+    if (!isZeroHash(manifest.imageHashes[i]))
+    {
+      for (int j = 0; j < previous.imageCount; j++)
+      {
+        if (!sourceUsed[j] &&
+            memcmp(manifest.imageHashes[i], previous.imageHashes[j], IMAGE_HASH_BYTES) == 0 &&
+            ImageFormat::storedFits(j, manifest.layouts[i]))
+        {
+          moveFrom[i] = j;
+          sourceUsed[j] = true;
+          movedCount++;
+          break;
+        }
+      }
+    }
+    if (moveFrom[i] < 0)
+    {
+      pending[pendingCount++] = i;
+    }
+  }
+
+  // Flash is about to stop matching the old table - first record only the
+  // slots that stay as they are, so a reset part way through leaves no hash
+  // on a file that has moved or is being overwritten
+  if (movedCount > 0 || pendingCount > 0)
+  {
+    saveSlotTable(manifest, previous, inPlace, sourceUsed);
+  }
+
+  // Stage moved images first so no source is overwritten before it is renamed
+  for (int i = 0; i < manifest.imageCount; i++)
+  {
+    if (moveFrom[i] >= 0 && !FlashStorage::stageImage(moveFrom[i], i))
+    {
+      pending[pendingCount++] = i;
+    }
+  }
+  for (int i = 0; i < manifest.imageCount; i++)
+  {
+    if (FlashStorage::hasStagedImage(i))
+    {
+      if (FlashStorage::commitStagedImage(i))
+      {
+        inPlace[i] = true;
+        reusedCount++;
+      }
+      else
+      {
+        pending[pendingCount++] = i;
+      }
+    }
+  }
+  for (int i = 0; i < manifest.imageCount; i++)
+  {
+    // An image the old slideshow left at the index of a view
+    if (manifest.layouts[i].width == 0 && FlashStorage::hasImage(i))
+    {
+      FlashStorage::deleteImage(i);
+    }
   }
-  unsigned long urlsTime = millis() - urlsStart;
-  Serial.printf("  Signed URLs API: %lu ms\n", urlsTime);
+  Serial.printf("  Images reused: %d, to download: %d\n", reusedCount, pendingCount);
 
-  // OPTIMIZATION: Skip deletion - we're overwriting images 0 to (imageCount-1) anyway
-  // LittleFS will overwrite existing files, so no need to delete first
-  // Only delete if we're reducing the number of images (fewer than before)
-  // For now, skip deletion to save time - overwrite is faster than delete+write
+  // The moved images are in place now - record them before the downloads
+  if (movedCount > 0 && pendingCount > 0)
+  {
+    saveSlotTable(manifest, previous, inPlace, sourceUsed);
+  }
 
   // OPTIMIZATION: Reuse WiFiClientSecure connection for all downloads
   // This avoids TLS handshake overhead for each image
@@ -702,82 +1170,124 @@ bool downloadAndStoreImages(const SlideshowManifestResponse &manifest)
   // Download each image directly to flash (streaming, no large buffer needed)
   bool allSuccess = true;
   HTTPClient http; // Reuse HTTPClient object to avoid reallocation overhead
-  unsigned long totalDownloadTime = 0;
-  unsigned long totalFlashWriteTime = 0;
 
-  for (int i = 0; i < manifest.imageCount && i < 12; i++)
+  // Signed URLs are requested per batch so the URL arena stays a fixed size
+  // no matter how large the slideshow is
+  static ImageId batchIds[SIGNED_URL_BATCH_SIZE];
+  static SignedUrlsResponse urlsResponse;
+  for (int first = 0; first < pendingCount; first += SIGNED_URL_BATCH_SIZE)
   {
-    if (urlsResponse.urls[i].length() == 0)
+    int batchCount = pendingCount - first;
+    if (batchCount > SIGNED_URL_BATCH_SIZE)
     {
-      // Missing URL for this image
-      allSuccess = false;
-      continue;
+      batchCount = SIGNED_URL_BATCH_SIZE;
+    }
+    for (int b = 0; b < batchCount; b++)
+    {
+      memcpy(batchIds[b], manifest.imageIds[pending[first + b]], sizeof(ImageId));
     }
 
-    unsigned long imageStart = millis();
-    String host, path;
-    APIClient::parseUrl(urlsResponse.urls[i], host, path);
-
-    // OPTIMIZATION: Reuse HTTPClient - don't call end() until we're done
-    // This keeps the underlying connection alive if possible
-    http.begin(client, host.c_str(), 443, path.c_str());
-    http.setTimeout(30000); // Reduced timeout - 30 seconds should be plenty
-    http.setReuse(true);    // Reuse connection if possible
-
-    unsigned long httpStart = millis();
-    int httpCode = http.GET();
-    unsigned long httpTime = millis() - httpStart;
+    urlArena.reset();
+    if (!APIClient::getSignedUrls(deviceId, deviceKey, batchIds, batchCount, urlArena, urlsResponse))
+    {
+      allSuccess = false;
+      break;
+    }
 
-    if (httpCode == 200)
+    for (int b = 0; b < batchCount; b++)
     {
-      size_t contentLength = http.getSize();
-      if (contentLength == IMAGE_SIZE_BYTES)
+      int index = pending[first + b];
+      // A missing URL fails the image like a failed download
+      if (urlsResponse.urls[b] != nullptr &&
+          downloadImageToFlash(http, client, urlsResponse.urls[b], index, imageStoredBytes(manifest.layouts[index])))
       {
-        Stream *stream = http.getStreamPtr();
-        if (stream)
-        {
-          unsigned long flashStart = millis();
-          if (FlashStorage::saveImageFromStream(i, stream, contentLength))
-          {
-            unsigned long flashTime = millis() - flashStart;
-            totalFlashWriteTime += flashTime;
-            unsigned long imageTime = millis() - imageStart;
-            totalDownloadTime += imageTime;
-            Serial.printf("  Image %d: HTTP=%lu ms, Flash=%lu ms, Total=%lu ms\n",
-                          i, httpTime, flashTime, imageTime);
-          }
-          else
-          {
-            allSuccess = false;
-          }
-        }
-        else
-        {
-          allSuccess = false;
-        }
+        inPlace[index] = true;
       }
       else
       {
         allSuccess = false;
       }
     }
-    else
-    {
-      allSuccess = false;
-    }
-
-    // OPTIMIZATION: Don't call http.end() between downloads to keep connection alive
-    // Only disconnect the stream, not the entire connection
-    // The connection will be reused for the next http.begin() call
-    http.end();
   }
 
-  Serial.printf("  Total download time: %lu ms (Flash writes: %lu ms)\n",
-                totalDownloadTime, totalFlashWriteTime);
+  if (allSuccess)
+  {
+    // Images beyond the new slideshow are never shown again, free their space
+    FlashStorage::deleteImagesFrom(manifest.imageCount);
+    FlashStorage::clearStagedImages();
+    allSuccess = Compositor::saveLayouts(manifest.layouts, manifest.imageCount, manifest.views, manifest.viewCount);
+  }
+  else
+  {
+    // Keep what did download for the retry
+    saveSlotTable(manifest, previous, inPlace, sourceUsed);
+  }
 
   return allSuccess;
 }
 
+// Record what to draw over the image. Nothing by default, so the image is
+// streamed straight from flash.
+static void drawOverlay()
+{
+  Band_NewImage(EPD_4IN0E_WIDTH, EPD_4IN0E_HEIGHT, ROTATE_0, EPD_4IN0E_WHITE);
+  Paint_SetScale(7);
+
+  // A frame that keeps failing to reach the server still looks fine - mark
+  // the bottom right corner so the owner notices
+  if (STATUS_BADGE_AFTER_FAILURES > 0 &&
+      WakeScheduler::getConsecutiveFailures() >= STATUS_BADGE_AFTER_FAILURES)
+  {
+    UWORD x = EPD_4IN0E_WIDTH - 24;
+    UWORD y = EPD_4IN0E_HEIGHT - 28;
+    Band_DrawRectangle(x, y, x + 18, y + 22, EPD_4IN0E_WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    Band_DrawRectangle(x, y, x + 18, y + 22, EPD_4IN0E_BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+    Band_DrawChar(x + 4, y + 4, '!', &Font16, EPD_4IN0E_RED, EPD_4IN0E_WHITE);
+  }
+}
+
+// Stream a frame to the panel band by band from `source` with the overlay
+// drawn in, using one band of RAM instead of a full framebuffer
+static bool displayBands(UBYTE *band, BAND_SOURCE source, void *context)
+{
+  EPD_4IN0E_BeginFrame();
+  bool success = Band_Render(band, DISPLAY_BAND_ROWS, source, context, EPD_4IN0E_WriteFrame);
+  if (success)
+  {
+    EPD_4IN0E_EndFrame();
+  }
+  return success;
+}
+
+static bool displayWithOverlay(File &imageFile)
+{
+  if (imageFile.size() != IMAGE_SIZE_BYTES)
+  {
+    return false;
+  }
+  UBYTE *band = (UBYTE *)malloc((size_t)DISPLAY_BAND_ROWS * Paint.WidthByte);
+  if (!band)
+  {
+    return EPD_4IN0E_DisplayFromFile(imageFile, IMAGE_SIZE_BYTES); // Image without the overlay
+  }
+  bool success = displayBands(band, Band_FillFromFile, &imageFile);
+  free(band);
+  return success;
+}
+
+// A composed view: the compositor reads each band's rows from its sources
+static bool displayComposed(ComposeFrame &frame)
+{
+  UBYTE *band = (UBYTE *)malloc((size_t)DISPLAY_BAND_ROWS * Paint.WidthByte);
+  if (!band)
+  {
+    return false;
+  }
+  bool success = displayBands(band, Compositor::fillBand, &frame);
+  free(band);
+  return success;
+}
+
 bool displayCurrentImage()
 {
   if (deviceState.imageCount == 0)
@@ -786,35 +1296,47 @@ bool displayCurrentImage()
     return false;
   }
 
-  // Initialize display if not already done
+  // Initialize display if not already done (may already be running in the
+  // background since boot - this waits for it)
   if (!displayInitialized)
   {
     // Serial.println("Initializing display...");
-    DEV_Module_Init();
-    EPD_4IN0E_Init();
+    if (!WakeOrchestrator::ensurePanelReady())
+    {
+      return false;
+    }
     displayInitialized = true;
     // Serial.println("✓ Display initialized");
   }
 
-  // Open image file from flash for streaming
+  // Open image file from flash for streaming, or the sources of a composed view
   // Serial.printf("Opening image %d from flash for streaming...\n", deviceState.currentImageIndex);
-  File imageFile = FlashStorage::openImageFile(deviceState.currentImageIndex);
+  static ComposeFrame frame;
+  File imageFile;
+  ComposeResult compose = Compositor::begin(deviceState.currentImageIndex, frame);
+  if (compose == COMPOSE_PLAIN)
+  {
+    imageFile = FlashStorage::openImageFile(deviceState.currentImageIndex);
+  }
 
-  if (!imageFile)
+  if (compose == COMPOSE_FAILED || (compose == COMPOSE_PLAIN && !imageFile))
   {
     // Serial.printf("ERROR: Failed to open image %d from flash\n", deviceState.currentImageIndex);
+    Outbox::push(OUTBOX_DISPLAY_FAILED, deviceState.currentImageIndex);
     return false;
   }
 
   // OPTIMIZATION: Disconnect WiFi before display update to save power
   // The display update takes ~37 seconds, and ESP is idle during this time
   // Disconnecting WiFi saves significant power during the display update
-  bool wifiWasConnected = (WiFi.status() == WL_CONNECTED);
-  if (wifiWasConnected)
+  // Also turn the radio off if a failed connect left it scanning
+  if (WiFi.getMode() != WIFI_MODE_NULL)
   {
     WiFi.disconnect(true); // Disconnect and disable WiFi to save power
-    // Serial.println("WiFi disconnected for display update (power saving)");
   }
+  // Serial.println("WiFi disconnected for display update (power saving)");
+  // Radio is off - BUSY waits during the refresh can light sleep again
+  EPD_4IN0E_SetBusyLightSleep(true);
 
   // Serial.printf("✓ Image file opened (%d bytes)\n", imageFile.size());
   // Serial.println("Streaming image to display...");
@@ -823,8 +1345,20 @@ bool displayCurrentImage()
   // This will call EPD_4IN0E_TurnOnDisplay() which starts the display update
   // and waits for BUSY pin (takes ~37 seconds)
   // Note: The display library polls BUSY pin, but WiFi is off so less power consumed
-  bool displaySuccess = EPD_4IN0E_DisplayFromFile(imageFile, IMAGE_SIZE_BYTES);
-  imageFile.close();
+  PowerManager::setProfile(POWER_PROFILE_BUS);
+  drawOverlay();
+  bool displaySuccess;
+  if (compose == COMPOSE_READY)
+  {
+    displaySuccess = displayComposed(frame);
+    Compositor::end(frame);
+  }
+  else
+  {
+    displaySuccess = (Band_Count() > 0) ? displayWithOverlay(imageFile)
+                                        : EPD_4IN0E_DisplayFromFile(imageFile, IMAGE_SIZE_BYTES);
+    imageFile.close();
+  }
 
   if (displaySuccess)
   {
@@ -839,18 +1373,9 @@ bool displayCurrentImage()
   EPD_4IN0E_Sleep();
   // Serial.println("Display put to sleep");
 
-  // Reconnect WiFi if it was connected before (needed for ACK)
-  if (wifiWasConnected)
+  if (!displaySuccess)
   {
-    // Serial.println("Reconnecting WiFi after display update...");
-    if (quickReconnectWiFi())
-    {
-      // Serial.println("✓ WiFi reconnected");
-    }
-    else
-    {
-      // Serial.println("WARNING: WiFi reconnection failed (ACK may fail)");
-    }
+    Outbox::push(OUTBOX_DISPLAY_FAILED, deviceState.currentImageIndex);
   }
 
   return displaySuccess;
@@ -869,12 +1394,17 @@ void advanceToNextImage()
   {
     deviceState.currentImageIndex = 0; // Wrap around
   }
+  deviceState.currentImageIndex = shownImageFrom(deviceState.currentImageIndex);
   // Serial.printf("Image advanced: %d -> %d (of %d total)\n",
   //           oldIndex, deviceState.currentImageIndex, deviceState.imageCount);
 }
 
 void goToDeepSleep()
 {
+  // Account writes and charge on early exits too (no-op if setup() already did)
+  WearStats::endWake();
+  EnergyModel::endWake();
+
   // Cleanup storage
   NVSStorage::end();
   FlashStorage::end();
@@ -884,11 +1414,27 @@ void goToDeepSleep()
   //   digitalWrite(LED_PIN, LOW);
   // #endif
 
-  const uint64_t WAKEUP_LOW_PIN_BITMASK = 0b000100; // GPIO 2
-  esp_deep_sleep_enable_gpio_wakeup(WAKEUP_LOW_PIN_BITMASK, ESP_GPIO_WAKEUP_GPIO_LOW);
+  // Wake on a button press. A held button would wake us straight away, so
+  // give it a moment to be released and skip the button wake if it isn't.
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  unsigned long releaseStart = millis();
+  while (digitalRead(BUTTON_PIN) == LOW && millis() - releaseStart < 3000)
+  {
+    delay(10);
+  }
+  if (digitalRead(BUTTON_PIN) == HIGH)
+  {
+    esp_err_t err = esp_deep_sleep_enable_gpio_wakeup(1ULL << BUTTON_PIN, ESP_GPIO_WAKEUP_GPIO_LOW);
+    if (err != ESP_OK)
+    {
+      Serial.printf("Button wake on GPIO %d not available (error %d)\n", BUTTON_PIN, err);
+    }
+  }
 
-  esp_sleep_enable_timer_wakeup(WAKE_INTERVAL_MICROSECONDS);
+  // Sleep until the next image advance or update check, whichever is first
+  esp_sleep_enable_timer_wakeup(WakeScheduler::getSleepMicros());
 
+  PowerManager::beginDeepSleep();
   esp_deep_sleep_start();
   // This should never be reached
 }
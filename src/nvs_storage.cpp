@@ -1,6 +1,74 @@
 #include "nvs_storage.h"
 
+// Image tables were stored as one key per image for up to 12 images
+#define LEGACY_MAX_IMAGES 12
+
 Preferences NVSStorage::preferences;
+WriteCounters NVSStorage::writeCounters = {0, 0};
+
+// Flash used by one NVS value: ints take a single entry, strings and blobs
+// a header entry plus their data rounded up to whole entries
+static size_t nvsEntryBytes(size_t dataLength)
+{
+  return NVS_ENTRY_BYTES + ((dataLength + NVS_ENTRY_BYTES - 1) / NVS_ENTRY_BYTES) * NVS_ENTRY_BYTES;
+}
+
+// NVS skips writes of an unchanged value, so those are not counted
+size_t NVSStorage::writeInt(const char *key, int32_t value)
+{
+  if (preferences.isKey(key) && preferences.getInt(key, ~value) == value)
+    return sizeof(value);
+  size_t result = preferences.putInt(key, value);
+  if (result)
+  {
+    writeCounters.bytes += NVS_ENTRY_BYTES;
+    writeCounters.operations++;
+  }
+  return result;
+}
+
+size_t NVSStorage::writeString(const char *key, const char *value)
+{
+  size_t length = strlen(value);
+  char current[DEVICE_KEY_LEN + 2];
+  if (length < sizeof(current) - 1 && preferences.isKey(key) &&
+      preferences.getString(key, current, sizeof(current)) > 0 && strcmp(current, value) == 0)
+    return length;
+  size_t result = preferences.putString(key, value);
+  if (result)
+  {
+    writeCounters.bytes += nvsEntryBytes(length + 1);
+    writeCounters.operations++;
+  }
+  return result;
+}
+
+// Blobs are counted even if unchanged - comparing would mean reading them back
+size_t NVSStorage::writeBytes(const char *key, const void *value, size_t length)
+{
+  size_t result = preferences.putBytes(key, value, length);
+  if (result)
+  {
+    writeCounters.bytes += nvsEntryBytes(length);
+    writeCounters.operations++;
+  }
+  return result;
+}
+
+// Erasing only flips entry state bits, count the operation but no bytes
+void NVSStorage::eraseKey(const char *key)
+{
+  if (preferences.isKey(key))
+  {
+    preferences.remove(key);
+    writeCounters.operations++;
+  }
+}
+
+const WriteCounters &NVSStorage::getWriteCounters()
+{
+  return writeCounters;
+}
 
 bool NVSStorage::begin()
 {
@@ -12,7 +80,7 @@ void NVSStorage::end()
   preferences.end();
 }
 
-bool NVSStorage::saveDeviceKey(const String &key)
+bool NVSStorage::saveDeviceKey(const char *key)
 {
   // Ensure preferences is closed first
   preferences.end();
@@ -25,7 +93,8 @@ bool NVSStorage::saveDeviceKey(const String &key)
 
   // Save the key - putString returns the number of bytes written, or 0 on failure
   // For a 64-char hex string, we expect at least 64 bytes written
-  size_t written = preferences.putString("deviceKey", key);
+  size_t written = writeString("deviceKey", key);
+  size_t keyLength = strlen(key);
 
   // Force commit to ensure data is written
   preferences.end();
@@ -35,21 +104,24 @@ bool NVSStorage::saveDeviceKey(const String &key)
   { // readonly=true for verification
     return false;
   }
-  String verify = preferences.getString("deviceKey", "");
+  char verify[DEVICE_KEY_LEN + 1] = "";
+  preferences.getString("deviceKey", verify, sizeof(verify));
   preferences.end();
 
   // Check if write was successful
-  bool success = (written >= key.length()) && (verify == key);
+  bool success = (written >= keyLength) && (strcmp(verify, key) == 0);
   return success;
 }
 
-String NVSStorage::loadDeviceKey()
+bool NVSStorage::loadDeviceKey(char *key, size_t keySize)
 {
+  key[0] = '\0';
   if (!begin())
-    return "";
-  String key = preferences.getString("deviceKey", "");
+    return false;
+  // getString() leaves the buffer untouched if the key is missing or too long
+  size_t length = preferences.getString("deviceKey", key, keySize);
   end();
-  return key;
+  return length > 0;
 }
 
 bool NVSStorage::hasDeviceKey()
@@ -75,49 +147,41 @@ bool NVSStorage::saveState(const DeviceState &state)
   // NVS keys are limited to 15 characters on ESP32
   // putInt/putString return size_t (bytes written), 0 means failure
   size_t result = 0;
-  result = preferences.putInt("imgIdx", state.currentImageIndex); // was "currentImageIndex" (18 chars)
+  result = writeInt("imgIdx", state.currentImageIndex); // was "currentImageIndex" (18 chars)
   if (result == 0)
     return false;
 
-  result = preferences.putInt("wakeCnt", state.wakeCounter); // was "wakeCounter" (11 chars, OK but shortened)
+  result = writeInt("wakeCnt", state.wakeCounter); // was "wakeCounter" (11 chars, OK but shortened)
   if (result == 0)
     return false;
 
-  result = preferences.putInt("ssVer", state.slideshowVersion); // was "slideshowVersion" (17 chars)
+  result = writeInt("ssVer", state.slideshowVersion); // was "slideshowVersion" (17 chars)
   if (result == 0)
     return false;
 
-  result = preferences.putInt("imgCnt", state.imageCount); // was "imageCount" (10 chars, OK but shortened)
+  result = writeInt("imgCnt", state.imageCount); // was "imageCount" (10 chars, OK but shortened)
   if (result == 0)
     return false;
 
-  // Save image IDs and hashes (only for images that exist)
-  for (int i = 0; i < state.imageCount && i < 12; i++)
+  if (!writeImageTable(state))
   {
-    String idKey = "imgId" + String(i);     // was "imageId" + String(i)
-    String hashKey = "imgHash" + String(i); // was "imageHash" + String(i)
-    result = preferences.putString(idKey.c_str(), state.imageIds[i]);
-    if (result == 0)
-    {
-      end();
-      return false;
-    }
-    result = preferences.putString(hashKey.c_str(), state.imageHashes[i]);
-    if (result == 0)
-    {
-      end();
-      return false;
-    }
+    end();
+    return false;
   }
 
-  // Clear any old image entries beyond current count
-  // Note: remove() will fail with NOT_FOUND if key doesn't exist - this is harmless
-  for (int i = state.imageCount; i < 12; i++)
+  // Remove per-image keys written by older firmware
+  if (preferences.isKey("imgId0"))
   {
-    String idKey = "imgId" + String(i);     // was "imageId" + String(i)
-    String hashKey = "imgHash" + String(i); // was "imageHash" + String(i)
-    preferences.remove(idKey.c_str());      // Ignore NOT_FOUND errors - they're harmless
-    preferences.remove(hashKey.c_str());    // Ignore NOT_FOUND errors - they're harmless
+    char key[16];
+    for (int i = 0; i < LEGACY_MAX_IMAGES; i++)
+    {
+      snprintf(key, sizeof(key), "imgId%d", i);
+      eraseKey(key);
+      snprintf(key, sizeof(key), "imgH%d", i);
+      eraseKey(key);
+      snprintf(key, sizeof(key), "imgHash%d", i);
+      eraseKey(key);
+    }
   }
 
   end();
@@ -162,23 +226,98 @@ bool NVSStorage::loadState(DeviceState &state)
   // state.slideshowVersion, state.imageCount);
 
   // Load image IDs and hashes
-  for (int i = 0; i < state.imageCount && i < 12; i++)
-  {
-    String idKey = "imgId" + String(i);     // was "imageId" + String(i)
-    String hashKey = "imgHash" + String(i); // was "imageHash" + String(i)
-    state.imageIds[i] = preferences.getString(idKey.c_str(), "");
-    state.imageHashes[i] = preferences.getString(hashKey.c_str(), "");
-  }
+  readImageTable(state);
 
   end();
   return true;
 }
 
+bool NVSStorage::loadImageTable(DeviceState &state)
+{
+  if (!begin())
+    return false;
+  state.imageCount = preferences.getInt("imgCnt", 0);
+  // An unfinished update may have recorded more slots than the slideshow has
+  int recorded = preferences.getBytesLength("imgHashes") / sizeof(ImageHash);
+  if (recorded > state.imageCount)
+    state.imageCount = recorded;
+  readImageTable(state);
+  end();
+  return true;
+}
+
+bool NVSStorage::saveImageTable(const DeviceState &state)
+{
+  preferences.end();
+  if (!begin())
+    return false;
+  bool success = writeImageTable(state);
+  end();
+  return success;
+}
+
+// Save image IDs and hashes as two packed blobs (only images that exist).
+// One blob write per table instead of two keys per image keeps NVS usage
+// flat as slideshows grow past a dozen images. Preferences must be open.
+bool NVSStorage::writeImageTable(const DeviceState &state)
+{
+  int count = (state.imageCount < DeviceState::capacity) ? state.imageCount : DeviceState::capacity;
+  if (count > 0)
+  {
+    return writeBytes("imgIds", state.imageIds, count * sizeof(ImageId)) != 0 &&
+           writeBytes("imgHashes", state.imageHashes, count * sizeof(ImageHash)) != 0;
+  }
+  eraseKey("imgIds");
+  eraseKey("imgHashes");
+  return true;
+}
+
+// Reads the image table for state.imageCount images (preferences must be open)
+void NVSStorage::readImageTable(DeviceState &state)
+{
+  int count = (state.imageCount < DeviceState::capacity) ? state.imageCount : DeviceState::capacity;
+  if (count <= 0)
+    return;
+
+  memset(state.imageIds, 0, count * sizeof(ImageId));
+  memset(state.imageHashes, 0, count * sizeof(ImageHash));
+
+  if (preferences.isKey("imgIds"))
+  {
+    // Read the whole blobs - they can be longer than imgCnt (see loadImageTable)
+    preferences.getBytes("imgIds", state.imageIds, sizeof(state.imageIds));
+    preferences.getBytes("imgHashes", state.imageHashes, sizeof(state.imageHashes));
+    return;
+  }
+
+  // Older firmware stored one key per image (hash as blob or hex string)
+  char key[16];
+  for (int i = 0; i < count && i < LEGACY_MAX_IMAGES; i++)
+  {
+    snprintf(key, sizeof(key), "imgId%d", i);
+    preferences.getString(key, state.imageIds[i], sizeof(state.imageIds[i]));
+
+    snprintf(key, sizeof(key), "imgH%d", i);
+    if (preferences.getBytesLength(key) == IMAGE_HASH_BYTES)
+    {
+      preferences.getBytes(key, state.imageHashes[i], IMAGE_HASH_BYTES);
+    }
+    else
+    {
+      char hashHex[IMAGE_HASH_BYTES * 2 + 1] = "";
+      snprintf(key, sizeof(key), "imgHash%d", i);
+      preferences.getString(key, hashHex, sizeof(hashHex));
+      hexToBytes(hashHex, state.imageHashes[i], IMAGE_HASH_BYTES);
+    }
+  }
+}
+
 bool NVSStorage::clearState()
 {
   if (!begin())
     return false;
   preferences.clear();
+  writeCounters.operations++;
   end();
   return true;
 }
@@ -187,7 +326,7 @@ bool NVSStorage::saveInt(const char *key, int value)
 {
   if (!begin())
     return false;
-  bool result = preferences.putInt(key, value);
+  bool result = writeInt(key, value);
   end();
   return result;
 }
@@ -201,50 +340,39 @@ int NVSStorage::loadInt(const char *key, int defaultValue)
   return value;
 }
 
-bool NVSStorage::saveString(const char *key, const String &value)
+bool NVSStorage::saveString(const char *key, const char *value)
 {
   if (!begin())
     return false;
-  bool result = preferences.putString(key, value);
+  bool result = writeString(key, value);
   end();
   return result;
 }
 
-String NVSStorage::loadString(const char *key, const String &defaultValue)
+bool NVSStorage::loadString(const char *key, char *value, size_t valueSize)
 {
+  value[0] = '\0';
   if (!begin())
-    return defaultValue;
-  String value = preferences.getString(key, defaultValue);
+    return false;
+  size_t length = preferences.getString(key, value, valueSize);
   end();
-  return value;
+  return length > 0;
 }
 
-bool NVSStorage::saveStringArray(const char *key, const String *values, int count)
+bool NVSStorage::saveBytes(const char *key, const void *value, size_t length)
 {
   if (!begin())
     return false;
-  preferences.putInt(key, count);
-  for (int i = 0; i < count; i++)
-  {
-    String itemKey = String(key) + "_" + String(i);
-    preferences.putString(itemKey.c_str(), values[i]);
-  }
+  bool result = writeBytes(key, value, length) == length;
   end();
-  return true;
+  return result;
 }
 
-int NVSStorage::loadStringArray(const char *key, String *values, int maxCount)
+size_t NVSStorage::loadBytes(const char *key, void *value, size_t length)
 {
   if (!begin())
     return 0;
-  int count = preferences.getInt(key, 0);
-  if (count > maxCount)
-    count = maxCount;
-  for (int i = 0; i < count; i++)
-  {
-    String itemKey = String(key) + "_" + String(i);
-    values[i] = preferences.getString(itemKey.c_str(), "");
-  }
+  size_t result = preferences.getBytesLength(key) == length ? preferences.getBytes(key, value, length) : 0;
   end();
-  return count;
+  return result;
 }
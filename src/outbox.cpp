@@ -0,0 +1,84 @@
+#include "outbox.h"
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include "config.h"
+
+#define OUTBOX_MAGIC 0x5050414B // "PPAK"
+
+struct RTCOutboxRecord {
+  uint32_t magic;
+  int32_t ackVersion;  // -1 = nothing to ACK
+  uint8_t eventCount;
+  OutboxEntry events[OUTBOX_CAPACITY];
+  uint32_t checksum;
+};
+
+RTC_DATA_ATTR static RTCOutboxRecord rtcOutbox;
+
+static uint32_t checksum() {
+  return esp_rom_crc32_le(0, (const uint8_t*)&rtcOutbox, offsetof(RTCOutboxRecord, checksum));
+}
+
+void Outbox::store() {
+  rtcOutbox.magic = OUTBOX_MAGIC;
+  rtcOutbox.checksum = checksum();
+}
+
+void Outbox::begin() {
+  if (rtcOutbox.magic == OUTBOX_MAGIC && rtcOutbox.checksum == checksum()) {
+    return;
+  }
+  memset(&rtcOutbox, 0, sizeof(rtcOutbox));
+  rtcOutbox.ackVersion = -1;
+  store();
+}
+
+void Outbox::push(OutboxType type, int32_t value) {
+  if (type == OUTBOX_ACK_DISPLAYED) {
+    rtcOutbox.ackVersion = value;
+  } else {
+    if (rtcOutbox.eventCount == OUTBOX_CAPACITY) {
+      memmove(&rtcOutbox.events[0], &rtcOutbox.events[1], (OUTBOX_CAPACITY - 1) * sizeof(OutboxEntry));
+      rtcOutbox.eventCount--;
+    }
+    rtcOutbox.events[rtcOutbox.eventCount].type = type;
+    rtcOutbox.events[rtcOutbox.eventCount].value = value;
+    rtcOutbox.eventCount++;
+  }
+  store();
+}
+
+int Outbox::count() {
+  return rtcOutbox.eventCount + (rtcOutbox.ackVersion >= 0 ? 1 : 0);
+}
+
+int32_t Outbox::pendingAck() {
+  return rtcOutbox.ackVersion;
+}
+
+bool Outbox::formatQuery(char* buffer, size_t size) {
+  size_t length = 0;
+  int written = 0;
+  buffer[0] = '\0';
+  if (rtcOutbox.ackVersion >= 0) {
+    written = snprintf(buffer, size, "&ack=%ld", (long)rtcOutbox.ackVersion);
+    if (written < 0 || (size_t)written >= size) return false;
+    length = written;
+  }
+  for (int i = 0; i < rtcOutbox.eventCount; i++) {
+    written = snprintf(buffer + length, size - length, "%s%u.%ld", (i == 0) ? "&events=" : ",",
+                       (unsigned)rtcOutbox.events[i].type, (long)rtcOutbox.events[i].value);
+    if (written < 0 || (size_t)written >= size - length) {
+      buffer[0] = '\0';
+      return false;
+    }
+    length += written;
+  }
+  return true;
+}
+
+void Outbox::clear() {
+  rtcOutbox.ackVersion = -1;
+  rtcOutbox.eventCount = 0;
+  store();
+}
@@ -0,0 +1,147 @@
+#include "power_profile.h"
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include <sys/time.h>
+#include "config.h"
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+
+struct ProfileConfig {
+  const char* name;
+  uint16_t maxMhz;    // esp_pm max (and the fixed clock without esp_pm)
+  uint16_t minMhz;    // esp_pm min, 0 = XTAL
+  bool lightSleep;
+};
+
+static const ProfileConfig profileConfigs[POWER_PROFILE_COUNT] = {
+  {"crypto", POWER_MAX_CPU_MHZ, POWER_MAX_CPU_MHZ, false},
+  {"io",     POWER_MAX_CPU_MHZ, 0,                 false},
+  {"bus",    80,                80,                false},
+  {"idle",   80,                0,                 true},
+};
+
+#define SLEEP_RECORD_MAGIC 0x50505331 // "PPS1"
+
+// The RTC clock keeps running in deep sleep, so the sleep length is the
+// difference between the time at beginDeepSleep() and the time at begin().
+// Server time steps the clock during wakes, never in between.
+struct RTCSleepRecord {
+  uint32_t magic;
+  int64_t startUs;  // 0 = not sleeping (cold boot, or a reset mid-wake)
+  uint32_t checksum;
+};
+
+RTC_DATA_ATTR static RTCSleepRecord rtcSleep;
+
+static PowerProfile currentProfile = POWER_PROFILE_BUS;
+static unsigned long profileStartMs = 0;
+static uint32_t residencyMs[POWER_PROFILE_COUNT];
+static uint32_t sleptMs = 0;
+static bool started = false;
+
+static int64_t rtcTimeUs() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+static uint32_t sleepChecksum() {
+  return esp_rom_crc32_le(0, (const uint8_t*)&rtcSleep, offsetof(RTCSleepRecord, checksum));
+}
+
+static void storeSleep(int64_t startUs) {
+  rtcSleep.magic = SLEEP_RECORD_MAGIC;
+  rtcSleep.startUs = startUs;
+  rtcSleep.checksum = sleepChecksum();
+}
+
+void PowerManager::apply(PowerProfile profile) {
+  const ProfileConfig& config = profileConfigs[profile];
+#if CONFIG_PM_ENABLE
+  esp_pm_config_t pmConfig = {};
+  pmConfig.max_freq_mhz = config.maxMhz;
+  pmConfig.min_freq_mhz = config.minMhz ? config.minMhz : getXtalFrequencyMhz();
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  pmConfig.light_sleep_enable = config.lightSleep;
+#endif
+  esp_pm_configure(&pmConfig);
+#else
+  // No dynamic scaling - the radio needs at least 80 MHz
+  uint32_t mhz = (profile == POWER_PROFILE_CRYPTO) ? config.maxMhz : 80;
+  if (getCpuFrequencyMhz() != mhz) {
+    setCpuFrequencyMhz(mhz);
+  }
+#endif
+}
+
+void PowerManager::account() {
+  unsigned long now = millis();
+  residencyMs[currentProfile] += now - profileStartMs;
+  profileStartMs = now;
+}
+
+void PowerManager::begin() {
+  memset(residencyMs, 0, sizeof(residencyMs));
+  // Everything before begin() ran at the boot clock - count it as bus time
+  residencyMs[POWER_PROFILE_BUS] = millis();
+  profileStartMs = millis();
+  currentProfile = POWER_PROFILE_BUS;
+  started = true;
+  apply(currentProfile);
+
+  if (rtcSleep.magic == SLEEP_RECORD_MAGIC && rtcSleep.checksum == sleepChecksum() && rtcSleep.startUs != 0) {
+    int64_t sleptUs = rtcTimeUs() - rtcSleep.startUs;
+    sleptMs = (sleptUs > 0) ? (uint32_t)(sleptUs / 1000) : 0;
+  }
+  storeSleep(0);
+}
+
+uint32_t PowerManager::getSleptMs() {
+  return sleptMs;
+}
+
+void PowerManager::beginDeepSleep() {
+  storeSleep(rtcTimeUs());
+}
+
+void PowerManager::setProfile(PowerProfile profile) {
+  if (!started) begin();
+  if (profile == currentProfile) return;
+  account();
+  currentProfile = profile;
+  apply(profile);
+}
+
+PowerProfile PowerManager::getProfile() {
+  return currentProfile;
+}
+
+uint32_t PowerManager::getResidencyMs(PowerProfile profile) {
+  uint32_t ms = residencyMs[profile];
+  if (profile == currentProfile) {
+    ms += millis() - profileStartMs;
+  }
+  return ms;
+}
+
+uint16_t PowerManager::getTypicalMhz(PowerProfile profile) {
+  const ProfileConfig& config = profileConfigs[profile];
+#if CONFIG_PM_ENABLE
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  if (config.lightSleep) return 0;
+#endif
+  return config.minMhz ? config.minMhz : getXtalFrequencyMhz();
+#else
+  return (profile == POWER_PROFILE_CRYPTO) ? config.maxMhz : 80;
+#endif
+}
+
+void PowerManager::printDiagnostics() {
+  for (int i = 0; i < POWER_PROFILE_COUNT; i++) {
+    uint32_t ms = getResidencyMs((PowerProfile)i);
+    if (ms == 0) continue;
+    Serial.printf("Power %-6s:            %6lu ms at %u MHz\n", profileConfigs[i].name,
+                  (unsigned long)ms, getTypicalMhz((PowerProfile)i));
+  }
+}
@@ -0,0 +1,98 @@
+#include "state_cache.h"
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include "trace.h"
+
+#define STATE_CACHE_MAGIC 0x50505331 // "PPS1"
+
+// State mirrored in RTC slow memory, survives deep sleep but not power loss
+struct RTCStateRecord {
+  uint32_t magic;
+  int32_t currentImageIndex;
+  int32_t wakeCounter;
+  int32_t slideshowVersion;
+  int32_t imageCount;
+  // Values last written to NVS, used to decide when a commit is needed
+  int32_t persistedVersion;
+  int32_t persistedImageCount;
+  StateCacheStats stats;
+  uint32_t checksum;
+};
+
+RTC_DATA_ATTR static RTCStateRecord rtcState;
+
+bool StateCache::warm = false;
+
+uint32_t StateCache::checksum() {
+  return esp_rom_crc32_le(0, (const uint8_t*)&rtcState, offsetof(RTCStateRecord, checksum));
+}
+
+void StateCache::storeRTC(const DeviceState& state) {
+  rtcState.magic = STATE_CACHE_MAGIC;
+  rtcState.currentImageIndex = state.currentImageIndex;
+  rtcState.wakeCounter = state.wakeCounter;
+  rtcState.slideshowVersion = state.slideshowVersion;
+  rtcState.imageCount = state.imageCount;
+  rtcState.checksum = checksum();
+}
+
+bool StateCache::load(DeviceState& state) {
+  if (rtcState.magic == STATE_CACHE_MAGIC && rtcState.checksum == checksum()) {
+    state.currentImageIndex = rtcState.currentImageIndex;
+    state.wakeCounter = rtcState.wakeCounter;
+    state.slideshowVersion = rtcState.slideshowVersion;
+    state.imageCount = rtcState.imageCount;
+    rtcState.stats.nvsLoadsAvoided++;
+    rtcState.checksum = checksum();
+    warm = true;
+    return true;
+  }
+
+  // Cold boot - RTC memory was lost, NVS is the source of truth
+  warm = false;
+  memset(&rtcState, 0, sizeof(rtcState));
+  bool loaded = NVSStorage::loadState(state);
+  if (loaded) {
+    rtcState.persistedVersion = state.slideshowVersion;
+    rtcState.persistedImageCount = state.imageCount;
+  } else {
+    // Nothing in NVS yet - first save must commit
+    rtcState.persistedVersion = -1;
+    rtcState.persistedImageCount = -1;
+  }
+  storeRTC(state);
+  return loaded;
+}
+
+bool StateCache::save(const DeviceState& state) {
+  if (state.slideshowVersion != rtcState.persistedVersion ||
+      state.imageCount != rtcState.persistedImageCount) {
+    return commit(state);
+  }
+
+  rtcState.stats.nvsWritesAvoided++;
+  storeRTC(state);
+  return true;
+}
+
+bool StateCache::commit(const DeviceState& state) {
+  TRACE_SCOPE("nvs.commit");
+  NVSStorage::end();
+  bool success = NVSStorage::saveState(state);
+  if (success) {
+    rtcState.persistedVersion = state.slideshowVersion;
+    rtcState.persistedImageCount = state.imageCount;
+    rtcState.stats.nvsWrites++;
+  }
+  // RTC copy is updated even if NVS failed, so the next wake still sees it
+  storeRTC(state);
+  return success;
+}
+
+bool StateCache::isWarm() {
+  return warm;
+}
+
+const StateCacheStats& StateCache::getStats() {
+  return rtcState.stats;
+}
@@ -0,0 +1,146 @@
+#include "trace.h"
+
+#if TRACE_ENABLED
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define TRACE_MAGIC 0x50505452 // "PPTR"
+#define TRACE_MAX_NAMES 32
+
+struct TraceEntry {
+  uint32_t startUs;     // Since boot of its wake
+  uint32_t durationUs;
+  uint16_t wake;
+  uint8_t task;         // 0 = loop task, 1 = background
+  uint8_t depth;
+  char name[TRACE_NAME_LEN];
+};
+
+// Only bounds are checked on wake, not a checksum - a few garbled entries
+// after a brown-out are acceptable for a debugging aid
+struct RTCTraceRecord {
+  uint32_t magic;
+  uint16_t wake;
+  uint32_t written;     // Entries ever written; index = written % TRACE_RING_SIZE
+  uint32_t dumped;      // Entries already printed by dump()
+  TraceEntry entries[TRACE_RING_SIZE];
+};
+
+RTC_DATA_ATTR static RTCTraceRecord rtcTrace;
+
+struct TraceTotal {
+  const char* name;     // Span names are string literals, never copied
+  uint32_t firstStartUs;
+  uint64_t totalUs;
+  uint16_t count;
+  uint8_t depth;
+};
+
+static TraceTotal totals[TRACE_MAX_NAMES];
+static int totalCount = 0;
+static TaskHandle_t loopTask = nullptr;
+static uint8_t loopDepth = 0;
+static portMUX_TYPE traceLock = portMUX_INITIALIZER_UNLOCKED;
+
+void Trace::begin() {
+  if (rtcTrace.magic != TRACE_MAGIC || rtcTrace.dumped > rtcTrace.written) {
+    memset(&rtcTrace, 0, sizeof(rtcTrace));
+    rtcTrace.magic = TRACE_MAGIC;
+  }
+  rtcTrace.wake++;
+  totalCount = 0;
+  loopDepth = 0;
+  loopTask = xTaskGetCurrentTaskHandle();
+}
+
+uint8_t Trace::enter() {
+  if (xTaskGetCurrentTaskHandle() != loopTask) {
+    return TRACE_DEPTH_BACKGROUND;
+  }
+  return loopDepth++;
+}
+
+void Trace::record(const char* name, int64_t startUs, int64_t endUs, uint8_t depth) {
+  bool background = (depth == TRACE_DEPTH_BACKGROUND || xTaskGetCurrentTaskHandle() != loopTask);
+  if (background) {
+    depth = TRACE_DEPTH_BACKGROUND;
+  } else if (depth == TRACE_DEPTH_CURRENT) {
+    depth = loopDepth;
+  } else {
+    loopDepth = depth; // Span closed - back to its parent's level
+  }
+
+  portENTER_CRITICAL(&traceLock);
+  TraceEntry& entry = rtcTrace.entries[rtcTrace.written % TRACE_RING_SIZE];
+  entry.startUs = (uint32_t)startUs;
+  entry.durationUs = (uint32_t)(endUs - startUs);
+  entry.wake = rtcTrace.wake;
+  entry.task = background ? 1 : 0;
+  entry.depth = background ? 0 : depth;
+  strncpy(entry.name, name, TRACE_NAME_LEN - 1);
+  entry.name[TRACE_NAME_LEN - 1] = '\0';
+  rtcTrace.written++;
+
+  TraceTotal* total = nullptr;
+  for (int i = 0; i < totalCount; i++) {
+    if (totals[i].name == name || strcmp(totals[i].name, name) == 0) {
+      total = &totals[i];
+      break;
+    }
+  }
+  if (!total && totalCount < TRACE_MAX_NAMES) {
+    total = &totals[totalCount++];
+    total->name = name;
+    total->firstStartUs = (uint32_t)startUs;
+    total->totalUs = 0;
+    total->count = 0;
+    total->depth = depth;
+  }
+  if (total) {
+    total->totalUs += endUs - startUs;
+    total->count++;
+    if ((uint32_t)startUs < total->firstStartUs) total->firstStartUs = (uint32_t)startUs;
+  }
+  portEXIT_CRITICAL(&traceLock);
+}
+
+uint32_t Trace::getTotalUs(const char* name) {
+  for (int i = 0; i < totalCount; i++) {
+    if (strcmp(totals[i].name, name) == 0) return (uint32_t)totals[i].totalUs;
+  }
+  return 0;
+}
+
+void Trace::printWake() {
+  // Parents are recorded after their children - print in start order
+  bool printed[TRACE_MAX_NAMES] = {};
+  for (int n = 0; n < totalCount; n++) {
+    int next = -1;
+    for (int i = 0; i < totalCount; i++) {
+      if (!printed[i] && (next < 0 || totals[i].firstStartUs < totals[next].firstStartUs)) next = i;
+    }
+    printed[next] = true;
+    const TraceTotal& total = totals[next];
+    bool background = (total.depth == TRACE_DEPTH_BACKGROUND);
+    int indent = background ? 0 : total.depth * 2;
+    Serial.printf("%*s%-*s %8.1f ms", indent, "", 24 - indent, total.name, total.totalUs / 1000.0f);
+    if (total.count > 1) Serial.printf("  (%u x)", total.count);
+    Serial.println(background ? "  [background]" : "");
+  }
+}
+
+void Trace::dump() {
+  uint32_t first = rtcTrace.dumped;
+  if (rtcTrace.written - first > TRACE_RING_SIZE) {
+    first = rtcTrace.written - TRACE_RING_SIZE; // Older entries were overwritten
+  }
+  for (uint32_t i = first; i < rtcTrace.written; i++) {
+    const TraceEntry& entry = rtcTrace.entries[i % TRACE_RING_SIZE];
+    Serial.printf("TRACE,%u,%u,%u,%lu,%lu,%s\n", entry.wake, entry.task, entry.depth,
+                  (unsigned long)entry.startUs, (unsigned long)entry.durationUs, entry.name);
+  }
+  rtcTrace.dumped = rtcTrace.written;
+}
+
+#endif
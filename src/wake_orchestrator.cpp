@@ -0,0 +1,89 @@
+#include "wake_orchestrator.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
+#include "EPD_4in0e.h"
+#include "DEV_Config.h"
+
+#define PANEL_READY_BIT BIT0
+#define PANEL_TASK_STACK 4096
+
+struct PhaseSpan {
+  unsigned long startMs;
+  unsigned long endMs;
+  bool used;
+};
+
+static PhaseSpan phases[WAKE_PHASE_COUNT];
+static EventGroupHandle_t bootEvents = nullptr;
+static bool panelStarted = false;
+static bool panelReady = false;
+
+static const char* const phaseNames[WAKE_PHASE_COUNT] = {
+  "WiFi", "State", "Flash mount", "Panel init"
+};
+
+void WakeOrchestrator::beginPhase(WakePhase phase) {
+  phases[phase].startMs = millis();
+  phases[phase].endMs = phases[phase].startMs;
+  phases[phase].used = true;
+}
+
+void WakeOrchestrator::endPhase(WakePhase phase) {
+  phases[phase].endMs = millis();
+}
+
+static void panelInitTask(void*) {
+  WakeOrchestrator::beginPhase(WAKE_PHASE_PANEL_INIT);
+  DEV_Module_Init();
+  EPD_4IN0E_Init();
+  WakeOrchestrator::endPhase(WAKE_PHASE_PANEL_INIT);
+  xEventGroupSetBits(bootEvents, PANEL_READY_BIT);
+  vTaskDelete(nullptr);
+}
+
+void WakeOrchestrator::startPanelInit() {
+  if (panelStarted || panelReady) return;
+  if (!bootEvents) {
+    bootEvents = xEventGroupCreate();
+  }
+  // Runs alongside the radio - BUSY waits must poll, not light sleep
+  EPD_4IN0E_SetBusyLightSleep(false);
+  panelStarted = xTaskCreate(panelInitTask, "panel_init", PANEL_TASK_STACK, nullptr,
+                             uxTaskPriorityGet(nullptr), nullptr) == pdPASS;
+}
+
+bool WakeOrchestrator::ensurePanelReady(uint32_t timeoutMs) {
+  if (panelReady) return true;
+
+  if (panelStarted) {
+    EventBits_t bits = xEventGroupWaitBits(bootEvents, PANEL_READY_BIT, pdFALSE, pdTRUE,
+                                           pdMS_TO_TICKS(timeoutMs));
+    panelReady = (bits & PANEL_READY_BIT) != 0;
+    return panelReady;
+  }
+
+  beginPhase(WAKE_PHASE_PANEL_INIT);
+  DEV_Module_Init();
+  EPD_4IN0E_Init();
+  endPhase(WAKE_PHASE_PANEL_INIT);
+  panelReady = true;
+  return true;
+}
+
+void WakeOrchestrator::printDiagnostics() {
+  // Boot = every phase that started while WiFi was still associating
+  const PhaseSpan& wifi = phases[WAKE_PHASE_WIFI];
+  unsigned long first = ~0UL;
+  unsigned long last = 0;
+  for (int i = 0; i < WAKE_PHASE_COUNT; i++) {
+    if (!phases[i].used) continue;
+    Serial.printf("  %-12s         %6lu -> %lu ms\n", phaseNames[i], phases[i].startMs, phases[i].endMs);
+    if (wifi.used && phases[i].startMs > wifi.endMs) continue;
+    if (phases[i].startMs < first) first = phases[i].startMs;
+    if (phases[i].endMs > last) last = phases[i].endMs;
+  }
+  if (last >= first) {
+    Serial.printf("Boot critical path:      %6lu ms\n", last - first);
+  }
+}
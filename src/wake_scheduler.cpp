@@ -0,0 +1,298 @@
+#include "wake_scheduler.h"
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include <esp_mac.h>
+#include <sys/time.h>
+#include <time.h>
+#include "nvs_storage.h"
+
+#define WAKE_SCHEDULER_MAGIC 0x50505332 // "PPS2"
+#define DWELL_NVS_KEY "imgDwell"
+#define DUE_SLACK_SECONDS 60             // Timer wakes drift - treat this close as due
+#define MAX_SERVER_CHECK_SECONDS (7UL * 24UL * 3600UL)
+#define MIN_SLEEP_SECONDS 60
+#define SECONDS_PER_DAY 86400
+
+// Scheduling state in RTC slow memory. Times are system time in seconds,
+// which keeps running through deep sleep (unsynced it counts from power-on).
+struct RTCScheduleRecord {
+  uint32_t magic;
+  int64_t lastAdvanceTime;       // Current image started showing
+  int64_t lastCheckTime;         // Last update check, successful or not
+  int64_t lastChangeTime;        // Last new slideshow seen (0 = none yet)
+  uint32_t currentDwell;         // Seconds the current image stays up
+  uint32_t updateIntervalEwma;   // Average seconds between slideshow changes (0 = unknown)
+  uint32_t serverCheckInterval;  // Server nextCheckSeconds hint (0 = none)
+  uint32_t serverCheckSpread;    // Server checkSpreadSeconds hint (0 = none)
+  uint32_t splay;                // Per-device hash of the MAC, spreads checks over the fleet
+  int64_t backoffUntil;          // Next check after a failure
+  uint8_t consecutiveFailures;   // Failed checks in a row (0 = not backing off)
+  CheckFailure lastFailure;
+  int32_t utcOffset;             // Seconds east of UTC, for quiet hours
+  int32_t imageCount;
+  bool timeSynced;               // System time was set from the server
+  bool checkedSinceBoot;         // An update check has happened since cold boot
+  bool dwellLoaded;              // dwellMinutes is current (read from NVS or manifest)
+  uint16_t dwellMinutes[MAX_IMAGES];
+  uint32_t checksum;
+};
+
+RTC_DATA_ATTR static RTCScheduleRecord rtcSchedule;
+
+static uint32_t checksum() {
+  return esp_rom_crc32_le(0, (const uint8_t*)&rtcSchedule, offsetof(RTCScheduleRecord, checksum));
+}
+
+static int64_t now() {
+  return (int64_t)time(nullptr);
+}
+
+// Same MAC as the device ID, mixed so sequential MACs land far apart
+static uint32_t deviceSplay() {
+  uint8_t mac[6] = {0};
+  esp_read_mac(mac, ESP_MAC_WIFI_STA);
+  uint32_t h = esp_rom_crc32_le(0, mac, sizeof(mac));
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+void WakeScheduler::store() {
+  rtcSchedule.magic = WAKE_SCHEDULER_MAGIC;
+  rtcSchedule.checksum = checksum();
+}
+
+void WakeScheduler::begin() {
+  if (rtcSchedule.magic == WAKE_SCHEDULER_MAGIC && rtcSchedule.checksum == checksum()) {
+    return;
+  }
+  // Cold boot - check soon, current image gets a full dwell
+  memset(&rtcSchedule, 0, sizeof(rtcSchedule));
+  int64_t t = now();
+  rtcSchedule.splay = deviceSplay();
+  rtcSchedule.lastCheckTime = t;
+  rtcSchedule.lastAdvanceTime = t;
+  rtcSchedule.currentDwell = DEFAULT_DWELL_SECONDS;
+  store();
+}
+
+void WakeScheduler::setImageCount(int count) {
+  if (count > MAX_IMAGES) count = MAX_IMAGES;
+  if (!rtcSchedule.dwellLoaded && count > 0) {
+    NVSStorage::loadBytes(DWELL_NVS_KEY, rtcSchedule.dwellMinutes, count * sizeof(uint16_t));
+    rtcSchedule.dwellLoaded = true;
+  }
+  rtcSchedule.imageCount = count;
+  store();
+}
+
+uint32_t WakeScheduler::dwellSeconds(int index) {
+  uint16_t minutes = (index >= 0 && index < MAX_IMAGES) ? rtcSchedule.dwellMinutes[index] : 0;
+  return minutes ? minutes * 60UL : DEFAULT_DWELL_SECONDS;
+}
+
+int64_t WakeScheduler::nextAdvanceTime() {
+  if (rtcSchedule.imageCount < 2) {
+    return INT64_MAX; // Nothing to advance to
+  }
+  return rtcSchedule.lastAdvanceTime + rtcSchedule.currentDwell;
+}
+
+// Move t out of the quiet period, to QUIET_HOURS_END local time
+static int64_t skipQuietHours(int64_t t) {
+  int64_t local = t + rtcSchedule.utcOffset;
+  int64_t secondOfDay = ((local % SECONDS_PER_DAY) + SECONDS_PER_DAY) % SECONDS_PER_DAY;
+  int hour = (int)(secondOfDay / 3600);
+  bool quiet = (QUIET_HOURS_START > QUIET_HOURS_END)
+                   ? (hour >= QUIET_HOURS_START || hour < QUIET_HOURS_END)
+                   : (hour >= QUIET_HOURS_START && hour < QUIET_HOURS_END);
+  if (!quiet) {
+    return t;
+  }
+  int64_t untilEnd = ((int64_t)QUIET_HOURS_END * 3600 - secondOfDay + SECONDS_PER_DAY) % SECONDS_PER_DAY;
+  return t + untilEnd;
+}
+
+int64_t WakeScheduler::nextCheckTime() {
+  if (!rtcSchedule.checkedSinceBoot) {
+    // Frames power cycled together (power cut) would all check at once.
+    // A frame without a slideshow yet is being set up - check right away.
+    if (rtcSchedule.imageCount == 0) return rtcSchedule.lastCheckTime;
+    return rtcSchedule.lastCheckTime + rtcSchedule.splay % COLD_BOOT_SPREAD_SECONDS;
+  }
+
+  if (rtcSchedule.consecutiveFailures > 0) {
+    int64_t t = rtcSchedule.backoffUntil;
+    int64_t quietEnd = rtcSchedule.timeSynced ? skipQuietHours(t) : t;
+    return (quietEnd == t) ? t : quietEnd + rtcSchedule.splay % CHECK_SPREAD_SECONDS;
+  }
+
+  uint32_t interval;
+  if (rtcSchedule.serverCheckInterval > 0) {
+    interval = rtcSchedule.serverCheckInterval;
+    if (interval > MAX_SERVER_CHECK_SECONDS) interval = MAX_SERVER_CHECK_SECONDS;
+  } else if (rtcSchedule.updateIntervalEwma > 0) {
+    // Check a few times per typical update so changes show up reasonably soon
+    interval = rtcSchedule.updateIntervalEwma / 4;
+    if (interval > MAX_CHECK_INTERVAL_SECONDS) interval = MAX_CHECK_INTERVAL_SECONDS;
+  } else {
+    interval = DEFAULT_CHECK_INTERVAL_SECONDS;
+  }
+  if (interval < MIN_CHECK_INTERVAL_SECONDS) interval = MIN_CHECK_INTERVAL_SECONDS;
+
+  uint32_t window = rtcSchedule.serverCheckSpread ? rtcSchedule.serverCheckSpread : CHECK_SPREAD_SECONDS;
+  if (window > interval) window = interval;
+  int64_t phase = window ? rtcSchedule.splay % window : 0;
+
+  int64_t target = rtcSchedule.lastCheckTime + interval;
+  if (!rtcSchedule.timeSynced) {
+    return target + phase;
+  }
+  // Land on this device's phase within a wall clock window centred on the
+  // target - the fleet's checks spread evenly over every window, whenever
+  // the individual frames last checked
+  int64_t t = target - window / 2;
+  if (window) t += ((phase - t) % window + window) % window;
+  int64_t quietEnd = skipQuietHours(t);
+  return (quietEnd == t) ? t : quietEnd + phase;
+}
+
+uint8_t WakeScheduler::getDueActions() {
+  int64_t t = now();
+  int64_t advanceAt = nextAdvanceTime();
+  int64_t checkAt = nextCheckTime();
+  bool advanceDue = t + DUE_SLACK_SECONDS >= advanceAt;
+  bool checkDue = t + DUE_SLACK_SECONDS >= checkAt;
+
+  // Pull the other deadline in if it would otherwise need its own wake soon
+  if (advanceDue && checkAt - t <= (int64_t)WAKE_COALESCE_SECONDS) checkDue = true;
+  if (checkDue && advanceAt - t <= (int64_t)WAKE_COALESCE_SECONDS) advanceDue = true;
+
+  return (advanceDue ? WAKE_ACTION_ADVANCE : 0) | (checkDue ? WAKE_ACTION_CHECK : 0);
+}
+
+void WakeScheduler::noteAdvanced(int currentIndex) {
+  rtcSchedule.lastAdvanceTime = now();
+  rtcSchedule.currentDwell = dwellSeconds(currentIndex);
+  store();
+}
+
+// Exponential backoff with deterministic per-device jitter in [delay/2, delay)
+static uint32_t backoffSeconds(CheckFailure failure, uint8_t failures, uint32_t retryAfter) {
+  uint32_t delay = BACKOFF_BASE_SECONDS;
+  if (failure == CHECK_FAILURE_CREDENTIALS || failure == CHECK_FAILURE_REJECTED) {
+    delay = BACKOFF_MAX_SECONDS / 4; // Won't fix itself - don't keep waking the radio for it
+  }
+  for (uint8_t i = 1; i < failures && delay < BACKOFF_MAX_SECONDS; i++) {
+    delay *= 2;
+  }
+  if (delay > BACKOFF_MAX_SECONDS) delay = BACKOFF_MAX_SECONDS;
+
+  uint32_t hash = esp_rom_crc32_le(rtcSchedule.splay, &failures, sizeof(failures));
+  delay = delay / 2 + hash % (delay / 2 + 1);
+
+  if (retryAfter > delay) {
+    delay = (retryAfter < MAX_SERVER_CHECK_SECONDS) ? retryAfter : MAX_SERVER_CHECK_SECONDS;
+  }
+  return delay;
+}
+
+void WakeScheduler::noteChecked(const SlideshowVersionResponse* response, bool slideshowChanged,
+                                CheckFailure failure, uint32_t retryAfterSeconds) {
+  if (response && response->success) {
+    // Step the clock to server time, shifting stored times along with it
+    if (response->serverTime > 0) {
+      int64_t delta = response->serverTime - now();
+      if (delta > 2 || delta < -2) {
+        struct timeval tv = {(time_t)response->serverTime, 0};
+        settimeofday(&tv, nullptr);
+        rtcSchedule.lastAdvanceTime += delta;
+        rtcSchedule.lastCheckTime += delta;
+        if (rtcSchedule.lastChangeTime != 0) rtcSchedule.lastChangeTime += delta;
+      }
+      rtcSchedule.timeSynced = true;
+    }
+    rtcSchedule.serverCheckInterval = response->nextCheckSeconds;
+    rtcSchedule.serverCheckSpread = response->checkSpreadSeconds;
+    if (response->hasUtcOffset) {
+      rtcSchedule.utcOffset = response->utcOffsetSeconds;
+    }
+  }
+
+  int64_t t = now();
+  rtcSchedule.lastCheckTime = t;
+  rtcSchedule.checkedSinceBoot = true;
+  rtcSchedule.lastFailure = failure;
+  if (failure == CHECK_FAILURE_NONE) {
+    rtcSchedule.consecutiveFailures = 0;
+  } else {
+    if (rtcSchedule.consecutiveFailures < UINT8_MAX) rtcSchedule.consecutiveFailures++;
+    rtcSchedule.backoffUntil = t + backoffSeconds(failure, rtcSchedule.consecutiveFailures, retryAfterSeconds);
+  }
+  if (slideshowChanged) {
+    if (rtcSchedule.lastChangeTime != 0) {
+      int64_t sample = t - rtcSchedule.lastChangeTime;
+      int64_t ewma = rtcSchedule.updateIntervalEwma;
+      ewma = ewma ? ewma + (sample - ewma) / 4 : sample;
+      rtcSchedule.updateIntervalEwma = (ewma > 0) ? (uint32_t)ewma : 0;
+    }
+    rtcSchedule.lastChangeTime = t;
+  }
+  store();
+}
+
+void WakeScheduler::setImageDwell(const uint16_t* dwellMinutes, int count) {
+  if (count > MAX_IMAGES) count = MAX_IMAGES;
+  memset(rtcSchedule.dwellMinutes, 0, sizeof(rtcSchedule.dwellMinutes));
+  memcpy(rtcSchedule.dwellMinutes, dwellMinutes, count * sizeof(uint16_t));
+  rtcSchedule.imageCount = count;
+  rtcSchedule.dwellLoaded = true;
+  if (count > 0) {
+    NVSStorage::saveBytes(DWELL_NVS_KEY, rtcSchedule.dwellMinutes, count * sizeof(uint16_t));
+  }
+  store();
+}
+
+uint64_t WakeScheduler::getSleepMicros() {
+  int64_t t = now();
+  int64_t next = nextAdvanceTime();
+  int64_t checkAt = nextCheckTime();
+  if (checkAt < next) next = checkAt;
+  int64_t seconds = next - t;
+  if (seconds < MIN_SLEEP_SECONDS) seconds = MIN_SLEEP_SECONDS;
+  return (uint64_t)seconds * 1000000ULL;
+}
+
+void WakeScheduler::printDiagnostics() {
+  int64_t t = now();
+  int64_t advanceAt = nextAdvanceTime();
+  long advanceIn = (advanceAt == INT64_MAX) ? -1 : (long)(advanceAt - t);
+  Serial.printf("Next advance / check:    %6ld / %ld s%s\n", advanceIn, (long)(nextCheckTime() - t),
+                rtcSchedule.timeSynced ? "" : " (time not synced)");
+  if (rtcSchedule.consecutiveFailures > 0) {
+    Serial.printf("Check backoff:           %6u failures (%s)\n", rtcSchedule.consecutiveFailures,
+                  failureName(rtcSchedule.lastFailure));
+  }
+  Serial.printf("Sleeping for:            %6lu s\n", (unsigned long)(getSleepMicros() / 1000000ULL));
+}
+
+uint8_t WakeScheduler::getConsecutiveFailures() {
+  return rtcSchedule.consecutiveFailures;
+}
+
+const char* WakeScheduler::failureName(CheckFailure failure) {
+  switch (failure) {
+    case CHECK_FAILURE_NONE: return "ok";
+    case CHECK_FAILURE_NO_AP: return "no AP";
+    case CHECK_FAILURE_WIFI: return "WiFi";
+    case CHECK_FAILURE_CREDENTIALS: return "WiFi credentials";
+    case CHECK_FAILURE_NETWORK: return "network";
+    case CHECK_FAILURE_SERVER: return "server";
+    case CHECK_FAILURE_THROTTLED: return "throttled";
+    case CHECK_FAILURE_REJECTED: return "rejected";
+  }
+  return "?";
+}
@@ -0,0 +1,168 @@
+#include "wear_stats.h"
+#include <Arduino.h>
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include <esp_partition.h>
+#include <esp_wifi.h>
+#include "config.h"
+#include "power_profile.h"
+#include "nvs_storage.h"
+#include "flash_storage.h"
+
+#define WEAR_STATS_MAGIC 0x50505731 // "PPW1"
+#define WEAR_STATS_NVS_KEY "wear"
+
+// Totals mirrored in RTC slow memory; NVS holds the last persisted copy
+struct RTCWearRecord {
+  uint32_t magic;
+  WearTotals totals;
+  uint32_t wakesSincePersist;
+  uint32_t checksum;
+};
+
+RTC_DATA_ATTR static RTCWearRecord rtcWear;
+
+static WearTotals wake;
+static WriteCounters collectedStorage;
+static WriteCounters collectedNvs;
+static bool wakeEnded = false;
+
+static uint32_t checksum() {
+  return esp_rom_crc32_le(0, (const uint8_t*)&rtcWear, offsetof(RTCWearRecord, checksum));
+}
+
+void WearStats::store() {
+  rtcWear.magic = WEAR_STATS_MAGIC;
+  rtcWear.checksum = checksum();
+}
+
+void WearStats::begin() {
+  memset(&wake, 0, sizeof(wake));
+  if (rtcWear.magic == WEAR_STATS_MAGIC && rtcWear.checksum == checksum()) {
+    rtcWear.totals.elapsedMs += PowerManager::getSleptMs();
+    store();
+    return;
+  }
+
+  // Cold boot - continue from the last persisted totals (up to a week old)
+  memset(&rtcWear, 0, sizeof(rtcWear));
+  NVSStorage::loadBytes(WEAR_STATS_NVS_KEY, &rtcWear.totals, sizeof(rtcWear.totals));
+  store();
+}
+
+void WearStats::noteWifiConfig(const char* ssid, const char* password, uint8_t channel, const uint8_t* bssid) {
+  wifi_config_t current;
+  if (esp_wifi_get_config(WIFI_IF_STA, &current) != ESP_OK) {
+    return;
+  }
+
+  bool changed = strncmp((const char*)current.sta.ssid, ssid, sizeof(current.sta.ssid)) != 0 ||
+                 strncmp((const char*)current.sta.password, password, sizeof(current.sta.password)) != 0 ||
+                 current.sta.channel != channel ||
+                 current.sta.bssid_set != (bssid != nullptr) ||
+                 (bssid && memcmp(current.sta.bssid, bssid, sizeof(current.sta.bssid)) != 0);
+  if (changed) {
+    wake.wifiConfigWrites++;
+    wake.nvsBytes += WIFI_CONFIG_NVS_BYTES;
+    wake.nvsOps++;
+    rtcWear.totals.wifiConfigWrites++;
+    rtcWear.totals.nvsBytes += WIFI_CONFIG_NVS_BYTES;
+    rtcWear.totals.nvsOps++;
+    store();
+  }
+}
+
+// Fold counter growth since the last collect into the wake and the totals
+void WearStats::collect() {
+  const WriteCounters& storage = FlashStorage::getWriteCounters();
+  const WriteCounters& nvs = NVSStorage::getWriteCounters();
+  uint32_t storageBytes = storage.bytes - collectedStorage.bytes;
+  uint32_t storageOps = storage.operations - collectedStorage.operations;
+  uint32_t nvsBytes = nvs.bytes - collectedNvs.bytes;
+  uint32_t nvsOps = nvs.operations - collectedNvs.operations;
+  collectedStorage = storage;
+  collectedNvs = nvs;
+
+  wake.storageBytes += storageBytes;
+  wake.storageOps += storageOps;
+  wake.nvsBytes += nvsBytes;
+  wake.nvsOps += nvsOps;
+  rtcWear.totals.storageBytes += storageBytes;
+  rtcWear.totals.storageOps += storageOps;
+  rtcWear.totals.nvsBytes += nvsBytes;
+  rtcWear.totals.nvsOps += nvsOps;
+}
+
+void WearStats::endWake() {
+  if (wakeEnded) {
+    return;
+  }
+  wakeEnded = true;
+
+  collect();
+  wake.wakes = 1;
+  wake.elapsedMs = millis();
+  rtcWear.totals.wakes++;
+  rtcWear.totals.elapsedMs += wake.elapsedMs;
+  rtcWear.wakesSincePersist++;
+
+  if (rtcWear.wakesSincePersist >= WEAR_PERSIST_INTERVAL_WAKES) {
+    NVSStorage::end();
+    if (NVSStorage::saveBytes(WEAR_STATS_NVS_KEY, &rtcWear.totals, sizeof(rtcWear.totals))) {
+      rtcWear.wakesSincePersist = 0;
+    }
+    collect(); // The save above is an NVS write too
+  }
+  store();
+}
+
+const WearTotals& WearStats::getTotals() {
+  return rtcWear.totals;
+}
+
+const WearTotals& WearStats::getWake() {
+  return wake;
+}
+
+// Wear levelling spreads writes over the whole partition, so it can absorb
+// partition size x rated cycles bytes before the average sector wears out
+static float lifetimeYears(uint64_t bytes, uint64_t elapsedMs, const esp_partition_t* partition) {
+  if (bytes == 0 || elapsedMs == 0 || partition == nullptr) {
+    return -1.0f;
+  }
+  double bytesPerDay = (double)bytes / (elapsedMs / 86400000.0);
+  double budget = (double)partition->size * FLASH_ERASE_CYCLES;
+  return (float)(budget / bytesPerDay / 365.0);
+}
+
+float WearStats::getStorageLifetimeYears() {
+  const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                              ESP_PARTITION_SUBTYPE_ANY,
+                                                              STORAGE_PARTITION_LABEL);
+  return lifetimeYears(rtcWear.totals.storageBytes, rtcWear.totals.elapsedMs, partition);
+}
+
+float WearStats::getNvsLifetimeYears() {
+  const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                              ESP_PARTITION_SUBTYPE_DATA_NVS,
+                                                              nullptr);
+  return lifetimeYears(rtcWear.totals.nvsBytes, rtcWear.totals.elapsedMs, partition);
+}
+
+void WearStats::printDiagnostics() {
+  Serial.printf("Flash writes (wake):     %6lu B storage, %lu B NVS, %lu WiFi config\n",
+                (unsigned long)wake.storageBytes, (unsigned long)wake.nvsBytes,
+                (unsigned long)wake.wifiConfigWrites);
+  Serial.printf("Flash writes (total):    %6llu B storage, %llu B NVS over %lu wakes, %.1f days\n",
+                (unsigned long long)rtcWear.totals.storageBytes,
+                (unsigned long long)rtcWear.totals.nvsBytes,
+                (unsigned long)rtcWear.totals.wakes, rtcWear.totals.elapsedMs / 86400000.0);
+
+  float storageYears = getStorageLifetimeYears();
+  float nvsYears = getNvsLifetimeYears();
+  char storageText[16] = "-";
+  char nvsText[16] = "-";
+  if (storageYears >= 0) snprintf(storageText, sizeof(storageText), "%.0f y", storageYears);
+  if (nvsYears >= 0) snprintf(nvsText, sizeof(nvsText), "%.0f y", nvsYears);
+  Serial.printf("Projected flash life:    %s storage, %s NVS\n", storageText, nvsText);
+}
@@ -0,0 +1,162 @@
+#include "wifi_connector.h"
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <esp_attr.h>
+#include "config.h"
+#include "trace.h"
+
+#define LINK_UP_BIT      BIT0
+#define GOT_IP_BIT       BIT1
+#define DISCONNECTED_BIT BIT2
+
+static EventGroupHandle_t wifiEvents = nullptr;
+static volatile uint32_t beginMicros = 0;
+static volatile uint32_t linkUpMicros = 0;
+static volatile uint32_t gotIpMicros = 0;
+static volatile uint8_t disconnectReason = 0;
+static WiFiAttempt lastAttempt;
+
+// Connect history per kind of attempt (index 0 = known channel/BSSID,
+// 1 = full scan), kept in RTC memory and zeroed on cold boot
+RTC_DATA_ATTR static uint32_t connectEwmaMs[2];
+RTC_DATA_ATTR static uint8_t consecutiveFailures[2];
+static uint8_t attemptKind = 1;
+
+// Runs in the Arduino event task
+static void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  switch (event) {
+    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+      linkUpMicros = micros();
+      xEventGroupSetBits(wifiEvents, LINK_UP_BIT);
+      break;
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      gotIpMicros = micros();
+      xEventGroupSetBits(wifiEvents, GOT_IP_BIT);
+      break;
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      disconnectReason = info.wifi_sta_disconnected.reason;
+      xEventGroupSetBits(wifiEvents, DISCONNECTED_BIT);
+      break;
+    default:
+      break;
+  }
+}
+
+void WiFiConnector::init() {
+  if (wifiEvents) return;
+  wifiEvents = xEventGroupCreate();
+  WiFi.onEvent(onWiFiEvent);
+}
+
+void WiFiConnector::begin(const char* ssid, const char* password, uint8_t channel, const uint8_t* bssid) {
+  init();
+  xEventGroupClearBits(wifiEvents, LINK_UP_BIT | GOT_IP_BIT | DISCONNECTED_BIT);
+  disconnectReason = 0;
+  beginMicros = micros();
+  attemptKind = (channel > 0) ? 0 : 1;
+
+  if (channel > 0) {
+    WiFi.begin(ssid, password, channel, bssid);
+  } else {
+    WiFi.begin(ssid, password);
+  }
+}
+
+WiFiFailure WiFiConnector::classify(uint8_t reason) {
+  switch (reason) {
+    case WIFI_REASON_NO_AP_FOUND:
+    case WIFI_REASON_BEACON_TIMEOUT:
+      return WIFI_FAILURE_NO_AP;
+    case WIFI_REASON_AUTH_FAIL:
+    case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+    case WIFI_REASON_HANDSHAKE_TIMEOUT:
+    case WIFI_REASON_MIC_FAILURE:
+      return WIFI_FAILURE_AUTH;
+    case WIFI_REASON_AUTH_EXPIRE:
+    case WIFI_REASON_ASSOC_EXPIRE:
+    case WIFI_REASON_ASSOC_TOOMANY:
+    case WIFI_REASON_ASSOC_FAIL:
+    case WIFI_REASON_NOT_AUTHED:
+    case WIFI_REASON_NOT_ASSOCED:
+      return WIFI_FAILURE_ASSOC;
+    default:
+      return WIFI_FAILURE_LINK_LOST;
+  }
+}
+
+WiFiAttempt WiFiConnector::wait(uint32_t timeoutMs) {
+  TRACE_SCOPE("wifi.wait");
+  init();
+  EventBits_t bits = xEventGroupWaitBits(wifiEvents, GOT_IP_BIT | DISCONNECTED_BIT,
+                                         pdFALSE, pdFALSE, pdMS_TO_TICKS(timeoutMs));
+
+  WiFiAttempt attempt = {};
+  attempt.reason = disconnectReason;
+  if (bits & LINK_UP_BIT) {
+    attempt.linkMs = (linkUpMicros - beginMicros) / 1000;
+  }
+
+  if (bits & GOT_IP_BIT) {
+    attempt.connected = true;
+    attempt.failure = WIFI_FAILURE_NONE;
+    attempt.dhcpMs = (gotIpMicros - linkUpMicros) / 1000;
+    attempt.totalMs = (gotIpMicros - beginMicros) / 1000;
+  } else {
+    attempt.connected = false;
+    if (bits & DISCONNECTED_BIT) {
+      attempt.failure = classify(disconnectReason);
+    } else if (bits & LINK_UP_BIT) {
+      attempt.failure = WIFI_FAILURE_DHCP;
+    } else {
+      attempt.failure = WIFI_FAILURE_TIMEOUT;
+    }
+    attempt.totalMs = (micros() - beginMicros) / 1000;
+  }
+
+  // Successes feed the typical connect time, failures shorten the next timeout
+  if (attempt.connected) {
+    uint32_t ewma = connectEwmaMs[attemptKind];
+    connectEwmaMs[attemptKind] = ewma ? ewma - ewma / 4 + attempt.totalMs / 4 : attempt.totalMs;
+    consecutiveFailures[attemptKind] = 0;
+  } else if (consecutiveFailures[attemptKind] < UINT8_MAX) {
+    consecutiveFailures[attemptKind]++;
+  }
+
+  lastAttempt = attempt;
+  return attempt;
+}
+
+uint32_t WiFiConnector::timeoutMs() {
+  bool directed = (attemptKind == 0);
+  uint32_t minMs = directed ? WIFI_DIRECTED_TIMEOUT_MIN_MS : WIFI_SCAN_TIMEOUT_MIN_MS;
+  uint32_t maxMs = directed ? WIFI_DIRECTED_TIMEOUT_MAX_MS : WIFI_SCAN_TIMEOUT_MAX_MS;
+
+  // A few times the usual connect time, halved for every failure in a row -
+  // in a dead zone each attempt gives up sooner
+  uint32_t timeout = connectEwmaMs[attemptKind] ? connectEwmaMs[attemptKind] * 3 : maxMs;
+  uint8_t failures = consecutiveFailures[attemptKind];
+  timeout >>= (failures < 4) ? failures : 4;
+
+  if (timeout < minMs) timeout = minMs;
+  if (timeout > maxMs) timeout = maxMs;
+  return timeout;
+}
+
+const WiFiAttempt& WiFiConnector::getLastAttempt() {
+  return lastAttempt;
+}
+
+const char* WiFiConnector::failureName(WiFiFailure failure) {
+  switch (failure) {
+    case WIFI_FAILURE_NONE: return "ok";
+    case WIFI_FAILURE_NO_AP: return "no AP";
+    case WIFI_FAILURE_AUTH: return "auth";
+    case WIFI_FAILURE_ASSOC: return "assoc";
+    case WIFI_FAILURE_LINK_LOST: return "link lost";
+    case WIFI_FAILURE_DHCP: return "DHCP";
+    case WIFI_FAILURE_TIMEOUT: return "timeout";
+  }
+  return "?";
+}
@@ -0,0 +1,32 @@
+#include "convert.h"
+#include "encode.h"
+
+void convertPicture(const Image& picture, const ConvertOptions& options, Converted& out) {
+  Palette palette = makePalette(options.palette);
+  out.width = DISPLAY_WIDTH / options.scale;
+  out.height = DISPLAY_HEIGHT / options.scale;
+
+  Image fitted;
+  if (options.autoRotate && picture.width > picture.height) {
+    fitted = resizeTo(rotateClockwise(picture), out.width, out.height, options.fit);
+  } else {
+    fitted = resizeTo(picture, out.width, out.height, options.fit);
+  }
+  mapToPanel(fitted, palette);
+  dither(fitted, palette, options.dither, *options.kernels, out.indices);
+
+  if (options.container) {
+    out.file = makeContainer(out.indices, out.width, out.height, palette, options.codec, options.scale,
+                             options.filter);
+  } else {
+    out.file = packRows(out.indices, out.width, out.height, palette.codes);
+  }
+}
+
+std::vector<uint8_t> previewPixels(const Converted& converted, const Palette& palette) {
+  std::vector<uint8_t> rgb(converted.indices.size() * 3);
+  for (size_t i = 0; i < converted.indices.size(); i++) {
+    for (int c = 0; c < 3; c++) rgb[i * 3 + c] = palette.srgb[converted.indices[i]][c];
+  }
+  return rgb;
+}
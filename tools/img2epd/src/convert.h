@@ -0,0 +1,38 @@
+/*****************************************************************************
+ * | File      	:   convert.h
+ * | Function    :   One picture to one stored image
+ ******************************************************************************/
+#ifndef _IMG2EPD_CONVERT_H_
+#define _IMG2EPD_CONVERT_H_
+
+#include <stdint.h>
+#include <vector>
+#include "dither.h"
+#include "image_container.h"
+#include "resize.h"
+
+struct ConvertOptions {
+  FitMode fit = FIT_COVER;
+  bool autoRotate = true;  // Landscape pictures turned a quarter clockwise onto the portrait panel
+  DitherMode dither = DITHER_DIFFUSION;
+  PaletteKind palette = PALETTE_MEASURED;
+  int scale = 1;           // Stored at 1/scale of the panel, enlarged by the device
+  ImageFilter filter = IMAGE_FILTER_NEAREST;
+  bool container = false;  // Otherwise headerless rows, as the device first stored them
+  ImageCodec codec = IMAGE_CODEC_RAW;
+  const DitherKernels* kernels = nullptr;
+};
+
+struct Converted {
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> indices;  // Palette index per pixel
+  std::vector<uint8_t> file;     // What to upload
+};
+
+void convertPicture(const Image& picture, const ConvertOptions& options, Converted& out);
+
+// sRGB of the chosen panel colors, 3 bytes per pixel
+std::vector<uint8_t> previewPixels(const Converted& converted, const Palette& palette);
+
+#endif
@@ -0,0 +1,200 @@
+#include "dither.h"
+#include <math.h>
+#include <algorithm>
+#include "dither_kernels.h"
+
+#define BLUE_NOISE_SIZE 64     // Mask side, tiled across the picture
+#define BLUE_NOISE_SIGMA 1.9f  // Of the Gaussian that measures clustering
+#define BLUE_NOISE_SPREAD 0.5f // Threshold range in linear light
+
+namespace {
+
+// Lowest-index palette entry nearest to (r, g, b). The SIMD kernels compute
+// the same distances with the same operations, so ties break the same way.
+inline int nearestColor(float r, float g, float b, const Palette& palette) {
+  int best = 0;
+  float bestDistance = INFINITY;
+  for (int k = 0; k < palette.count; k++) {
+    float dr = palette.r[k] - r;
+    float dg = palette.g[k] - g;
+    float db = palette.b[k] - b;
+    float distance = ((palette.weights[0] * dr) * dr + (palette.weights[1] * dg) * dg) +
+                     (palette.weights[2] * db) * db;
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = k;
+    }
+  }
+  return best;
+}
+
+void diffuseRowScalar(const float* pixels, float* error, float* next, int width, bool reverse,
+                      const Palette& palette, uint8_t* out) {
+  int step = reverse ? -1 : 1;
+  for (int i = 0; i < width; i++) {
+    int x = reverse ? width - 1 - i : i;
+    float* here = error + (size_t)(x + 1) * 4;
+    float* ahead = here + step * 4;
+    float* below = next + (size_t)(x + 1) * 4;
+    float* belowAhead = below + step * 4;
+    float* belowBehind = below - step * 4;
+
+    float c[4];
+    for (int ch = 0; ch < 4; ch++) {
+      c[ch] = std::min(std::max(pixels[x * 4 + ch] + here[ch], 0.0f), 1.0f);
+    }
+    int k = nearestColor(c[0], c[1], c[2], palette);
+    out[x] = k;
+    for (int ch = 0; ch < 4; ch++) {
+      float d = c[ch] - palette.rgba[k][ch];
+      ahead[ch] = ahead[ch] + d * DIFFUSE_RIGHT;
+      belowBehind[ch] = belowBehind[ch] + d * DIFFUSE_BELOW_BEHIND;
+      below[ch] = below[ch] + d * DIFFUSE_BELOW;
+      belowAhead[ch] = belowAhead[ch] + d * DIFFUSE_BELOW_AHEAD;
+    }
+  }
+}
+
+void thresholdRowScalar(const float* pixels, const float* thresholds, int width, const Palette& palette,
+                        uint8_t* out) {
+  for (int x = 0; x < width; x++) {
+    const float* p = pixels + (size_t)x * 4;
+    out[x] = nearestColor(p[0] + thresholds[x], p[1] + thresholds[x], p[2] + thresholds[x], palette);
+  }
+}
+
+// Void-and-cluster (Ulichney): rank every cell of a toroidal mask so that
+// each prefix of the ranking is as evenly spread as possible. Thresholds
+// from it have no low-frequency structure, unlike a Bayer matrix.
+std::vector<float> makeBlueNoise() {
+  const int n = BLUE_NOISE_SIZE, area = n * n;
+  std::vector<float> gaussian(area);
+  for (int dy = 0; dy < n; dy++) {
+    for (int dx = 0; dx < n; dx++) {
+      int wx = std::min(dx, n - dx), wy = std::min(dy, n - dy);
+      gaussian[dy * n + dx] = expf(-(wx * wx + wy * wy) / (2.0f * BLUE_NOISE_SIGMA * BLUE_NOISE_SIGMA));
+    }
+  }
+
+  std::vector<uint8_t> pattern(area, 0);
+  std::vector<float> energy(area, 0.0f);
+  auto toggle = [&](std::vector<uint8_t>& bits, std::vector<float>& field, int cell) {
+    float sign = bits[cell] ? -1.0f : 1.0f;
+    bits[cell] ^= 1;
+    int cx = cell % n, cy = cell / n;
+    for (int y = 0; y < n; y++) {
+      const float* g = &gaussian[((y - cy + n) % n) * n];
+      float* e = &field[y * n];
+      for (int x = 0; x < n; x++) e[x] += sign * g[(x - cx + n) % n];
+    }
+  };
+  // Tightest cluster among set cells, or largest void among clear ones
+  auto extreme = [&](const std::vector<uint8_t>& bits, const std::vector<float>& field, bool cluster) {
+    int best = -1;
+    for (int i = 0; i < area; i++) {
+      if (bits[i] != (cluster ? 1 : 0)) continue;
+      if (best < 0 || (cluster ? field[i] > field[best] : field[i] < field[best])) best = i;
+    }
+    return best;
+  };
+
+  // Initial pattern: a tenth of the cells, placed by a fixed pseudo-random
+  // sequence so every run builds the same mask
+  int initial = area / 10;
+  uint32_t seed = 0x2545F491;
+  for (int placed = 0; placed < initial;) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    int cell = seed % area;
+    if (!pattern[cell]) {
+      toggle(pattern, energy, cell);
+      placed++;
+    }
+  }
+  // Move the tightest cluster into the largest void until that changes nothing
+  for (int moves = 0; moves < area; moves++) {
+    int cluster = extreme(pattern, energy, true);
+    toggle(pattern, energy, cluster);
+    int gap = extreme(pattern, energy, false);
+    toggle(pattern, energy, gap);
+    if (gap == cluster) break;
+  }
+
+  std::vector<int> rank(area);
+  // Ranks below the initial pattern: take clusters away from a copy
+  std::vector<uint8_t> fewer = pattern;
+  std::vector<float> fewerEnergy = energy;
+  for (int r = initial - 1; r >= 0; r--) {
+    int cluster = extreme(fewer, fewerEnergy, true);
+    toggle(fewer, fewerEnergy, cluster);
+    rank[cluster] = r;
+  }
+  // Ranks above it: fill the largest void
+  for (int r = initial; r < area; r++) {
+    int gap = extreme(pattern, energy, false);
+    toggle(pattern, energy, gap);
+    rank[gap] = r;
+  }
+
+  std::vector<float> mask(area);
+  for (int i = 0; i < area; i++) mask[i] = ((rank[i] + 0.5f) / area - 0.5f) * BLUE_NOISE_SPREAD;
+  return mask;
+}
+
+const std::vector<float>& blueNoise() {
+  static const std::vector<float> mask = makeBlueNoise();
+  return mask;
+}
+
+}  // namespace
+
+const DitherKernels scalarKernels = {"scalar", diffuseRowScalar, thresholdRowScalar};
+
+std::vector<const DitherKernels*> availableKernels() {
+  std::vector<const DitherKernels*> kernels;
+#ifdef IMG2EPD_AVX2
+  if (__builtin_cpu_supports("avx2")) kernels.push_back(&avx2Kernels);
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+  if (__builtin_cpu_supports("sse2")) kernels.push_back(&sse2Kernels);
+#endif
+#ifdef __aarch64__
+  kernels.push_back(&neonKernels);
+#endif
+  kernels.push_back(&scalarKernels);
+  return kernels;
+}
+
+const DitherKernels* findKernels(const std::string& name) {
+  for (const DitherKernels* kernels : availableKernels()) {
+    if (name == kernels->name) return kernels;
+  }
+  return nullptr;
+}
+
+void dither(const Image& image, const Palette& palette, DitherMode mode, const DitherKernels& kernels,
+            std::vector<uint8_t>& indices) {
+  indices.resize((size_t)image.width * image.height);
+  if (mode == DITHER_DIFFUSION) {
+    std::vector<float> error((size_t)(image.width + 2) * 4, 0.0f);
+    std::vector<float> next(error.size(), 0.0f);
+    for (int y = 0; y < image.height; y++) {
+      // Serpentine: odd rows right to left, so the error does not drift one way
+      kernels.diffuseRow(image.row(y), error.data(), next.data(), image.width, y & 1, palette,
+                         &indices[(size_t)y * image.width]);
+      error.swap(next);
+      std::fill(next.begin(), next.end(), 0.0f);
+    }
+    return;
+  }
+
+  std::vector<float> thresholds(image.width, 0.0f);
+  for (int y = 0; y < image.height; y++) {
+    if (mode == DITHER_BLUE_NOISE) {
+      const float* mask = &blueNoise()[(y % BLUE_NOISE_SIZE) * BLUE_NOISE_SIZE];
+      for (int x = 0; x < image.width; x++) thresholds[x] = mask[x % BLUE_NOISE_SIZE];
+    }
+    kernels.thresholdRow(image.row(y), thresholds.data(), image.width, palette, &indices[(size_t)y * image.width]);
+  }
+}
@@ -0,0 +1,47 @@
+/*****************************************************************************
+ * | File      	:   dither.h
+ * | Function    :   Dithering to the panel palette, scalar and SIMD kernels
+ ******************************************************************************/
+#ifndef _IMG2EPD_DITHER_H_
+#define _IMG2EPD_DITHER_H_
+
+#include <string>
+#include <vector>
+#include "image.h"
+#include "palette.h"
+
+enum DitherMode {
+  DITHER_DIFFUSION,   // Floyd-Steinberg, serpentine, in linear light
+  DITHER_BLUE_NOISE,  // 64x64 void-and-cluster threshold mask, no error carried
+  DITHER_NONE         // Nearest color
+};
+
+// One implementation of the per-row work. Every implementation does the
+// same float operations in the same order (built with -ffp-contract=off),
+// so they all give the same picture; --bench checks this.
+struct DitherKernels {
+  const char* name;
+
+  // Floyd-Steinberg over one row of width pixels. error holds what earlier
+  // pixels and the row above pushed onto this row, next collects what goes
+  // to the row below; both are width + 2 pixels (a spare at each end).
+  // Walks right to left when reverse.
+  void (*diffuseRow)(const float* pixels, float* error, float* next, int width, bool reverse,
+                     const Palette& palette, uint8_t* out);
+
+  // Nearest color of each pixel with thresholds[x] added to R, G and B
+  void (*thresholdRow)(const float* pixels, const float* thresholds, int width, const Palette& palette,
+                       uint8_t* out);
+};
+
+// Kernels this build and CPU can run, fastest first; "scalar" is always last
+std::vector<const DitherKernels*> availableKernels();
+
+// By name, nullptr when this build or CPU cannot run it
+const DitherKernels* findKernels(const std::string& name);
+
+// Palette index of every pixel, row by row
+void dither(const Image& image, const Palette& palette, DitherMode mode, const DitherKernels& kernels,
+            std::vector<uint8_t>& indices);
+
+#endif
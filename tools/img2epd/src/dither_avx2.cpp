@@ -0,0 +1,95 @@
+// Built with -mavx2 (not -mfma: a fused multiply-add rounds differently
+// from the other kernels); only called after the CPU reports AVX2
+#include "dither_kernels.h"
+#include <math.h>
+
+#ifdef IMG2EPD_AVX2
+#include <immintrin.h>
+
+namespace {
+
+void diffuseRowAvx2(const float* pixels, float* error, float* next, int width, bool reverse, const Palette& palette,
+                    uint8_t* out) {
+  const __m256 wr = _mm256_set1_ps(palette.weights[0]);
+  const __m256 wg = _mm256_set1_ps(palette.weights[1]);
+  const __m256 wb = _mm256_set1_ps(palette.weights[2]);
+  const __m256 pr = _mm256_load_ps(palette.r), pg = _mm256_load_ps(palette.g), pb = _mm256_load_ps(palette.b);
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+  const __m128 right = _mm_set1_ps(DIFFUSE_RIGHT), belowBehind = _mm_set1_ps(DIFFUSE_BELOW_BEHIND);
+  const __m128 below = _mm_set1_ps(DIFFUSE_BELOW), belowAhead = _mm_set1_ps(DIFFUSE_BELOW_AHEAD);
+  int step = reverse ? -4 : 4;
+
+  for (int i = 0; i < width; i++) {
+    int x = reverse ? width - 1 - i : i;
+    float* here = error + (size_t)(x + 1) * 4;
+    float* under = next + (size_t)(x + 1) * 4;
+    __m128 c = _mm_add_ps(_mm_loadu_ps(pixels + (size_t)x * 4), _mm_loadu_ps(here));
+    c = _mm_min_ps(_mm_max_ps(c, zero), one);
+
+    // All eight palette lanes in one register
+    __m256 dr = _mm256_sub_ps(pr, _mm256_broadcastss_ps(c));
+    __m256 dg = _mm256_sub_ps(pg, _mm256_broadcastss_ps(_mm_shuffle_ps(c, c, 0x55)));
+    __m256 db = _mm256_sub_ps(pb, _mm256_broadcastss_ps(_mm_shuffle_ps(c, c, 0xAA)));
+    __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(wr, dr), dr),
+                                           _mm256_mul_ps(_mm256_mul_ps(wg, dg), dg)),
+                             _mm256_mul_ps(_mm256_mul_ps(wb, db), db));
+    __m256 m = _mm256_min_ps(d, _mm256_permute2f128_ps(d, d, 0x01));
+    m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    int k = __builtin_ctz(_mm256_movemask_ps(_mm256_cmp_ps(d, m, _CMP_EQ_OQ)));
+    out[x] = k;
+
+    __m128 e = _mm_sub_ps(c, _mm_load_ps(palette.rgba[k]));
+    _mm_storeu_ps(here + step, _mm_add_ps(_mm_loadu_ps(here + step), _mm_mul_ps(e, right)));
+    _mm_storeu_ps(under - step, _mm_add_ps(_mm_loadu_ps(under - step), _mm_mul_ps(e, belowBehind)));
+    _mm_storeu_ps(under, _mm_add_ps(_mm_loadu_ps(under), _mm_mul_ps(e, below)));
+    _mm_storeu_ps(under + step, _mm_add_ps(_mm_loadu_ps(under + step), _mm_mul_ps(e, belowAhead)));
+  }
+}
+
+// Eight pixels at a time: pixels x and x + 4 share a register, so the
+// in-lane 4x4 transpose yields R, G and B of all eight
+void thresholdRowAvx2(const float* pixels, const float* thresholds, int width, const Palette& palette,
+                      uint8_t* out) {
+  const __m256 wr = _mm256_set1_ps(palette.weights[0]);
+  const __m256 wg = _mm256_set1_ps(palette.weights[1]);
+  const __m256 wb = _mm256_set1_ps(palette.weights[2]);
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    const float* p = pixels + (size_t)x * 4;
+    __m256 a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 16), 1);
+    __m256 a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 20), 1);
+    __m256 a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 24), 1);
+    __m256 a3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 12)), _mm_loadu_ps(p + 28), 1);
+    __m256 rg01 = _mm256_unpacklo_ps(a0, a1), b01 = _mm256_unpackhi_ps(a0, a1);
+    __m256 rg23 = _mm256_unpacklo_ps(a2, a3), b23 = _mm256_unpackhi_ps(a2, a3);
+    __m256 t = _mm256_loadu_ps(thresholds + x);
+    __m256 r = _mm256_add_ps(_mm256_shuffle_ps(rg01, rg23, _MM_SHUFFLE(1, 0, 1, 0)), t);
+    __m256 g = _mm256_add_ps(_mm256_shuffle_ps(rg01, rg23, _MM_SHUFFLE(3, 2, 3, 2)), t);
+    __m256 b = _mm256_add_ps(_mm256_shuffle_ps(b01, b23, _MM_SHUFFLE(1, 0, 1, 0)), t);
+
+    __m256 best = _mm256_set1_ps(INFINITY);
+    __m256i index = _mm256_setzero_si256();
+    for (int k = 0; k < palette.count; k++) {
+      __m256 dr = _mm256_sub_ps(_mm256_set1_ps(palette.r[k]), r);
+      __m256 dg = _mm256_sub_ps(_mm256_set1_ps(palette.g[k]), g);
+      __m256 db = _mm256_sub_ps(_mm256_set1_ps(palette.b[k]), b);
+      __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(wr, dr), dr),
+                                             _mm256_mul_ps(_mm256_mul_ps(wg, dg), dg)),
+                               _mm256_mul_ps(_mm256_mul_ps(wb, db), db));
+      __m256 closer = _mm256_cmp_ps(d, best, _CMP_LT_OQ);
+      best = _mm256_min_ps(d, best);
+      index = _mm256_blendv_epi8(index, _mm256_set1_epi32(k), _mm256_castps_si256(closer));
+    }
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256((__m256i*)lanes, index);
+    for (int i = 0; i < 8; i++) out[x + i] = lanes[i];
+  }
+  if (x < width) scalarKernels.thresholdRow(pixels + (size_t)x * 4, thresholds + x, width - x, palette, out + x);
+}
+
+}  // namespace
+
+const DitherKernels avx2Kernels = {"avx2", diffuseRowAvx2, thresholdRowAvx2};
+
+#endif
@@ -0,0 +1,27 @@
+/*****************************************************************************
+ * | File      	:   dither_kernels.h
+ * | Function    :   Kernel tables of each instruction set
+ ******************************************************************************/
+#ifndef _IMG2EPD_DITHER_KERNELS_H_
+#define _IMG2EPD_DITHER_KERNELS_H_
+
+#include "dither.h"
+
+// Floyd-Steinberg shares of the error: right, below left, below, below right
+#define DIFFUSE_RIGHT 0.4375f
+#define DIFFUSE_BELOW_BEHIND 0.1875f
+#define DIFFUSE_BELOW 0.3125f
+#define DIFFUSE_BELOW_AHEAD 0.0625f
+
+extern const DitherKernels scalarKernels;
+#if defined(__x86_64__) || defined(__i386__)
+extern const DitherKernels sse2Kernels;
+#endif
+#ifdef IMG2EPD_AVX2
+extern const DitherKernels avx2Kernels;
+#endif
+#ifdef __aarch64__
+extern const DitherKernels neonKernels;
+#endif
+
+#endif
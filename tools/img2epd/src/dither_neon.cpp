@@ -0,0 +1,83 @@
+#include "dither_kernels.h"
+#include <math.h>
+
+#ifdef __aarch64__
+#include <arm_neon.h>
+
+namespace {
+
+// vmulq/vaddq rather than vmlaq/vfmaq, so the rounding matches the scalar kernel
+inline float32x4_t weighted(float32x4_t w, float32x4_t d) { return vmulq_f32(vmulq_f32(w, d), d); }
+
+void diffuseRowNeon(const float* pixels, float* error, float* next, int width, bool reverse, const Palette& palette,
+                    uint8_t* out) {
+  const float32x4_t wr = vdupq_n_f32(palette.weights[0]);
+  const float32x4_t wg = vdupq_n_f32(palette.weights[1]);
+  const float32x4_t wb = vdupq_n_f32(palette.weights[2]);
+  const float32x4_t zero = vdupq_n_f32(0.0f), one = vdupq_n_f32(1.0f);
+  int step = reverse ? -4 : 4;
+
+  for (int i = 0; i < width; i++) {
+    int x = reverse ? width - 1 - i : i;
+    float* here = error + (size_t)(x + 1) * 4;
+    float* under = next + (size_t)(x + 1) * 4;
+    float32x4_t c = vaddq_f32(vld1q_f32(pixels + (size_t)x * 4), vld1q_f32(here));
+    c = vminq_f32(vmaxq_f32(c, zero), one);
+    float32x4_t r = vdupq_laneq_f32(c, 0), g = vdupq_laneq_f32(c, 1), b = vdupq_laneq_f32(c, 2);
+
+    float32x4_t low = vaddq_f32(vaddq_f32(weighted(wr, vsubq_f32(vld1q_f32(palette.r), r)),
+                                          weighted(wg, vsubq_f32(vld1q_f32(palette.g), g))),
+                                weighted(wb, vsubq_f32(vld1q_f32(palette.b), b)));
+    float32x4_t high = vaddq_f32(vaddq_f32(weighted(wr, vsubq_f32(vld1q_f32(palette.r + 4), r)),
+                                           weighted(wg, vsubq_f32(vld1q_f32(palette.g + 4), g))),
+                                 weighted(wb, vsubq_f32(vld1q_f32(palette.b + 4), b)));
+    float32x4_t m = vdupq_n_f32(vminvq_f32(vminq_f32(low, high)));
+    uint32_t hits[8];
+    vst1q_u32(hits, vceqq_f32(low, m));
+    vst1q_u32(hits + 4, vceqq_f32(high, m));
+    int k = 0;
+    while (!hits[k]) k++;
+    out[x] = k;
+
+    float32x4_t e = vsubq_f32(c, vld1q_f32(palette.rgba[k]));
+    vst1q_f32(here + step, vaddq_f32(vld1q_f32(here + step), vmulq_n_f32(e, DIFFUSE_RIGHT)));
+    vst1q_f32(under - step, vaddq_f32(vld1q_f32(under - step), vmulq_n_f32(e, DIFFUSE_BELOW_BEHIND)));
+    vst1q_f32(under, vaddq_f32(vld1q_f32(under), vmulq_n_f32(e, DIFFUSE_BELOW)));
+    vst1q_f32(under + step, vaddq_f32(vld1q_f32(under + step), vmulq_n_f32(e, DIFFUSE_BELOW_AHEAD)));
+  }
+}
+
+// Four pixels at a time; vld4q de-interleaves them into R, G, B and padding
+void thresholdRowNeon(const float* pixels, const float* thresholds, int width, const Palette& palette,
+                      uint8_t* out) {
+  const float32x4_t wr = vdupq_n_f32(palette.weights[0]);
+  const float32x4_t wg = vdupq_n_f32(palette.weights[1]);
+  const float32x4_t wb = vdupq_n_f32(palette.weights[2]);
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    float32x4x4_t p = vld4q_f32(pixels + (size_t)x * 4);
+    float32x4_t t = vld1q_f32(thresholds + x);
+    float32x4_t r = vaddq_f32(p.val[0], t), g = vaddq_f32(p.val[1], t), b = vaddq_f32(p.val[2], t);
+
+    float32x4_t best = vdupq_n_f32(INFINITY);
+    uint32x4_t index = vdupq_n_u32(0);
+    for (int k = 0; k < palette.count; k++) {
+      float32x4_t d = vaddq_f32(vaddq_f32(weighted(wr, vsubq_f32(vdupq_n_f32(palette.r[k]), r)),
+                                          weighted(wg, vsubq_f32(vdupq_n_f32(palette.g[k]), g))),
+                                weighted(wb, vsubq_f32(vdupq_n_f32(palette.b[k]), b)));
+      uint32x4_t closer = vcltq_f32(d, best);
+      best = vbslq_f32(closer, d, best);
+      index = vbslq_u32(closer, vdupq_n_u32(k), index);
+    }
+    uint32_t lanes[4];
+    vst1q_u32(lanes, index);
+    for (int i = 0; i < 4; i++) out[x + i] = lanes[i];
+  }
+  if (x < width) scalarKernels.thresholdRow(pixels + (size_t)x * 4, thresholds + x, width - x, palette, out + x);
+}
+
+}  // namespace
+
+const DitherKernels neonKernels = {"neon", diffuseRowNeon, thresholdRowNeon};
+
+#endif
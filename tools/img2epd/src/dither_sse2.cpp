@@ -0,0 +1,103 @@
+#include "dither_kernels.h"
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+
+namespace {
+
+// Weighted distances from one color to palette entries 0-3 and 4-7
+struct Distances {
+  __m128 low, high;
+};
+
+inline Distances distances(__m128 r, __m128 g, __m128 b, const Palette& palette, const __m128 weights[3]) {
+  Distances d;
+  __m128 dr = _mm_sub_ps(_mm_load_ps(palette.r), r);
+  __m128 dg = _mm_sub_ps(_mm_load_ps(palette.g), g);
+  __m128 db = _mm_sub_ps(_mm_load_ps(palette.b), b);
+  d.low = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(weights[0], dr), dr), _mm_mul_ps(_mm_mul_ps(weights[1], dg), dg)),
+                     _mm_mul_ps(_mm_mul_ps(weights[2], db), db));
+  dr = _mm_sub_ps(_mm_load_ps(palette.r + 4), r);
+  dg = _mm_sub_ps(_mm_load_ps(palette.g + 4), g);
+  db = _mm_sub_ps(_mm_load_ps(palette.b + 4), b);
+  d.high = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(weights[0], dr), dr), _mm_mul_ps(_mm_mul_ps(weights[1], dg), dg)),
+                      _mm_mul_ps(_mm_mul_ps(weights[2], db), db));
+  return d;
+}
+
+void diffuseRowSse2(const float* pixels, float* error, float* next, int width, bool reverse, const Palette& palette,
+                    uint8_t* out) {
+  const __m128 weights[3] = {_mm_set1_ps(palette.weights[0]), _mm_set1_ps(palette.weights[1]),
+                             _mm_set1_ps(palette.weights[2])};
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+  const __m128 right = _mm_set1_ps(DIFFUSE_RIGHT), belowBehind = _mm_set1_ps(DIFFUSE_BELOW_BEHIND);
+  const __m128 below = _mm_set1_ps(DIFFUSE_BELOW), belowAhead = _mm_set1_ps(DIFFUSE_BELOW_AHEAD);
+  int step = reverse ? -4 : 4;
+
+  for (int i = 0; i < width; i++) {
+    int x = reverse ? width - 1 - i : i;
+    float* here = error + (size_t)(x + 1) * 4;
+    float* under = next + (size_t)(x + 1) * 4;
+    __m128 c = _mm_add_ps(_mm_loadu_ps(pixels + (size_t)x * 4), _mm_loadu_ps(here));
+    c = _mm_min_ps(_mm_max_ps(c, zero), one);
+
+    Distances d = distances(_mm_shuffle_ps(c, c, 0x00), _mm_shuffle_ps(c, c, 0x55), _mm_shuffle_ps(c, c, 0xAA),
+                            palette, weights);
+    // Smallest distance in every lane, then the first entry that has it
+    __m128 m = _mm_min_ps(d.low, d.high);
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    int hits = _mm_movemask_ps(_mm_cmpeq_ps(d.low, m)) | (_mm_movemask_ps(_mm_cmpeq_ps(d.high, m)) << 4);
+    int k = __builtin_ctz(hits);
+    out[x] = k;
+
+    __m128 e = _mm_sub_ps(c, _mm_load_ps(palette.rgba[k]));
+    _mm_storeu_ps(here + step, _mm_add_ps(_mm_loadu_ps(here + step), _mm_mul_ps(e, right)));
+    _mm_storeu_ps(under - step, _mm_add_ps(_mm_loadu_ps(under - step), _mm_mul_ps(e, belowBehind)));
+    _mm_storeu_ps(under, _mm_add_ps(_mm_loadu_ps(under), _mm_mul_ps(e, below)));
+    _mm_storeu_ps(under + step, _mm_add_ps(_mm_loadu_ps(under + step), _mm_mul_ps(e, belowAhead)));
+  }
+}
+
+// Four pixels at a time, transposed so each register holds one channel
+void thresholdRowSse2(const float* pixels, const float* thresholds, int width, const Palette& palette,
+                      uint8_t* out) {
+  const __m128 weights[3] = {_mm_set1_ps(palette.weights[0]), _mm_set1_ps(palette.weights[1]),
+                             _mm_set1_ps(palette.weights[2])};
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    __m128 p0 = _mm_loadu_ps(pixels + (size_t)x * 4);
+    __m128 p1 = _mm_loadu_ps(pixels + (size_t)x * 4 + 4);
+    __m128 p2 = _mm_loadu_ps(pixels + (size_t)x * 4 + 8);
+    __m128 p3 = _mm_loadu_ps(pixels + (size_t)x * 4 + 12);
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    __m128 t = _mm_loadu_ps(thresholds + x);
+    __m128 r = _mm_add_ps(p0, t), g = _mm_add_ps(p1, t), b = _mm_add_ps(p2, t);
+
+    __m128 best = _mm_set1_ps(INFINITY);
+    __m128i index = _mm_setzero_si128();
+    for (int k = 0; k < palette.count; k++) {
+      __m128 dr = _mm_sub_ps(_mm_set1_ps(palette.r[k]), r);
+      __m128 dg = _mm_sub_ps(_mm_set1_ps(palette.g[k]), g);
+      __m128 db = _mm_sub_ps(_mm_set1_ps(palette.b[k]), b);
+      __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(weights[0], dr), dr),
+                                       _mm_mul_ps(_mm_mul_ps(weights[1], dg), dg)),
+                            _mm_mul_ps(_mm_mul_ps(weights[2], db), db));
+      __m128 closer = _mm_cmplt_ps(d, best);
+      best = _mm_min_ps(d, best);
+      __m128i take = _mm_castps_si128(closer);
+      index = _mm_or_si128(_mm_andnot_si128(take, index), _mm_and_si128(take, _mm_set1_epi32(k)));
+    }
+    alignas(16) int32_t lanes[4];
+    _mm_store_si128((__m128i*)lanes, index);
+    for (int i = 0; i < 4; i++) out[x + i] = lanes[i];
+  }
+  if (x < width) scalarKernels.thresholdRow(pixels + (size_t)x * 4, thresholds + x, width - x, palette, out + x);
+}
+
+}  // namespace
+
+const DitherKernels sse2Kernels = {"sse2", diffuseRowSse2, thresholdRowSse2};
+
+#endif
@@ -0,0 +1,77 @@
+#include "encode.h"
+#include <string.h>
+#include <algorithm>
+#include "sha256.h"
+
+std::vector<uint8_t> packRows(const std::vector<uint8_t>& indices, int width, int height, const uint8_t* codes) {
+  size_t rowBytes = (width + 1) / 2;
+  std::vector<uint8_t> rows(rowBytes * height, 0);
+  for (int y = 0; y < height; y++) {
+    const uint8_t* in = &indices[(size_t)y * width];
+    uint8_t* out = &rows[y * rowBytes];
+    for (int x = 0; x < width; x++) {
+      out[x / 2] |= (x & 1) ? codes[in[x]] : codes[in[x]] << 4;
+    }
+  }
+  return rows;
+}
+
+std::vector<uint8_t> packBits(const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> out;
+  size_t i = 0, n = data.size();
+  size_t literal = 0;  // Start of the pending literal run
+  auto flushLiteral = [&](size_t end) {
+    while (literal < end) {
+      size_t count = std::min<size_t>(end - literal, 128);
+      out.push_back(count - 1);
+      out.insert(out.end(), data.begin() + literal, data.begin() + literal + count);
+      literal += count;
+    }
+  };
+  while (i < n) {
+    size_t run = 1;
+    while (i + run < n && run < 128 && data[i + run] == data[i]) run++;
+    // A pair inside a literal costs the same as literal bytes; three or more are worth a run
+    if (run >= 3 || (run == 2 && literal == i)) {
+      flushLiteral(i);
+      out.push_back(257 - run);
+      out.push_back(data[i]);
+      i += run;
+      literal = i;
+    } else {
+      i += run;
+    }
+  }
+  flushLiteral(n);
+  return out;
+}
+
+std::vector<uint8_t> makeContainer(const std::vector<uint8_t>& indices, int width, int height, const Palette& palette,
+                                   ImageCodec codec, uint8_t scale, uint8_t filter) {
+  static const uint8_t identity[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  std::vector<uint8_t> rows = packRows(indices, width, height, identity);
+  std::vector<uint8_t> payload = (codec == IMAGE_CODEC_PACKBITS) ? packBits(rows) : rows;
+
+  ImageHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = IMAGE_MAGIC;
+  header.version = IMAGE_FORMAT_VERSION;
+  header.headerSize = sizeof(ImageHeader);
+  header.codec = codec;
+  header.bpp = 4;
+  header.width = width;
+  header.height = height;
+  header.scale = scale;
+  header.filter = filter;
+  uint8_t map[16];
+  for (int i = 0; i < 16; i++) map[i] = (i < palette.count) ? palette.codes[i] : i;
+  for (int i = 0; i < 8; i++) header.palette[i] = (map[i * 2] << 4) | map[i * 2 + 1];
+  header.rawSize = rows.size();
+  header.payloadSize = payload.size();
+  sha256(payload.data(), payload.size(), header.hash);
+
+  std::vector<uint8_t> file(sizeof(header) + payload.size());
+  memcpy(file.data(), &header, sizeof(header));
+  memcpy(file.data() + sizeof(header), payload.data(), payload.size());
+  return file;
+}
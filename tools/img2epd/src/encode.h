@@ -0,0 +1,26 @@
+/*****************************************************************************
+ * | File      	:   encode.h
+ * | Function    :   Panel rows and the device image container
+ ******************************************************************************/
+#ifndef _IMG2EPD_ENCODE_H_
+#define _IMG2EPD_ENCODE_H_
+
+#include <stdint.h>
+#include <vector>
+#include "image_container.h"
+#include "palette.h"
+
+// Two pixels per byte, left pixel in the high nibble, rows padded to a
+// whole byte. codes maps each palette index to the stored nibble.
+std::vector<uint8_t> packRows(const std::vector<uint8_t>& indices, int width, int height, const uint8_t* codes);
+
+// PackBits as the device decodes it: 0-127 copies that many + 1 bytes,
+// 129-255 repeats the next byte 257 - n times
+std::vector<uint8_t> packBits(const std::vector<uint8_t>& data);
+
+// ImageHeader and payload. Rows hold palette indices and the header maps
+// them to panel colors. scale 0 leaves scale and filter to the manifest.
+std::vector<uint8_t> makeContainer(const std::vector<uint8_t>& indices, int width, int height, const Palette& palette,
+                                   ImageCodec codec, uint8_t scale, uint8_t filter);
+
+#endif
@@ -0,0 +1,148 @@
+#include "image.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+
+float srgbToLinear(uint8_t value) {
+  static float table[256];
+  static bool ready = [] {
+    for (int i = 0; i < 256; i++) {
+      float c = i / 255.0f;
+      table[i] = (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+    }
+    return true;
+  }();
+  (void)ready;
+  return table[value];
+}
+
+uint8_t linearToSrgb(float value) {
+  if (value <= 0.0f) return 0;
+  if (value >= 1.0f) return 255;
+  float c = (value <= 0.0031308f) ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+  return (uint8_t)lrintf(c * 255.0f);
+}
+
+namespace {
+
+struct FileCloser {
+  void operator()(FILE* file) const { fclose(file); }
+};
+typedef std::unique_ptr<FILE, FileCloser> FilePtr;
+
+// Next header number, skipping whitespace and '#' comments
+bool readNumber(FILE* file, int& value) {
+  int c = fgetc(file);
+  while (c == '#' || isspace(c)) {
+    if (c == '#') {
+      while (c != '\n' && c != EOF) c = fgetc(file);
+    }
+    c = fgetc(file);
+  }
+  if (c < '0' || c > '9') return false;
+  value = 0;
+  while (c >= '0' && c <= '9') {
+    if (value > 1000000) return false;
+    value = value * 10 + (c - '0');
+    c = fgetc(file);
+  }
+  // One whitespace character ends the header before binary samples
+  return isspace(c) || c == EOF;
+}
+
+}  // namespace
+
+bool readPnm(const std::string& path, Image& image, std::string& error) {
+  FilePtr file(fopen(path.c_str(), "rb"));
+  if (!file) {
+    error = "cannot open";
+    return false;
+  }
+  char magic[2];
+  int width, height, maxValue;
+  if (fread(magic, 1, 2, file.get()) != 2 || magic[0] != 'P' || !strchr("2356", magic[1])) {
+    error = "not a PPM/PGM file (convert with e.g. 'magick photo.jpg photo.ppm')";
+    return false;
+  }
+  if (!readNumber(file.get(), width) || !readNumber(file.get(), height) || !readNumber(file.get(), maxValue) ||
+      width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 65535 || (size_t)width * height > 100000000) {
+    error = "bad header";
+    return false;
+  }
+
+  bool gray = magic[1] == '5' || magic[1] == '2';
+  bool ascii = magic[1] == '2' || magic[1] == '3';
+  int channels = gray ? 1 : 3;
+  size_t samples = (size_t)width * height * channels;
+  std::vector<uint16_t> values(samples);
+  if (ascii) {
+    for (size_t i = 0; i < samples; i++) {
+      int value;
+      if (!readNumber(file.get(), value)) {
+        error = "truncated";
+        return false;
+      }
+      values[i] = value;
+    }
+  } else if (maxValue < 256) {
+    std::vector<uint8_t> bytes(samples);
+    if (fread(bytes.data(), 1, samples, file.get()) != samples) {
+      error = "truncated";
+      return false;
+    }
+    for (size_t i = 0; i < samples; i++) values[i] = bytes[i];
+  } else {
+    std::vector<uint8_t> bytes(samples * 2);
+    if (fread(bytes.data(), 1, samples * 2, file.get()) != samples * 2) {
+      error = "truncated";
+      return false;
+    }
+    for (size_t i = 0; i < samples; i++) values[i] = (bytes[2 * i] << 8) | bytes[2 * i + 1];
+  }
+
+  image.resize(width, height);
+  float* out = image.pixels.data();
+  for (size_t p = 0; p < (size_t)width * height; p++, out += 4) {
+    for (int c = 0; c < 3; c++) {
+      uint16_t value = values[p * channels + (gray ? 0 : c)];
+      if (value > maxValue) value = maxValue;
+      if (maxValue == 255) {
+        out[c] = srgbToLinear((uint8_t)value);
+      } else {
+        float v = (float)value / maxValue;
+        out[c] = (v <= 0.04045f) ? v / 12.92f : powf((v + 0.055f) / 1.055f, 2.4f);
+      }
+    }
+    out[3] = 0.0f;
+  }
+  return true;
+}
+
+bool writePpm(const std::string& path, int width, int height, const std::vector<uint8_t>& rgb, std::string& error) {
+  FilePtr file(fopen(path.c_str(), "wb"));
+  if (!file) {
+    error = "cannot create";
+    return false;
+  }
+  fprintf(file.get(), "P6\n%d %d\n255\n", width, height);
+  if (fwrite(rgb.data(), 1, rgb.size(), file.get()) != rgb.size()) {
+    error = "write failed";
+    return false;
+  }
+  return true;
+}
+
+Image rotateClockwise(const Image& image) {
+  Image rotated;
+  rotated.resize(image.height, image.width);
+  for (int y = 0; y < image.height; y++) {
+    const float* in = image.row(y);
+    for (int x = 0; x < image.width; x++, in += 4) {
+      float* out = rotated.row(x) + (size_t)(image.height - 1 - y) * 4;
+      for (int c = 0; c < 4; c++) out[c] = in[c];
+    }
+  }
+  return rotated;
+}
@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * | File      	:   image.h
+ * | Function    :   Linear-light RGB images and PNM files
+ ******************************************************************************/
+#ifndef _IMG2EPD_IMAGE_H_
+#define _IMG2EPD_IMAGE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Linear-light RGB, 4 floats per pixel (R, G, B, unused) so one pixel is
+// one SIMD register and four pixels transpose into R, G and B registers
+struct Image {
+  int width = 0;
+  int height = 0;
+  std::vector<float> pixels;
+
+  void resize(int w, int h) {
+    width = w;
+    height = h;
+    pixels.assign((size_t)w * h * 4, 0.0f);
+  }
+  float* row(int y) { return pixels.data() + (size_t)y * width * 4; }
+  const float* row(int y) const { return pixels.data() + (size_t)y * width * 4; }
+};
+
+float srgbToLinear(uint8_t value);
+uint8_t linearToSrgb(float value);
+
+// Binary or ASCII PPM (P6/P3) and PGM (P5/P2), 8 or 16 bits per sample
+bool readPnm(const std::string& path, Image& image, std::string& error);
+
+// 8-bit binary PPM of sRGB samples, 3 per pixel
+bool writePpm(const std::string& path, int width, int height, const std::vector<uint8_t>& rgb, std::string& error);
+
+// Quarter turn clockwise, for landscape pictures on the portrait panel
+Image rotateClockwise(const Image& image);
+
+#endif
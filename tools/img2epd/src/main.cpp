@@ -0,0 +1,354 @@
+/*****************************************************************************
+ * | File      	:   main.cpp
+ * | Function    :   img2epd: pictures to images the frame can show
+ ******************************************************************************/
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "convert.h"
+#include "dither_kernels.h"
+#include "thread_pool.h"
+
+namespace {
+
+void usage() {
+  printf(
+    "usage: img2epd [options] PICTURE...\n"
+    "       img2epd --bench [-n COUNT] [PICTURE...]\n"
+    "\n"
+    "Converts PPM/PGM pictures to %dx%d images for the 6-color panel.\n"
+    "\n"
+    "  -o PATH                 output file (one picture) or directory; default: PICTURE with .bin\n"
+    "  --fit cover|contain|stretch     (default cover)\n"
+    "  --rotate auto|none      auto turns landscape pictures a quarter clockwise (default auto)\n"
+    "  --dither diffusion|blue-noise|none   (default diffusion)\n"
+    "  --palette measured|ideal        colors the panel shows, or pure primaries (default measured)\n"
+    "  --scale N               store at 1/N of the panel size, enlarged by the device (1-%d)\n"
+    "  --filter nearest|dither how the device enlarges a scaled image (default nearest)\n"
+    "  --container             write the image container instead of headerless rows\n"
+    "  --packbits              container with PackBits-compressed rows\n"
+    "  --preview               also write PICTURE.preview.ppm in the panel colors\n"
+    "  --kernels NAME          dither kernels: %s\n"
+    "  -j N                    pictures converted at once (default: hardware threads)\n"
+    "  --bench                 time kernels and thread counts on COUNT synthetic pictures\n"
+    "                          (default 24) or the given ones\n",
+    DISPLAY_WIDTH, DISPLAY_HEIGHT, COMPOSE_MAX_SCALE, [] {
+      static std::string names;
+      for (const DitherKernels* kernels : availableKernels()) {
+        names += names.empty() ? "" : ", ";
+        names += kernels->name;
+      }
+      return names.c_str();
+    }());
+}
+
+bool isDirectory(const std::string& path) {
+  struct stat info;
+  return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+// PICTURE with its extension replaced
+std::string withExtension(const std::string& path, const char* extension) {
+  size_t slash = path.find_last_of('/');
+  size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + extension;
+  return path.substr(0, dot) + extension;
+}
+
+std::string baseName(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& data, std::string& error) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    error = strerror(errno);
+    return false;
+  }
+  bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+  written = (fclose(file) == 0) && written;
+  if (!written) error = "write failed";
+  return written;
+}
+
+// Landscape "photos": soft gradients, saturated discs and fine texture, so
+// the ditherer sees smooth areas, edges and noise
+Image syntheticPicture(int seed) {
+  Image image;
+  image.resize(1600, 1200);
+  uint32_t state = 0x9E3779B9u * (seed + 1);
+  auto random = [&state] {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state & 0xFFFFFF) / 16777216.0f;
+  };
+  float discs[6][6];  // x, y, radius, r, g, b
+  for (auto& disc : discs) {
+    disc[0] = random() * image.width;
+    disc[1] = random() * image.height;
+    disc[2] = 80 + random() * 250;
+    for (int c = 3; c < 6; c++) disc[c] = random();
+  }
+  for (int y = 0; y < image.height; y++) {
+    float* p = image.row(y);
+    for (int x = 0; x < image.width; x++, p += 4) {
+      float u = (float)x / image.width, v = (float)y / image.height;
+      p[0] = u * 0.8f;
+      p[1] = v * 0.6f + 0.2f;
+      p[2] = (1.0f - u) * (1.0f - v);
+      for (const auto& disc : discs) {
+        float dx = x - disc[0], dy = y - disc[1];
+        if (dx * dx + dy * dy < disc[2] * disc[2]) {
+          for (int c = 0; c < 3; c++) p[c] = disc[3 + c];
+        }
+      }
+      float grain = (random() - 0.5f) * 0.08f;
+      for (int c = 0; c < 3; c++) p[c] = fminf(fmaxf(p[c] + grain, 0.0f), 1.0f);
+    }
+  }
+  return image;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int runBench(const std::vector<std::string>& inputs, int count, const ConvertOptions& base) {
+  std::vector<Image> pictures;
+  if (inputs.empty()) {
+    for (int i = 0; i < count; i++) pictures.push_back(syntheticPicture(i));
+  } else {
+    for (const std::string& input : inputs) {
+      Image image;
+      std::string error;
+      if (!readPnm(input, image, error)) {
+        fprintf(stderr, "img2epd: %s: %s\n", input.c_str(), error.c_str());
+        return 1;
+      }
+      pictures.push_back(std::move(image));
+    }
+  }
+  int hardware = std::max(1u, std::thread::hardware_concurrency());
+  printf("img2epd benchmark: %zu pictures, %dx%d panel, %d hardware threads\n\n", pictures.size(), DISPLAY_WIDTH,
+         DISPLAY_HEIGHT, hardware);
+
+  // Dithering alone, on pictures already fitted to the panel
+  Palette palette = makePalette(base.palette);
+  std::vector<Image> fitted;
+  for (const Image& picture : pictures) {
+    Image panel = (picture.width > picture.height) ? rotateClockwise(picture) : picture;
+    fitted.push_back(resizeTo(panel, DISPLAY_WIDTH, DISPLAY_HEIGHT, base.fit));
+    mapToPanel(fitted.back(), palette);
+  }
+  double pixels = (double)fitted.size() * DISPLAY_WIDTH * DISPLAY_HEIGHT;
+  std::vector<uint8_t> warmup;
+  dither(fitted[0], palette, DITHER_BLUE_NOISE, scalarKernels, warmup);  // Builds the mask outside the timings
+  const DitherMode modes[] = {DITHER_DIFFUSION, DITHER_BLUE_NOISE, DITHER_NONE};
+  std::vector<std::vector<uint8_t>> reference[3];
+  bool identical = true;
+  printf("Dither kernels, one thread, Mpixel/s\n");
+  printf("  %-8s %11s %11s %11s  %s\n", "kernels", "diffusion", "blue-noise", "nearest", "same as scalar");
+  std::vector<const DitherKernels*> kernels = availableKernels();
+  // Scalar first, so the others can be compared with it
+  for (auto it = kernels.rbegin(); it != kernels.rend(); ++it) {
+    printf("  %-8s", (*it)->name);
+    bool same = true;
+    for (int m = 0; m < 3; m++) {
+      std::vector<std::vector<uint8_t>> results(fitted.size());
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < fitted.size(); i++) dither(fitted[i], palette, modes[m], **it, results[i]);
+      double seconds = secondsSince(start);
+      printf(" %11.1f", pixels / seconds / 1e6);
+      if (*it == &scalarKernels) {
+        reference[m] = std::move(results);
+      } else {
+        same = same && results == reference[m];
+      }
+    }
+    printf("  %s\n", (*it == &scalarKernels) ? "-" : (same ? "yes" : "NO"));
+    identical = identical && same;
+  }
+
+  // Whole conversions from the decoded picture to the PackBits container
+  printf("\nConversions (fit, dither, PackBits container), %s kernels\n", base.kernels->name);
+  printf("  %-8s %10s %8s\n", "threads", "images/s", "speedup");
+  ConvertOptions options = base;
+  options.container = true;
+  options.codec = IMAGE_CODEC_PACKBITS;
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < hardware; threads *= 2) threadCounts.push_back(threads);
+  threadCounts.push_back(hardware);
+  double single = 0;
+  for (int threads : threadCounts) {
+    auto start = std::chrono::steady_clock::now();
+    {
+      ThreadPool pool(threads);
+      for (const Image& picture : pictures) {
+        pool.submit([&picture, &options] {
+          Converted converted;
+          convertPicture(picture, options, converted);
+        });
+      }
+      pool.wait();
+    }
+    double rate = pictures.size() / secondsSince(start);
+    if (threads == 1) single = rate;
+    printf("  %-8d %10.2f %7.2fx\n", threads, rate, rate / single);
+  }
+
+  if (!identical) {
+    fprintf(stderr, "img2epd: kernels differ from scalar\n");
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ConvertOptions options;
+  std::vector<std::string> inputs;
+  std::string output;
+  std::string kernelName;
+  bool preview = false;
+  bool bench = false;
+  int benchCount = 24;
+  int jobs = std::max(1u, std::thread::hardware_concurrency());
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    // Options that take a value
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        fprintf(stderr, "img2epd: %s needs a value\n", arg.c_str());
+        exit(2);
+      }
+      return argv[++i];
+    };
+    auto invalid = [&](const std::string& given) {
+      fprintf(stderr, "img2epd: invalid %s '%s'\n", arg.c_str(), given.c_str());
+      exit(2);
+    };
+
+    if (arg == "-h" || arg == "--help") {
+      usage();
+      return 0;
+    } else if (arg == "-o") {
+      output = value();
+    } else if (arg == "--fit") {
+      std::string v = value();
+      if (v == "cover") options.fit = FIT_COVER;
+      else if (v == "contain") options.fit = FIT_CONTAIN;
+      else if (v == "stretch") options.fit = FIT_STRETCH;
+      else invalid(v);
+    } else if (arg == "--rotate") {
+      std::string v = value();
+      if (v != "auto" && v != "none") invalid(v);
+      options.autoRotate = (v == "auto");
+    } else if (arg == "--dither") {
+      std::string v = value();
+      if (v == "diffusion") options.dither = DITHER_DIFFUSION;
+      else if (v == "blue-noise") options.dither = DITHER_BLUE_NOISE;
+      else if (v == "none") options.dither = DITHER_NONE;
+      else invalid(v);
+    } else if (arg == "--palette") {
+      std::string v = value();
+      if (v == "measured") options.palette = PALETTE_MEASURED;
+      else if (v == "ideal") options.palette = PALETTE_IDEAL;
+      else invalid(v);
+    } else if (arg == "--scale") {
+      std::string v = value();
+      options.scale = atoi(v.c_str());
+      if (options.scale < 1 || options.scale > COMPOSE_MAX_SCALE) invalid(v);
+    } else if (arg == "--filter") {
+      std::string v = value();
+      if (v == "nearest") options.filter = IMAGE_FILTER_NEAREST;
+      else if (v == "dither") options.filter = IMAGE_FILTER_DITHER;
+      else invalid(v);
+    } else if (arg == "--container") {
+      options.container = true;
+    } else if (arg == "--packbits") {
+      options.container = true;
+      options.codec = IMAGE_CODEC_PACKBITS;
+    } else if (arg == "--preview") {
+      preview = true;
+    } else if (arg == "--kernels") {
+      kernelName = value();
+      if (!findKernels(kernelName)) invalid(kernelName);
+    } else if (arg == "-j") {
+      std::string v = value();
+      jobs = atoi(v.c_str());
+      if (jobs < 1) invalid(v);
+    } else if (arg == "--bench") {
+      bench = true;
+    } else if (arg == "-n") {
+      std::string v = value();
+      benchCount = atoi(v.c_str());
+      if (benchCount < 1) invalid(v);
+    } else if (arg.size() > 1 && arg[0] == '-') {
+      fprintf(stderr, "img2epd: unknown option %s\n", arg.c_str());
+      return 2;
+    } else {
+      inputs.push_back(arg);
+    }
+  }
+  options.kernels = kernelName.empty() ? availableKernels().front() : findKernels(kernelName);
+
+  if (bench) return runBench(inputs, benchCount, options);
+  if (inputs.empty()) {
+    usage();
+    return 2;
+  }
+  bool toDirectory = !output.empty() && (inputs.size() > 1 || isDirectory(output) || output.back() == '/');
+  if (toDirectory && !isDirectory(output)) {
+    fprintf(stderr, "img2epd: %s is not a directory\n", output.c_str());
+    return 2;
+  }
+
+  std::mutex reportLock;
+  int failures = 0;
+  ThreadPool pool(std::min<int>(jobs, inputs.size()));
+  for (const std::string& input : inputs) {
+    std::string target = output.empty() ? withExtension(input, ".bin")
+                         : toDirectory  ? output + "/" + withExtension(baseName(input), ".bin")
+                                        : output;
+    pool.submit([&, input, target] {
+      Image picture;
+      Converted converted;
+      std::string error;
+      std::string failed = input;  // The file the error is about
+      bool ok = readPnm(input, picture, error);
+      if (ok) {
+        convertPicture(picture, options, converted);
+        failed = target;
+        ok = writeFile(target, converted.file, error);
+      }
+      if (ok && preview) {
+        std::vector<uint8_t> rgb = previewPixels(converted, makePalette(options.palette));
+        failed = withExtension(target, ".preview.ppm");
+        ok = writePpm(failed, converted.width, converted.height, rgb, error);
+      }
+      std::lock_guard<std::mutex> guard(reportLock);
+      if (ok) {
+        printf("%s -> %s (%dx%d, %zu bytes)\n", input.c_str(), target.c_str(), converted.width, converted.height,
+               converted.file.size());
+      } else {
+        fprintf(stderr, "img2epd: %s: %s\n", failed.c_str(), error.c_str());
+        failures++;
+      }
+    });
+  }
+  pool.wait();
+  return failures ? 1 : 0;
+}
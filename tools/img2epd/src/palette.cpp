@@ -0,0 +1,59 @@
+#include "palette.h"
+
+namespace {
+
+struct PanelColor {
+  uint8_t code;        // As in EPD_4in0e.h
+  uint8_t ideal[3];
+  uint8_t measured[3]; // Typical photographed panel under daylight
+};
+
+const PanelColor panelColors[] = {
+  {0x0, {0, 0, 0}, {25, 30, 33}},          // Black
+  {0x1, {255, 255, 255}, {232, 232, 232}}, // White
+  {0x2, {255, 255, 0}, {239, 222, 68}},    // Yellow
+  {0x3, {255, 0, 0}, {178, 19, 24}},       // Red
+  {0x5, {0, 0, 255}, {33, 87, 186}},       // Blue
+  {0x6, {0, 255, 0}, {18, 95, 32}},        // Green
+};
+
+}  // namespace
+
+Palette makePalette(PaletteKind kind) {
+  Palette palette = {};
+  palette.count = sizeof(panelColors) / sizeof(panelColors[0]);
+  // Closer to perceived difference than plain RGB distance
+  palette.weights[0] = 0.299f;
+  palette.weights[1] = 0.587f;
+  palette.weights[2] = 0.114f;
+  for (int i = 0; i < PALETTE_LANES; i++) {
+    float color[3] = {1.0e6f, 1.0e6f, 1.0e6f};
+    if (i < palette.count) {
+      const uint8_t* srgb = (kind == PALETTE_IDEAL) ? panelColors[i].ideal : panelColors[i].measured;
+      for (int c = 0; c < 3; c++) {
+        palette.srgb[i][c] = srgb[c];
+        color[c] = srgbToLinear(srgb[c]);
+      }
+      palette.codes[i] = panelColors[i].code;
+    }
+    palette.r[i] = color[0];
+    palette.g[i] = color[1];
+    palette.b[i] = color[2];
+    palette.rgba[i][0] = color[0];
+    palette.rgba[i][1] = color[1];
+    palette.rgba[i][2] = color[2];
+    palette.rgba[i][3] = 0.0f;
+  }
+  return palette;
+}
+
+void mapToPanel(Image& image, const Palette& palette) {
+  // Entries 0 and 1 are black and white
+  float low[3] = {palette.r[0], palette.g[0], palette.b[0]};
+  float high[3] = {palette.r[1], palette.g[1], palette.b[1]};
+  for (size_t i = 0; i < image.pixels.size(); i += 4) {
+    for (int c = 0; c < 3; c++) {
+      image.pixels[i + c] = low[c] + image.pixels[i + c] * (high[c] - low[c]);
+    }
+  }
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * | File      	:   palette.h
+ * | Function    :   The panel's six colors
+ ******************************************************************************/
+#ifndef _IMG2EPD_PALETTE_H_
+#define _IMG2EPD_PALETTE_H_
+
+#include <stdint.h>
+#include "image.h"
+
+#define PALETTE_LANES 8  // Entries padded to a whole AVX register
+
+enum PaletteKind {
+  PALETTE_MEASURED,  // What the panel shows: dim white, dark yellow, muted red/green/blue
+  PALETTE_IDEAL      // Pure sRGB primaries, for synthetic art
+};
+
+// Linear-light colors in structure-of-arrays form for the SIMD kernels.
+// Padding entries are far from any color and never chosen.
+struct Palette {
+  int count;
+  uint8_t codes[PALETTE_LANES];    // Panel nibble of each entry (EPD_4IN0E_BLACK ...)
+  uint8_t srgb[PALETTE_LANES][3];  // For previews
+  alignas(32) float r[PALETTE_LANES];
+  alignas(32) float g[PALETTE_LANES];
+  alignas(32) float b[PALETTE_LANES];
+  alignas(16) float rgba[PALETTE_LANES][4];  // The same colors, one register each
+  float weights[3];                          // Of squared R, G, B differences
+};
+
+Palette makePalette(PaletteKind kind);
+
+// Compress each channel into what the panel can show, its black to its
+// white, so highlights and shadows are dithered instead of clipped
+void mapToPanel(Image& image, const Palette& palette);
+
+#endif
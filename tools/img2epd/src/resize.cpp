@@ -0,0 +1,109 @@
+#include "resize.h"
+#include <math.h>
+#include <algorithm>
+
+namespace {
+
+// Weights of the source pixels that make up each output pixel along one axis
+struct Taps {
+  std::vector<int> first;     // First source pixel of output i
+  std::vector<int> count;     // Number of source pixels
+  std::vector<float> weights; // count[i] weights per output pixel, at offset[i]
+  std::vector<size_t> offset;
+};
+
+// outSize pixels covering source pixels [start, start + span)
+Taps makeTaps(int sourceSize, double start, double span, int outSize) {
+  Taps taps;
+  double ratio = span / outSize;
+  double support = std::max(1.0, ratio);  // Tent half-width in source pixels
+  for (int i = 0; i < outSize; i++) {
+    double center = start + (i + 0.5) * ratio;
+    int lo = std::max(0, (int)floor(center - support));
+    int hi = std::min(sourceSize - 1, (int)ceil(center + support));
+    taps.first.push_back(lo);
+    taps.offset.push_back(taps.weights.size());
+    double total = 0;
+    std::vector<double> w;
+    for (int s = lo; s <= hi; s++) {
+      double weight = std::max(0.0, 1.0 - fabs(s + 0.5 - center) / support);
+      w.push_back(weight);
+      total += weight;
+    }
+    if (total <= 0) {
+      // Center beyond the edge, take the nearest pixel
+      w.assign(hi - lo + 1, 0.0);
+      w[std::min((int)w.size() - 1, std::max(0, (int)center - lo))] = 1.0;
+      total = 1.0;
+    }
+    for (double weight : w) taps.weights.push_back((float)(weight / total));
+    taps.count.push_back(hi - lo + 1);
+  }
+  return taps;
+}
+
+}  // namespace
+
+Image resizeTo(const Image& source, int width, int height, FitMode fit) {
+  // Area of the output the picture covers, and the part of the picture used
+  int outX = 0, outY = 0, outW = width, outH = height;
+  double srcX = 0, srcY = 0, srcW = source.width, srcH = source.height;
+  double scaleX = (double)width / source.width;
+  double scaleY = (double)height / source.height;
+  if (fit == FIT_CONTAIN) {
+    double scale = std::min(scaleX, scaleY);
+    outW = std::max(1, (int)lround(source.width * scale));
+    outH = std::max(1, (int)lround(source.height * scale));
+    outX = (width - outW) / 2;
+    outY = (height - outH) / 2;
+  } else if (fit == FIT_COVER) {
+    double scale = std::max(scaleX, scaleY);
+    srcW = width / scale;
+    srcH = height / scale;
+    srcX = (source.width - srcW) / 2;
+    srcY = (source.height - srcH) / 2;
+  }
+
+  Taps columns = makeTaps(source.width, srcX, srcW, outW);
+  Taps rows = makeTaps(source.height, srcY, srcH, outH);
+
+  // Horizontal pass into outW x source.height, then vertical
+  Image across;
+  across.resize(outW, source.height);
+  for (int y = 0; y < source.height; y++) {
+    const float* in = source.row(y);
+    float* out = across.row(y);
+    for (int x = 0; x < outW; x++, out += 4) {
+      const float* w = &columns.weights[columns.offset[x]];
+      const float* p = in + (size_t)columns.first[x] * 4;
+      float r = 0, g = 0, b = 0;
+      for (int t = 0; t < columns.count[x]; t++, p += 4) {
+        r += w[t] * p[0];
+        g += w[t] * p[1];
+        b += w[t] * p[2];
+      }
+      out[0] = r;
+      out[1] = g;
+      out[2] = b;
+    }
+  }
+
+  Image result;
+  result.resize(width, height);
+  for (size_t i = 0; i < result.pixels.size(); i += 4) {
+    result.pixels[i] = result.pixels[i + 1] = result.pixels[i + 2] = 1.0f;  // White around a contained picture
+  }
+  for (int y = 0; y < outH; y++) {
+    const float* w = &rows.weights[rows.offset[y]];
+    float* out = result.row(outY + y) + (size_t)outX * 4;
+    std::fill(out, out + (size_t)outW * 4, 0.0f);
+    // Row by row, so every pass reads and writes memory in order
+    for (int t = 0; t < rows.count[y]; t++) {
+      const float* p = across.row(rows.first[y] + t);
+      for (int i = 0; i < outW * 4; i++) {
+        out[i] += w[t] * p[i];
+      }
+    }
+  }
+  return result;
+}
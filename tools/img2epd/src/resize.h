@@ -0,0 +1,20 @@
+/*****************************************************************************
+ * | File      	:   resize.h
+ * | Function    :   Fitting pictures to the panel
+ ******************************************************************************/
+#ifndef _IMG2EPD_RESIZE_H_
+#define _IMG2EPD_RESIZE_H_
+
+#include "image.h"
+
+enum FitMode {
+  FIT_CONTAIN,  // Whole picture, white bars
+  FIT_COVER,    // Fill the panel, crop the overflow from the center
+  FIT_STRETCH   // Fill the panel, ignore the aspect ratio
+};
+
+// Resample to width x height in linear light: a tent filter widened by the
+// reduction, so shrinking averages every source pixel instead of skipping
+Image resizeTo(const Image& source, int width, int height, FitMode fit);
+
+#endif
@@ -0,0 +1,13 @@
+/*****************************************************************************
+ * | File      	:   sha256.h
+ * | Function    :   SHA-256 of container payloads (the device checks it)
+ ******************************************************************************/
+#ifndef _IMG2EPD_SHA256_H_
+#define _IMG2EPD_SHA256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+void sha256(const uint8_t* data, size_t length, uint8_t digest[32]);
+
+#endif
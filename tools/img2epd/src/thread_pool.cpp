@@ -0,0 +1,44 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(int threads) {
+  if (threads < 1) threads = 1;
+  for (int i = 0; i < threads; i++) workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  ready.notify_all();
+  for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    queue.push_back(std::move(task));
+  }
+  ready.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> guard(lock);
+  idle.wait(guard, [this] { return queue.empty() && running == 0; });
+}
+
+void ThreadPool::work() {
+  std::unique_lock<std::mutex> guard(lock);
+  for (;;) {
+    ready.wait(guard, [this] { return stopping || !queue.empty(); });
+    if (queue.empty()) return;  // Stopping with nothing left
+    std::function<void()> task = std::move(queue.front());
+    queue.pop_front();
+    running++;
+    guard.unlock();
+    task();
+    guard.lock();
+    running--;
+    if (queue.empty() && running == 0) idle.notify_all();
+  }
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * | File      	:   thread_pool.h
+ * | Function    :   Fixed worker threads for album batches
+ ******************************************************************************/
+#ifndef _IMG2EPD_THREAD_POOL_H_
+#define _IMG2EPD_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pictures are independent, so the pool runs whole conversions and never
+// splits one picture (error diffusion is sequential along the rows anyway)
+class ThreadPool {
+ public:
+  explicit ThreadPool(int threads);
+  ~ThreadPool();
+
+  void submit(std::function<void()> task);
+  void wait();  // Until every submitted task has finished
+
+ private:
+  void work();
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> queue;
+  std::mutex lock;
+  std::condition_variable ready;
+  std::condition_variable idle;
+  int running = 0;
+  bool stopping = false;
+};
+
+#endif